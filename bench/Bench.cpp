@@ -0,0 +1,173 @@
+// Microbenchmarks of the engine's hot paths, run without a window from the directory the game
+// runs from (assets are read from ../assets):
+//   astral_bench [--filter <text>] [--json <file>] [--workers <n>] [--min-time <ms>]
+// The profiler is only compiled in with -DASTRAL_BENCH_PROFILER=ON, the JSON context says which
+
+#include "Bench.h"
+#include "libs/Json.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+using Clock = std::chrono::steady_clock;
+
+static const int MIN_SAMPLES = 5;
+static const int MAX_SAMPLES = 10000;
+
+Bench::Bench(int argc, char **argv)
+    : mWorkers(7), mMinTimeMs(250.0)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 < argc && arg == "--filter")
+        {
+            mFilter = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--json")
+        {
+            mJsonPath = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--workers")
+        {
+            mWorkers = std::atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && arg == "--min-time")
+        {
+            mMinTimeMs = std::atof(argv[++i]);
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown argument %s\n", arg.c_str());
+        }
+    }
+}
+
+bool Bench::IsSelected(const std::string &name) const
+{
+    return mFilter.empty() || name.find(mFilter) != std::string::npos;
+}
+
+void Bench::Check(const std::string &name, bool passed)
+{
+    if (!IsSelected(name))
+        return;
+
+    std::printf("%-48s %s\n", name.c_str(), passed ? "ok" : "FAILED");
+    std::fflush(stdout);
+
+    if (!passed)
+        mFailedChecks.push_back(name);
+}
+
+void Bench::Run(const std::string &name, int opsPerSample, const std::function<void()> &batch,
+                const std::function<void()> &setup)
+{
+    if (!IsSelected(name))
+        return;
+
+    // Warm caches and lazy allocations first
+    if (setup)
+        setup();
+    batch();
+
+    std::vector<double> perOpNs;
+    double totalMs = 0.0;
+    while ((totalMs < mMinTimeMs || perOpNs.size() < MIN_SAMPLES) && perOpNs.size() < MAX_SAMPLES)
+    {
+        if (setup)
+            setup();
+
+        auto start = Clock::now();
+        batch();
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        perOpNs.push_back(ns / opsPerSample);
+        totalMs += ns / 1e6;
+    }
+
+    std::sort(perOpNs.begin(), perOpNs.end());
+
+    Result result;
+    result.name = name;
+    result.opsPerSample = opsPerSample;
+    result.samples = static_cast<int>(perOpNs.size());
+    result.medianNs = perOpNs[perOpNs.size() / 2];
+    result.minNs = perOpNs.front();
+    result.p90Ns = perOpNs[static_cast<size_t>(0.9 * (perOpNs.size() - 1))];
+
+    double sum = 0.0;
+    for (double ns : perOpNs)
+    {
+        sum += ns;
+    }
+    result.meanNs = sum / perOpNs.size();
+
+    std::printf("%-48s %12.1f ns/op  min %12.1f  p90 %12.1f  (%d x %d ops)\n",
+                name.c_str(), result.medianNs, result.minNs, result.p90Ns, result.samples, opsPerSample);
+    std::fflush(stdout);
+
+    mResults.push_back(result);
+}
+
+bool Bench::WriteJson() const
+{
+    if (mJsonPath.empty())
+        return true;
+
+    nlohmann::json data;
+
+    // Numbers are only comparable between runs with the same context
+    data["context"]["workers"] = mWorkers;
+    data["context"]["min_time_ms"] = mMinTimeMs;
+#ifdef ASTRAL_PROFILER
+    data["context"]["profiler"] = true;
+#else
+    data["context"]["profiler"] = false;
+#endif
+#ifdef NDEBUG
+    data["context"]["assertions"] = false;
+#else
+    data["context"]["assertions"] = true;
+#endif
+
+    data["benchmarks"] = nlohmann::json::array();
+    for (const Result &result : mResults)
+    {
+        data["benchmarks"].push_back({
+            {"name", result.name},
+            {"ops_per_sample", result.opsPerSample},
+            {"samples", result.samples},
+            {"median_ns", result.medianNs},
+            {"min_ns", result.minNs},
+            {"mean_ns", result.meanNs},
+            {"p90_ns", result.p90Ns},
+        });
+    }
+
+    data["failed_checks"] = mFailedChecks;
+
+    std::ofstream file(mJsonPath);
+    if (!file.is_open())
+    {
+        std::fprintf(stderr, "failed to write %s\n", mJsonPath.c_str());
+        return false;
+    }
+
+    file << data.dump(4) << std::endl;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Bench bench(argc, argv);
+
+    RunJobSystemBenches(bench);
+    RunSpatialBenches(bench);
+    RunSceneBenches(bench);
+
+    bool written = bench.WriteJson();
+    return written && bench.GetFailedChecks() == 0 ? 0 : 1;
+}
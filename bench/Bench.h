@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Small harness shared by the microbenchmarks. A case is a batch of operations timed as one
+// sample; samples are taken until the minimum time is spent, and the per-operation times are
+// printed and written as JSON, so runs before and after a change can be compared
+class Bench
+{
+public:
+    struct Result
+    {
+        std::string name;
+        int opsPerSample;
+        int samples;
+        double medianNs; // per operation
+        double minNs;
+        double meanNs;
+        double p90Ns;
+    };
+
+    Bench(int argc, char **argv);
+
+    // Runs the batch repeatedly, setup runs before each sample and is not timed. Cases whose
+    // name does not contain the --filter text are skipped
+    void Run(const std::string &name, int opsPerSample, const std::function<void()> &batch,
+             const std::function<void()> &setup = nullptr);
+
+    // Same test Run does, so a case's fixture is only built when the case runs
+    bool IsSelected(const std::string &name) const;
+
+    // Untimed correctness check of a scenario the benchmarks go through, a failed one makes
+    // the run exit with an error
+    void Check(const std::string &name, bool passed);
+
+    int GetFailedChecks() const { return static_cast<int>(mFailedChecks.size()); }
+
+    int GetWorkers() const { return mWorkers; }
+
+    // Writes the results to the --json file, if one was given
+    bool WriteJson() const;
+
+private:
+    std::string mFilter;
+    std::string mJsonPath;
+    int mWorkers;
+    double mMinTimeMs;
+
+    std::vector<Result> mResults;
+    std::vector<std::string> mFailedChecks;
+};
+
+// One per file under bench/, called in this order by main
+void RunJobSystemBenches(Bench &bench);
+void RunSpatialBenches(Bench &bench);
+void RunSceneBenches(Bench &bench);
@@ -0,0 +1,97 @@
+#include "BenchWorld.h"
+#include "core/AudioSystem.h"
+#include "core/Config.h"
+#include "core/JobSystem.h"
+#include "core/PhysicsWorld.h"
+#include "core/SpatialHashing.h"
+#include "core/TriggerIndex.h"
+#include <SDL_image.h>
+#include <stdexcept>
+
+BenchWorld::BenchWorld()
+    : mTarget(nullptr)
+{
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0)
+    {
+        SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
+        throw std::runtime_error("Unable to initialize SDL");
+    }
+
+    IMG_Init(IMG_INIT_PNG);
+
+    // Textures are created like in the game, they only live in memory
+    mTarget = SDL_CreateRGBSurfaceWithFormat(0, mGame.mWindowWidth, mGame.mWindowHeight, 32, SDL_PIXELFORMAT_RGBA8888);
+    mGame.mRenderer = mTarget ? SDL_CreateSoftwareRenderer(mTarget) : nullptr;
+    if (!mGame.mRenderer)
+    {
+        SDL_Log("Failed to create software renderer: %s", SDL_GetError());
+        throw std::runtime_error("Failed to create software renderer");
+    }
+
+    mGame.mConfig = new Config();
+    mGame.mConfig->Initialize("config.json");
+
+    mGame.mAudio = new AudioSystem();
+    mGame.mJobSystem = new JobSystem();
+    mGame.mPhysicsWorld = new PhysicsWorld(&mGame);
+    mGame.mSpatialHashing = new SpatialHashing(Game::TILE_SIZE,
+                                               Game::LEVEL_WIDTH * Game::TILE_SIZE,
+                                               Game::LEVEL_HEIGHT * Game::TILE_SIZE);
+    mGame.mTriggerIndex = new TriggerIndex(Game::TRIGGER_CELL_SIZE,
+                                           Game::LEVEL_WIDTH * Game::TILE_SIZE,
+                                           Game::LEVEL_HEIGHT * Game::TILE_SIZE);
+}
+
+BenchWorld::~BenchWorld()
+{
+    // Frees the scene, the caches and SDL, there is no window to destroy
+    mGame.Shutdown();
+
+    SDL_FreeSurface(mTarget);
+    mTarget = nullptr;
+}
+
+void BenchWorld::ResetScene()
+{
+    mGame.UnloadScene();
+
+    mGame.mSpatialHashing = new SpatialHashing(Game::TILE_SIZE,
+                                               Game::LEVEL_WIDTH * Game::TILE_SIZE,
+                                               Game::LEVEL_HEIGHT * Game::TILE_SIZE);
+    mGame.mTriggerIndex = new TriggerIndex(Game::TRIGGER_CELL_SIZE,
+                                           Game::LEVEL_WIDTH * Game::TILE_SIZE,
+                                           Game::LEVEL_HEIGHT * Game::TILE_SIZE);
+    mGame.mActiveActorsDirty = true;
+    mGame.SetApplyGravityScene(Game::APPLY_GRAVITY_SCENE_DEFAULT);
+}
+
+void BenchWorld::LoadMap(const std::string &mapName)
+{
+    ResetScene();
+    mGame.SetMap(mapName);
+}
+
+void BenchWorld::TakeSceneSnapshot()
+{
+    mGame.mSceneSnapshotRequested = true;
+    mGame.UpdateSceneSnapshot();
+}
+
+void BenchWorld::EndFrame()
+{
+    mGame.UpdateSceneSnapshot();
+}
+
+void BenchWorld::SetGameScene(Game::GameScene scene)
+{
+    mGame.mGameScene = scene;
+    mGame.mGamePlayState = Game::GamePlayState::Playing;
+}
+
+void BenchWorld::CheckPortalSpawn()
+{
+    mGame.CheckPortalSpawn();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL.h>
+#include <string>
+#include "core/Game.h"
+
+// A game without a window for the benchmarks that need actors, maps or textures: SDL's dummy
+// video and audio drivers, a software renderer drawing to an offscreen surface, and the
+// systems Game::Initialize creates for a scene. Nothing is updated unless a benchmark does it
+class BenchWorld
+{
+public:
+    BenchWorld();
+    ~BenchWorld();
+
+    BenchWorld(const BenchWorld &) = delete;
+    BenchWorld &operator=(const BenchWorld &) = delete;
+
+    Game *GetGame() { return &mGame; }
+
+    // Deletes every actor and the map, and starts an empty scene the way ChangeScene does
+    void ResetScene();
+
+    // Replaces the scene with the map's tiles and objects, the map is under assets/Levels/Maps
+    void LoadMap(const std::string &mapName);
+
+    // What reaching a checkpoint does: the snapshot a respawn restores is taken at once
+    void TakeSceneSnapshot();
+
+    // The end of a frame, where a requested snapshot restore happens
+    void EndFrame();
+
+    // Plays the current scene as the given one, for the checks of that level's scripted events
+    void SetGameScene(Game::GameScene scene);
+
+    // Level 2's portal spawn, checked every frame while the level is played
+    void CheckPortalSpawn();
+
+private:
+    Game mGame;
+    SDL_Surface *mTarget;
+};
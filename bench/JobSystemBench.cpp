@@ -0,0 +1,90 @@
+// Throughput and latency of the job system
+
+#include "Bench.h"
+#include "core/JobSystem.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+void RunJobSystemBenches(Bench &bench)
+{
+    JobSystem jobs(bench.GetWorkers());
+    std::printf("job system with %d workers\n", jobs.GetNumWorkers());
+
+    // Many empty jobs on one counter: the cost of queueing, stealing and finishing a job
+    const int numEmptyJobs = 20000;
+    bench.Run("jobs/empty", numEmptyJobs, [&jobs]
+    {
+        std::atomic<int> ran(0);
+        JobSystem::Counter counter;
+        for (int i = 0; i < numEmptyJobs; i++)
+        {
+            jobs.Run([&ran] { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.Wait(counter);
+    });
+
+    // Each job depends on the previous one, nothing can run in parallel
+    const int chainLength = 2000;
+    bench.Run("jobs/dependency_chain", chainLength, [&jobs]
+    {
+        std::unique_ptr<JobSystem::Counter[]> counters(new JobSystem::Counter[chainLength]);
+        std::atomic<int> last(-1);
+        std::atomic<bool> inOrder(true);
+
+        for (int i = 0; i < chainLength; i++)
+        {
+            jobs.Run([&last, &inOrder, i]
+            {
+                if (last.exchange(i) != i - 1)
+                    inOrder = false;
+            }, &counters[i], i > 0 ? &counters[i - 1] : nullptr);
+        }
+        jobs.Wait(counters[chainLength - 1]);
+
+        if (!inOrder)
+            std::fprintf(stderr, "jobs/dependency_chain: jobs ran out of order\n");
+    });
+
+    // From Run until Wait returns, with idle workers
+    const int numRoundTrips = 100;
+    bench.Run("jobs/round_trip", numRoundTrips, [&jobs]
+    {
+        for (int i = 0; i < numRoundTrips; i++)
+        {
+            JobSystem::Counter counter;
+            jobs.Run([] {}, &counter);
+            jobs.Wait(counter);
+        }
+    });
+
+    // Fork/join over an array compared with a plain loop
+    const int count = 1 << 20;
+    std::vector<float> values(count);
+    auto work = [&values](int i) { values[i] = std::sqrt(static_cast<float>(i)) * std::sin(static_cast<float>(i)); };
+
+    bench.Run("jobs/parallel_for/serial", count, [&work]
+    {
+        for (int i = 0; i < count; i++)
+        {
+            work(i);
+        }
+    });
+
+    bench.Run("jobs/parallel_for/parallel", count, [&jobs, &work]
+    {
+        jobs.ParallelFor(count, work, 4096);
+    });
+
+    // Small loops, like a frame's sense phase, are dominated by the fork/join overhead
+    const int numSmallLoops = 100;
+    bench.Run("jobs/parallel_for/small", numSmallLoops, [&jobs, &work]
+    {
+        for (int loop = 0; loop < numSmallLoops; loop++)
+        {
+            jobs.ParallelFor(16, work);
+        }
+    });
+}
@@ -0,0 +1,198 @@
+// Scene loading and per-actor costs: config lookups, map loading, animated sprite setup, timers and
+// their handles, and scene progress across a respawn
+
+#include "Bench.h"
+#include "BenchWorld.h"
+#include "core/Config.h"
+#include "actors/Actor.h"
+#include "actors/Zoe.h"
+#include "components/TimerComponent.h"
+#include "components/draw/DrawAnimatedComponent.h"
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+
+static void BenchConfig(Bench &bench)
+{
+    if (!bench.IsSelected("config/get/top_level") && !bench.IsSelected("config/get/nested"))
+        return;
+
+    Config config;
+    if (!config.Initialize("config.json"))
+        return;
+
+    // Actors read their tuning in constructors and some every frame
+    const int numLookups = 1000;
+    float sum = 0.f;
+    bench.Run("config/get/top_level", numLookups, [&]
+    {
+        for (int i = 0; i < numLookups; i++)
+        {
+            sum += config.Get<float>("FREEZING_RATE");
+        }
+    });
+
+    bench.Run("config/get/nested", numLookups, [&]
+    {
+        for (int i = 0; i < numLookups; i++)
+        {
+            sum += config.Get<float>("ZOE.POWERS.FIREBALL.SPEED");
+        }
+    });
+}
+
+// Tilesets stay in the game's cache, so this is a reload: json parsing and actor creation
+static void BenchMapLoading(Bench &bench, BenchWorld &world, const std::string &level)
+{
+    bench.Run("map/load/" + level, 1, [&]
+    {
+        world.LoadMap(level + ".json");
+    }, [&]
+    {
+        world.ResetScene();
+    });
+
+    world.ResetScene();
+}
+
+// What an actor spawned mid-gameplay pays for its sprite: the cached sheet lookup and its clips
+static void BenchDrawAnimated(Bench &bench, BenchWorld &world)
+{
+    const int numComponents = 100;
+    Actor *owner = nullptr;
+
+    bench.Run("draw/animated_component/construct", numComponents, [&]
+    {
+        for (int i = 0; i < numComponents; i++)
+        {
+            auto draw = new DrawAnimatedComponent(owner, "../assets/Sprites/Zoe/texture.png", "../assets/Sprites/Zoe/texture.json");
+            draw->AddAnimation("idle", 0, 8);
+            draw->AddAnimation("jump", {20, 21});
+            draw->AddAnimation("run", 22, 25);
+            draw->SetAnimation("idle");
+        }
+    }, [&]
+    {
+        // Deleting the actor frees the components of the previous sample
+        delete owner;
+        owner = new Actor(world.GetGame());
+    });
+
+    world.ResetScene();
+}
+
+static void BenchTimers(Bench &bench, BenchWorld &world, int numTimers)
+{
+    const std::string name = "timers/tick/timers=" + std::to_string(numTimers);
+
+    Actor *owner = new Actor(world.GetGame());
+    TimerComponent *timers = new TimerComponent(owner);
+    for (int i = 0; i < numTimers; i++)
+    {
+        timers->AddNotRemovableTimer(1e9f, [] {});
+    }
+
+    const int numTicks = 1000;
+    bench.Run(name, numTicks, [&]
+    {
+        for (int i = 0; i < numTicks; i++)
+        {
+            timers->Update(1.f / 60.f);
+        }
+    });
+
+    world.ResetScene();
+}
+
+// Dying while a cooldown runs: the respawn re-creates the timers of the checkpoint and deletes
+// the newer ones, the handles kept by the actor have to find the first and miss the others
+static void CheckCooldownAcrossRespawn(Bench &bench, BenchWorld &world)
+{
+    Actor *owner = new Actor(world.GetGame());
+    TimerComponent *timers = new TimerComponent(owner);
+
+    const float cooldown = 1.f;
+    TimerHandle atCheckpoint = timers->AddTimer(cooldown, nullptr);
+    timers->Update(cooldown / 2.f);
+    world.TakeSceneSnapshot();
+
+    // The first cooldown runs out and is freed, a second one starts before dying
+    timers->Update(cooldown);
+    TimerHandle afterCheckpoint = timers->AddTimer(cooldown, nullptr);
+
+    world.GetGame()->RestoreSceneSnapshot();
+    world.EndFrame();
+
+    timers->Restart(afterCheckpoint);
+    bool passed = std::fabs(timers->checkTimerRemaining(atCheckpoint) - cooldown / 2.f) < 1e-4f &&
+                  timers->checkTimerRemaining(afterCheckpoint) == 0.f;
+    bench.Check("snapshot/restore/cooldown_running", passed);
+
+    world.ResetScene();
+}
+
+// Level 2's portal spawns once its area is clear. Dying before the next checkpoint puts the
+// scene back to before the spawn, so the portal has to be able to spawn again
+static void CheckPortalAcrossRespawn(Bench &bench, BenchWorld &world)
+{
+    Game *game = world.GetGame();
+    Game::GameScene previousScene = game->GetGameScene();
+    world.SetGameScene(Game::GameScene::Level2);
+
+    // Inside the cleared area, away from where the portal appears
+    const Vector2 checkpoint(1100.f, 300.f);
+    Zoe *zoe = new Zoe(game, 2000.f, checkpoint);
+    game->SetCheckpoint(checkpoint);
+    world.EndFrame();
+
+    world.CheckPortalSpawn();
+    bool spawned = game->GetPortal() != nullptr;
+
+    zoe->Kill();
+    world.EndFrame();
+    bool removed = game->GetPortal() == nullptr;
+
+    world.CheckPortalSpawn();
+    bool respawned = game->GetPortal() != nullptr;
+
+    bench.Check("snapshot/restore/portal_spawn", spawned && removed && respawned);
+
+    world.ResetScene();
+    world.SetGameScene(previousScene);
+}
+
+void RunSceneBenches(Bench &bench)
+{
+    BenchConfig(bench);
+
+    // Only created once a case that needs it is selected
+    std::unique_ptr<BenchWorld> world;
+    auto getWorld = [&world]() -> BenchWorld &
+    {
+        if (!world)
+            world.reset(new BenchWorld());
+        return *world;
+    };
+
+    for (const char *level : {"level1", "level2"})
+    {
+        if (bench.IsSelected(std::string("map/load/") + level))
+            BenchMapLoading(bench, getWorld(), level);
+    }
+
+    if (bench.IsSelected("draw/animated_component/construct"))
+        BenchDrawAnimated(bench, getWorld());
+
+    for (int numTimers : {4, 32, 256})
+    {
+        if (bench.IsSelected("timers/tick/timers=" + std::to_string(numTimers)))
+            BenchTimers(bench, getWorld(), numTimers);
+    }
+
+    if (bench.IsSelected("snapshot/restore/cooldown_running"))
+        CheckCooldownAcrossRespawn(bench, getWorld());
+
+    if (bench.IsSelected("snapshot/restore/portal_spawn"))
+        CheckPortalAcrossRespawn(bench, getWorld());
+}
@@ -0,0 +1,298 @@
+// Spatial hashing, pathfinding and AABB collision, the queries every actor runs each frame
+
+#include "Bench.h"
+#include "BenchWorld.h"
+#include "core/SpatialHashing.h"
+#include "actors/Actor.h"
+#include "actors/Tile.h"
+#include "components/RigidBodyComponent.h"
+#include "components/collider/AABBColliderComponent.h"
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+static const int LEVEL_SIZE = Game::LEVEL_WIDTH * Game::TILE_SIZE;
+
+// The world is only created once a case that needs it is selected
+using WorldGetter = std::function<BenchWorld &()>;
+
+// Plain actors spread over a level-sized grid, density is the average number of actors per cell
+static void BenchHashing(Bench &bench, const WorldGetter &getWorld, float density)
+{
+    const int numCells = Game::LEVEL_WIDTH * Game::LEVEL_HEIGHT;
+    const int numActors = static_cast<int>(numCells * density);
+    const std::string suffix = "/density=" + std::to_string(density).substr(0, 4);
+
+    bool isSelected = false;
+    for (const char *operation : {"insert", "remove", "query", "query_on_camera"})
+    {
+        isSelected = isSelected || bench.IsSelected(std::string("spatial/") + operation + suffix);
+    }
+    if (!isSelected)
+        return;
+
+    BenchWorld &world = getWorld();
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coordinate(0.f, static_cast<float>(LEVEL_SIZE - Game::TILE_SIZE));
+
+    world.ResetScene();
+    std::vector<Actor *> actors;
+    actors.reserve(numActors);
+    for (int i = 0; i < numActors; i++)
+    {
+        Actor *actor = new Actor(world.GetGame());
+        actor->SetPosition(Vector2(coordinate(rng), coordinate(rng)));
+        actors.push_back(actor);
+    }
+
+    // A grid of its own, the game's one already holds the actors
+    SpatialHashing hashing(Game::TILE_SIZE, LEVEL_SIZE, LEVEL_SIZE);
+    auto insertAll = [&] { for (Actor *actor : actors) hashing.Insert(actor); };
+    auto removeAll = [&] { for (Actor *actor : actors) hashing.Remove(actor); };
+
+    bench.Run("spatial/insert" + suffix, numActors, insertAll, removeAll);
+    bench.Run("spatial/remove" + suffix, numActors, removeAll, insertAll);
+
+    insertAll();
+
+    const int numQueries = 1000;
+    std::vector<Vector2> points;
+    for (int i = 0; i < numQueries; i++)
+    {
+        points.emplace_back(coordinate(rng), coordinate(rng));
+    }
+
+    size_t found = 0;
+    bench.Run("spatial/query" + suffix, numQueries, [&]
+    {
+        for (const Vector2 &point : points)
+        {
+            found += hashing.Query(point, 1).size();
+        }
+    });
+
+    // Same split as the active set: the camera plus a margin, and the coarse ring around it
+    const int numCameras = 100;
+    std::vector<Actor *> inner, outer;
+    bench.Run("spatial/query_on_camera" + suffix, numCameras, [&]
+    {
+        for (int i = 0; i < numCameras; i++)
+        {
+            hashing.QueryOnCamera(points[i], static_cast<float>(world.GetGame()->GetWindowWidth()),
+                                  static_cast<float>(world.GetGame()->GetWindowHeight()),
+                                  2.f * Game::TILE_SIZE, 12.f * Game::TILE_SIZE, inner, outer);
+            found += inner.size() + outer.size();
+        }
+    });
+
+    // The grid deletes what it still holds
+    removeAll();
+    world.ResetScene();
+}
+
+// Collider queries around random points of a level, for every layer and for the masks the
+// wall checks and the enemies' trap sensing use
+static void BenchLayerQueries(Bench &bench, const WorldGetter &getWorld)
+{
+    const std::pair<const char *, ColliderLayerMask> masks[] = {
+        {"all", ALL_COLLIDER_LAYERS},
+        {"blocks", LayerMask(ColliderLayer::Blocks)},
+        {"traps", LayerMask({ColliderLayer::Spikes, ColliderLayer::SpikesBlock, ColliderLayer::SpearBlock,
+                             ColliderLayer::SpearTip, ColliderLayer::Shuriken})},
+    };
+
+    bool isSelected = false;
+    for (const auto &mask : masks)
+    {
+        isSelected = isSelected || bench.IsSelected(std::string("spatial/query_colliders/") + mask.first);
+    }
+    if (!isSelected)
+        return;
+
+    BenchWorld &world = getWorld();
+
+    world.LoadMap("level1.json");
+    SpatialHashing *hashing = world.GetGame()->GetSpatialHashing();
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coordinate(0.f, static_cast<float>(LEVEL_SIZE - Game::TILE_SIZE));
+
+    const int numQueries = 1000;
+    std::vector<Vector2> points;
+    for (int i = 0; i < numQueries; i++)
+    {
+        points.emplace_back(coordinate(rng), coordinate(rng));
+    }
+
+    size_t found = 0;
+    for (const auto &mask : masks)
+    {
+        bench.Run(std::string("spatial/query_colliders/") + mask.first, numQueries, [&]
+        {
+            for (const Vector2 &point : points)
+            {
+                found += hashing->QueryColliders(point, 2, mask.second).size();
+            }
+        });
+    }
+
+    world.ResetScene();
+}
+
+// A* between random open cells of a level, as the enemies ask for it
+static void BenchPathfinding(Bench &bench, const WorldGetter &getWorld, const std::string &level, bool canFly)
+{
+    const std::string name = "path/" + level + (canFly ? "/fly" : "/walk");
+    if (!bench.IsSelected(name))
+        return;
+
+    BenchWorld &world = getWorld();
+
+    world.LoadMap(level + ".json");
+    SpatialHashing *hashing = world.GetGame()->GetSpatialHashing();
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> cell(1, Game::LEVEL_WIDTH - 2);
+
+    auto randomOpenCell = [&]
+    {
+        for (;;)
+        {
+            int row = cell(rng), col = cell(rng);
+            if (hashing->isEmptyCell(row, col))
+                return Vector2((col + .5f) * Game::TILE_SIZE, (row + .5f) * Game::TILE_SIZE);
+        }
+    };
+
+    Actor *walker = new Actor(world.GetGame());
+    new RigidBodyComponent(walker);
+
+    const int numPaths = 20;
+    std::vector<std::pair<Vector2, Vector2>> queries;
+    for (int i = 0; i < numPaths; i++)
+    {
+        queries.emplace_back(randomOpenCell(), randomOpenCell());
+    }
+
+    size_t nodes = 0;
+    bench.Run(name, numPaths, [&]
+    {
+        for (const auto &query : queries)
+        {
+            nodes += hashing->GetPath(walker, query.second, canFly).size();
+        }
+    }, [&]
+    {
+        // Moving the walker is not part of the search
+        walker->SetCenter(queries.front().first);
+    });
+
+    world.ResetScene();
+}
+
+// Bodies dropped halfway into the level's tiles, detected and pushed out on both axes
+static void BenchCollisions(Bench &bench, const WorldGetter &getWorld, int numBodies)
+{
+    const std::string name = "physics/aabb_detect_resolve/bodies=" + std::to_string(numBodies);
+    if (!bench.IsSelected(name))
+        return;
+
+    BenchWorld &world = getWorld();
+
+    world.LoadMap("level1.json");
+
+    std::vector<Actor *> actors;
+    world.GetGame()->GetSpatialHashing()->GetActors(actors);
+
+    std::vector<Vector2> tilePositions;
+    for (Actor *actor : actors)
+    {
+        if (dynamic_cast<Tile *>(actor))
+            tilePositions.push_back(actor->GetPosition());
+    }
+    if (tilePositions.empty())
+    {
+        std::fprintf(stderr, "%s: level1 has no tiles\n", name.c_str());
+        return;
+    }
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<size_t> tile(0, tilePositions.size() - 1);
+
+    struct Body
+    {
+        Actor *actor;
+        RigidBodyComponent *rigidBody;
+        AABBColliderComponent *collider;
+        Vector2 start;
+    };
+
+    std::vector<Body> bodies;
+    for (int i = 0; i < numBodies; i++)
+    {
+        Body body;
+        body.actor = new Actor(world.GetGame());
+        body.rigidBody = new RigidBodyComponent(body.actor);
+        body.collider = new AABBColliderComponent(body.actor, 0, 0, Game::TILE_SIZE, Game::TILE_SIZE, ColliderLayer::Objects);
+
+        // Traps would hurt the bodies, only the collision math is measured
+        body.collider->IgnoreLayers({ColliderLayer::Spikes, ColliderLayer::SpearTip, ColliderLayer::Shuriken},
+                                    IgnoreOption::IgnoreCallback);
+
+        body.start = tilePositions[tile(rng)] - Vector2(0.f, Game::TILE_SIZE * .5f);
+        bodies.push_back(body);
+    }
+
+    bench.Run(name, numBodies, [&]
+    {
+        for (Body &body : bodies)
+        {
+            body.collider->DetectHorizontalCollision(body.rigidBody);
+            body.collider->DetectVerticalCollision(body.rigidBody);
+        }
+    }, [&]
+    {
+        for (Body &body : bodies)
+        {
+            body.actor->SetPosition(body.start);
+        }
+    });
+
+    world.ResetScene();
+}
+
+void RunSpatialBenches(Bench &bench)
+{
+    std::unique_ptr<BenchWorld> world;
+    WorldGetter getWorld = [&world]() -> BenchWorld &
+    {
+        if (!world)
+            world.reset(new BenchWorld());
+        return *world;
+    };
+
+    for (float density : {0.25f, 1.f, 4.f})
+    {
+        BenchHashing(bench, getWorld, density);
+    }
+
+    BenchLayerQueries(bench, getWorld);
+
+    for (const char *level : {"level1", "level2"})
+    {
+        for (bool canFly : {false, true})
+        {
+            BenchPathfinding(bench, getWorld, level, canFly);
+        }
+    }
+
+    for (int numBodies : {16, 64, 256})
+    {
+        BenchCollisions(bench, getWorld, numBodies);
+    }
+}
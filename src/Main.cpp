@@ -7,6 +7,10 @@
 // ----------------------------------------------------------------
 
 #include "core/Game.h"
+#include "core/Profiler.h"
+#include "core/EngineStats.h"
+#include <cstdlib>
+#include <string>
 #define SDL_MAIN_HANDLED
 
 #ifdef __EMSCRIPTEN__
@@ -16,6 +20,8 @@ static Game* gGame = nullptr;
 
 void emscripten_loop()
 {
+    Profiler::BeginFrame();
+
     gGame->ProcessInput();
     gGame->UpdateGame();
     gGame->GenerateOutput();
@@ -25,10 +31,89 @@ void emscripten_loop()
 int main(int argc, char** argv)
 {
     Game game = Game();
+
+    // --record <file> saves the input of the session, --replay <file> plays it back at the
+    // recorded delta times (--headless skips rendering), --stats <file> writes the engine counters,
+    // --record-manifests adds the assets each scene touches to its manifest.
+    // --stress runs the stress test scene and quits, --stress-enemies/-traps/-emitters/-steps <n>
+    // override its config, --stress-report <file> writes its CSV (--headless skips rendering too)
+    std::string replayPath;
+    std::string statsPath;
+    bool headless = false;
+    bool stress = false;
+    StressTest::Settings stressSettings;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--headless")
+        {
+            headless = true;
+        }
+        else if (arg == "--record-manifests")
+        {
+            game.SetManifestRecording(true);
+        }
+        else if (arg == "--stress")
+        {
+            stress = true;
+        }
+        else if (i + 1 < argc && arg == "--stress-enemies")
+        {
+            stress = true;
+            stressSettings.enemies = std::atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && arg == "--stress-traps")
+        {
+            stress = true;
+            stressSettings.traps = std::atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && arg == "--stress-emitters")
+        {
+            stress = true;
+            stressSettings.emitters = std::atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && arg == "--stress-steps")
+        {
+            stress = true;
+            stressSettings.steps = std::atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && arg == "--stress-report")
+        {
+            stress = true;
+            stressSettings.reportPath = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--record")
+        {
+            game.SetInputRecording(argv[++i]);
+        }
+        else if (i + 1 < argc && arg == "--replay")
+        {
+            replayPath = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--stats")
+        {
+            statsPath = argv[++i];
+        }
+    }
+
+    if (!replayPath.empty())
+    {
+        game.SetInputReplay(replayPath, !headless);
+    }
+    else if (stress)
+    {
+        game.SetStressTest(stressSettings, !headless);
+    }
+
     bool success = game.Initialize();
 
     if (!success) return 1;
 
+    if (!statsPath.empty())
+    {
+        EngineStats::StartCsv(statsPath);
+    }
+
 #ifdef __EMSCRIPTEN__
     gGame = &game;
     emscripten_set_main_loop(emscripten_loop, 0, 1);
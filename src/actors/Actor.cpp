@@ -8,6 +8,7 @@
 #include "Actor.h"
 #include "../core/Game.h"
 #include "../components/Component.h"
+#include "../components/draw/ParticleEmitterComponent.h"
 #include <algorithm>
 #include "./Collider.h"
 #include "./traps/Spikes.h"
@@ -28,6 +29,8 @@ Actor::Actor(Game* game, int lives, bool mustAlwaysUpdate, std::string type)
         , mType(type)
         , mFreezingCount(0.f)
         , mTimerComponent(nullptr)
+        , mActiveEpoch(0)
+        , mCoarseTime(0.f)
         , mIsSlidingOnSnow(false)
 {
     mGame->AddActor(this);
@@ -63,6 +66,9 @@ void Actor::SetCenter(const Vector2& pos)
 
 void Actor::Update(float deltaTime)
 {
+    // Full updates cover the time a coarse one would have
+    mCoarseTime = 0.f;
+
     if (mState == ActorState::Active)
     {
         for (auto comp : mComponents)
@@ -77,6 +83,36 @@ void Actor::Update(float deltaTime)
     }
 }
 
+void Actor::CoarseUpdate()
+{
+    float deltaTime = mCoarseTime;
+    mCoarseTime = 0.f;
+
+    if (mState == ActorState::Active)
+    {
+        for (auto comp : mComponents)
+        {
+            if (comp->IsEnabled())
+            {
+                comp->CoarseUpdate(deltaTime);
+            }
+        }
+    }
+}
+
+bool Actor::HasCoarseUpdate() const
+{
+    for (auto comp : mComponents)
+    {
+        if (comp->HasCoarseUpdate())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void Actor::OnUpdate(float deltaTime)
 {
     UpdateFreezing();
@@ -106,14 +142,6 @@ void Actor::OnHorizontalCollision(const float minOverlap, AABBColliderComponent*
         TakeShurikenHit(shuriken->GetCenter());
         return;
     }
-
-    if (other->GetLayer() == ColliderLayer::Nevasca && !IsFrozen())
-    {
-        // gravity causes more VERTICAL collisions, so this is to keep a similar sensation of freezing,
-        // so we need a bigger increment when colliding horizontally
-        IncreaseFreezing(10.f);
-        return;
-    }
 }
 
 void Actor::OnVerticalCollision(const float minOverlap, AABBColliderComponent* other) 
@@ -141,12 +169,6 @@ void Actor::OnVerticalCollision(const float minOverlap, AABBColliderComponent* o
         return;
     }
 
-    if (other->GetLayer() == ColliderLayer::Nevasca && !IsFrozen())
-    {
-        IncreaseFreezing();
-        return;
-    }
-
     if (other->GetLayer() == ColliderLayer::Blocks && minOverlap > 0.f)
     {
         Tile *tile = static_cast<Tile *>(other->GetOwner());
@@ -161,6 +183,16 @@ void Actor::OnVerticalCollision(const float minOverlap, AABBColliderComponent* o
     }
 }
 
+void Actor::OnSnowHit(const ParticleHit &hit)
+{
+    if (IsFrozen())
+        return;
+
+    // gravity causes more VERTICAL collisions, so this is to keep a similar sensation of freezing,
+    // so we need a bigger increment when colliding horizontally
+    IncreaseFreezing(10.f * hit.horizontalHits + hit.verticalHits);
+}
+
 void Actor::Kill()
 {
 
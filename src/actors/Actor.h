@@ -69,6 +69,14 @@ public:
     // HandleKeyPress function called from Game (not overridable)
     void HandleKeyPress(const int key, const bool isPressed);
 
+    // Off camera but close to it, Game accumulates the frame times and every now and then
+    // runs a coarse update over them: physics and timers, no behavior or animation
+    void AddCoarseTime(float deltaTime) { mCoarseTime = Math::Min(mCoarseTime + deltaTime, 0.5f); }
+    float GetCoarseTime() const { return mCoarseTime; }
+    void CoarseUpdate();
+    // Whether a coarse update would do anything, tiles and props have nothing to catch up on
+    bool HasCoarseUpdate() const;
+
     // Position getter/setter
     const Vector2& GetPosition() const { return mPosition; }
     void SetPosition(const Vector2& pos);
@@ -129,6 +137,13 @@ public:
     virtual void OnHorizontalCollision(const float minOverlap, AABBColliderComponent* other);
     virtual void OnVerticalCollision(const float minOverlap, AABBColliderComponent* other);
     virtual void OnCollision() {};
+
+    // Nevasca particles that touched this actor in the last update
+    virtual void OnSnowHit(const struct ParticleHit &hit);
+
+    // The scene was put back to a checkpoint. Actors created since then are destroyed but not
+    // deleted yet, so pointers to them can be told apart by their state
+    virtual void OnSnapshotRestored() {}
     virtual void Kill();
     
     Vector2 GetCenter() const;
@@ -148,6 +163,10 @@ public:
 
     bool GetIsSlidingOnSnow() const { return mIsSlidingOnSnow; }
 
+    // Game marks the actors of its active set with the set's epoch to skip duplicates
+    unsigned int GetActiveEpoch() const { return mActiveEpoch; }
+    void SetActiveEpoch(unsigned int epoch) { mActiveEpoch = epoch; }
+
 protected:
     class Game* mGame;
 
@@ -199,6 +218,7 @@ private:
     friend class Component;
     friend class SetBehaviorStateStep;
     friend class MoveStep;
+    friend class SceneSnapshot;
 
     // Adds component to Actor (this is automatically called
     // in the component constructor)
@@ -206,4 +226,6 @@ private:
 
     std::function<void()> mOnDamageCallback;
     bool mInvincible;
+    unsigned int mActiveEpoch;
+    float mCoarseTime;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Zoe.h"
 #include "Actor.h"
 #include "Collider.h"
+#include "../core/Profiler.h"
 
 Enemy::Enemy(Game *game, const Vector2 &position, float maxSeeDistance, float minSeeDistance)
     : Actor(game), mMaxSeeDistance(maxSeeDistance), 
@@ -21,14 +22,56 @@ Enemy::~Enemy()
     mGame->RemoveEnemy(this);
 }
 
+void Enemy::Sense()
+{
+    PROFILE_ZONE("EnemySense");
+
+    mPerception = Perception();
+    mPerception.isValid = true;
+
+    if (Zoe *zoe = GetGame()->GetZoe())
+    {
+        mPerception.playerCenter = zoe->GetCenter();
+        mPerception.distanceToPlayerSquared = (mPerception.playerCenter - GetCenter()).LengthSq();
+        mPerception.playerOnFov = PlayerOnFov();
+        mPerception.playerOnSight = PlayerOnSight();
+    }
+
+    if (mAIMovementComponent && mAIMovementComponent->IsEnabled() && GetBehaviorState() == BehaviorState::Moving)
+    {
+        mAIMovementComponent->Sense();
+    }
+}
+
+void Enemy::OnLeftActiveSet()
+{
+    // A sighting from before going off camera must not be acted on when coming back
+    mPerception.isValid = false;
+
+    if (mAIMovementComponent)
+    {
+        mAIMovementComponent->ClearSense();
+    }
+}
+
 void Enemy::OnUpdate(float deltaTime)
 {
-    mHasSeenPlayerThisFrame = PlayerOnFov();
-    mPlayerOnSightThisFrame = PlayerOnSight();
-    mDistanceToPlayerSquared = (GetGame()->GetZoe()->GetCenter() - GetCenter()).LengthSq();
+    // Enemies left out of the sense phase (not active yet when it ran) sense here
+    if (!mPerception.isValid)
+    {
+        Sense();
+    }
+    mPerception.isValid = false;
+
+    mHasSeenPlayerThisFrame = mPerception.playerOnFov;
+    mPlayerOnSightThisFrame = mPerception.playerOnSight;
+    if (GetGame()->GetZoe())
+    {
+        mDistanceToPlayerSquared = mPerception.distanceToPlayerSquared;
+    }
     
     if (mHasSeenPlayerThisFrame) {
-        mLastSeenPlayerCenter = GetGame()->GetZoe()->GetCenter();
+        mLastSeenPlayerCenter = mPerception.playerCenter;
         mLastSeenPlayerDistanceSquared = mDistanceToPlayerSquared;
         mHowLongLastSeenPlayer = 0.f;
     }
@@ -75,7 +118,7 @@ bool Enemy::PlayerOnFov()
         return false;
 
     Vector2 toZoe = zoe->GetCenter() - GetCenter();
-    float distanceToZoeSq = GetDistanceToPlayerSquared();
+    float distanceToZoeSq = toZoe.LengthSq();
 
     if (distanceToZoeSq > maxDistance * maxDistance) return false;
 
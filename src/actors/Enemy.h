@@ -13,6 +13,14 @@ public:
     void OnUpdate(float deltaTime) override;
     virtual void ManageState() = 0;
 
+    // Read-only look at the world (player visibility, obstacles around), stored until
+    // the next update. Game runs it for every enemy in parallel before updating actors,
+    // so it must not change anything outside this enemy's perception.
+    void Sense();
+
+    // Called by Game when the enemy stops being fully updated, what it sensed goes stale
+    void OnLeftActiveSet();
+
     Vector2 GetCurrentAppliedForce(float modifier=0.f) const;
     Vector2 GetCurrentVelocity(float modifier=0.f) const;
 
@@ -58,6 +66,16 @@ protected:
     bool HasSeenPlayerRecently(float timeThreshold=2.f) const { return mHowLongLastSeenPlayer <= timeThreshold; }
 
 private:
+    struct Perception
+    {
+        bool isValid = false;
+        bool playerOnFov = false;
+        bool playerOnSight = false;
+        float distanceToPlayerSquared = 0.f;
+        Vector2 playerCenter;
+    };
+
+    Perception mPerception;
     float mMaxSeeDistance, mMinSeeDistance;
     bool mHasSeenPlayerThisFrame, mPlayerOnSightThisFrame;
     Vector2 mLastSeenPlayerCenter, mSpawnPosition;
@@ -1,5 +1,8 @@
 #include "./Father.h"
 
+static const AnimationId ANIM_IDLE = InternAnimation("idle");
+static const AnimationId ANIM_MOVING = InternAnimation("moving");
+
 Father::Father(
     Game *game,
     const Vector2& center
@@ -14,7 +17,7 @@ Father::Father(
 
     mDrawComponent->AddAnimation("idle", 0, 5);
     mDrawComponent->AddAnimation("moving", 6, 12);
-    mDrawComponent->SetAnimation("idle");
+    mDrawComponent->SetAnimation(ANIM_IDLE);
     
     mColliderComponent = new AABBColliderComponent(
         this,
@@ -35,12 +38,12 @@ void Father::ManageAnimations()
     switch (GetBehaviorState())
     {
     case BehaviorState::Idle:
-        mDrawComponent->SetAnimation("idle");
+        mDrawComponent->SetAnimation(ANIM_IDLE);
         mDrawComponent->SetAnimFPS(6.f);
         break;
 
     case BehaviorState::Moving:
-        mDrawComponent->SetAnimation("moving");
+        mDrawComponent->SetAnimation(ANIM_MOVING);
         mDrawComponent->SetAnimFPS(10.f);
         break;
 
@@ -305,19 +305,19 @@ void Item::OnProcessInput(const Uint8 *keyState, const std::vector<SDL_Event> &e
   if (mIsPicked || !mIsPickable)
     return;
 
-  SDL_GameController *controller = GetGame()->GetController();
+  Game *game = GetGame();
 
-  if (mButton == Button::RT && SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_TRIGGERRIGHT) <= 0)
+  if (mButton == Button::RT && game->GetControllerAxis(SDL_CONTROLLER_AXIS_TRIGGERRIGHT) <= 0)
   {
     return;
   }
 
-  else if (mButton == Button::LT && SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_TRIGGERLEFT) <= 0)
+  else if (mButton == Button::LT && game->GetControllerAxis(SDL_CONTROLLER_AXIS_TRIGGERLEFT) <= 0)
   {
     return;
   }
 
-  else if (mButton != Button::RT && mButton != Button::LT /*needs to be here*/ && !SDL_GameControllerGetButton(controller, GetSDLButton(mButton)))
+  else if (mButton != Button::RT && mButton != Button::LT /*needs to be here*/ && !game->GetControllerButton(GetSDLButton(mButton)))
   {
     return;
   }
@@ -1,6 +1,7 @@
 #include <stdexcept>
 #include "./MapObject.h"
 #include "../core/Game.h"
+#include "../core/TriggerIndex.h"
 #include "../actors/enemies/Sith.h"
 #include "../actors/enemies/Zod.h"
 #include "../actors/enemies/Quasar.h"
@@ -15,163 +16,144 @@
 
 MapObject::MapObject(Game *game, int inId, const std::string &ev, const std::string &func_name,
                      const Vector2 &pos, const Vector2 &size, const json &parameters)
-    : Actor(game, 1, true), mID(inId), mEvent(ev), mFunctionName(func_name),
-      mIsPlayerInside(false), mWasPlayerInside(false),
-      mParameters(parameters), mCloseToCenterDistanceSQ(0.f),
-      mIsPlayerContainedInMe(false)
+    : Actor(game, 1), mID(inId), mEvent(ParseEvent(ev)), mAction(ParseAction(func_name)),
+      mSize(size), mTrigger(-1), mCloseToCenterDistanceSQ(0.f), mEntityCode(EntityCode::Zoe)
 {
-    if (ev != "in" && ev != "out" && ev != "enter" && ev != "exit" && ev != "closeToCenter" && ev != "contains" // always player related
-        && ev != "atStart"                                                                  // not related to player
-    )
-    {
-        throw std::runtime_error("MapObject event must be 'in', 'out', 'enter', 'exit', 'closeToCenter' or 'atStart'");
-    }
-
-    if (ev == "closeToCenter" && !parameters.contains("distance"))
+    if (mEvent == Event::CloseToCenter && !parameters.contains("distance"))
     {
         throw std::runtime_error("MapObject event 'closeToCenter' requires 'distance' parameter");
     }
 
-    if (ev == "closeToCenter")
+    if (mEvent == Event::CloseToCenter)
     {
         float dist = parameters["distance"].get<float>();
         mCloseToCenterDistanceSQ = dist * dist; // store squared distance
     }
 
-    if (mFunctionName == "play_cutscene" && !parameters.contains("cutscene_name"))
+    if (mAction == Action::PlayCutscene)
     {
-        throw std::runtime_error("MapObject function 'play_cutscene' requires 'cutscene_name' parameter");
+        if (!parameters.contains("cutscene_name"))
+        {
+            throw std::runtime_error("MapObject function 'play_cutscene' requires 'cutscene_name' parameter");
+        }
+        mCutsceneName = parameters["cutscene_name"].get<std::string>();
     }
 
-    if (mFunctionName == "spawn_entity" && !parameters.contains("entity_code"))
+    if (mAction == Action::SpawnEntity)
     {
-        throw std::runtime_error("MapObject function 'spawn_entity' requires 'entity_code' parameter");
+        if (!parameters.contains("entity_code"))
+        {
+            throw std::runtime_error("MapObject function 'spawn_entity' requires 'entity_code' parameter");
+        }
+        mEntityCode = static_cast<EntityCode>(parameters["entity_code"].get<int>());
     }
 
     SetPosition(pos);
 
-    mRigidBodyComponent = new RigidBodyComponent(this, 1.0f, 0.0f);
-    mRigidBodyComponent->SetApplyGravity(false);
-    mRigidBodyComponent->SetApplyFriction(false);
-
-    mColliderComponent = new AABBColliderComponent(
-        this, 
-        0, 0, 
-        size.x, size.y,
-        ColliderLayer::Objects,
-        false, 
-        10);
-    
-    mColliderComponent->SetIgnoreLayers({
-        ColliderLayer::Blocks
-    });
-
-    if (ev == "atStart")
+    if (mEvent == Event::AtStart)
     {
         CallMyFunction();
+        return;
     }
+
+    // Out and closeToCenter can fire wherever the player is
+    bool alwaysEvaluated = mEvent == Event::Out || mEvent == Event::CloseToCenter;
+    mTrigger = mGame->GetTriggerIndex()->Add(this, pos, pos + size, alwaysEvaluated);
 }
 
-void MapObject::CallMyFunction()
+MapObject::~MapObject()
 {
-    if (mFunctionName == "log")
+    if (mTrigger >= 0)
     {
-        Log();
-        return;
+        mGame->GetTriggerIndex()->Remove(mTrigger);
     }
+}
 
-    if (mFunctionName == "play_cutscene")
-    {
-        PlayCutscene();
-        return;
-    }
+MapObject::Event MapObject::ParseEvent(const std::string &event)
+{
+    // always player related
+    if (event == "in") return Event::In;
+    if (event == "out") return Event::Out;
+    if (event == "enter") return Event::Enter;
+    if (event == "exit") return Event::Exit;
+    if (event == "closeToCenter") return Event::CloseToCenter;
+    if (event == "contains") return Event::Contains;
+
+    // not related to player
+    if (event == "atStart") return Event::AtStart;
+
+    throw std::runtime_error("MapObject event must be 'in', 'out', 'enter', 'exit', 'closeToCenter', 'contains' or 'atStart'");
+}
 
-    if (mFunctionName == "spawn_entity")
-    {
-        SpawnEntity();
-        return;
-    }
+MapObject::Action MapObject::ParseAction(const std::string &functionName)
+{
+    if (functionName == "log") return Action::Log;
+    if (functionName == "play_cutscene") return Action::PlayCutscene;
+    if (functionName == "spawn_entity") return Action::SpawnEntity;
+    if (functionName == "teleport_to_checkpoint") return Action::TeleportToCheckpoint;
+    if (functionName == "teleport_to_checkpoint_if_damaged") return Action::TeleportToCheckpointIfDamaged;
 
-    if (mFunctionName == "teleport_to_checkpoint")
-    {
-        TeleportToCheckpoint();
-        return;
-    }
+    throw std::runtime_error("MapObject unknown function name: " + functionName);
+}
 
-    if (mFunctionName == "teleport_to_checkpoint_if_damaged")
+void MapObject::CallMyFunction()
+{
+    switch (mAction)
     {
+    case Action::Log:
+        Log();
+        break;
+    case Action::PlayCutscene:
+        PlayCutscene();
+        break;
+    case Action::SpawnEntity:
+        SpawnEntity();
+        break;
+    case Action::TeleportToCheckpoint:
+        TeleportToCheckpoint();
+        break;
+    case Action::TeleportToCheckpointIfDamaged:
         TeleportToCheckpointIfDamaged();
-        return;
+        break;
     }
-
-    throw std::runtime_error("MapObject unknown function name: " + mFunctionName);
 }
 
-void MapObject::OnUpdate(float deltaTime)
+void MapObject::Evaluate(bool isPlayerInside, bool wasPlayerInside, bool isPlayerContainedInMe)
 {
-    // do logic before because components update before actor update
-    float distanceToPlayerSQ = 9999999;
-    
-    auto *zoe = mGame->GetZoe();
-
-    if (zoe)
-    {
-        distanceToPlayerSQ = (zoe->GetCenter() - GetCenter()).LengthSq();
-    }
+    bool triggered = false;
 
-    // if - return isnt welcome here, because there is a final operation.
-
-    if (mEvent == "in" && mIsPlayerInside)
-    {
-        CallMyFunction();
-    }
-    
-    else if (mEvent == "out" && !mIsPlayerInside)
+    switch (mEvent)
     {
-        CallMyFunction();
-    }
-        
-    else if (mEvent == "enter" && mIsPlayerInside && !mWasPlayerInside)
-    {
-        CallMyFunction();
-    }
-        
-    else if (mEvent == "exit" && !mIsPlayerInside && mWasPlayerInside)
+    case Event::In:
+        triggered = isPlayerInside;
+        break;
+    case Event::Out:
+        triggered = !isPlayerInside;
+        break;
+    case Event::Enter:
+        triggered = isPlayerInside && !wasPlayerInside;
+        break;
+    case Event::Exit:
+        triggered = !isPlayerInside && wasPlayerInside;
+        break;
+    case Event::CloseToCenter:
     {
-        CallMyFunction();
+        auto *zoe = mGame->GetZoe();
+        triggered = zoe && (zoe->GetCenter() - GetTriggerCenter()).LengthSq() <= mCloseToCenterDistanceSQ;
+        break;
     }
-    
-    else if (mEvent == "closeToCenter" && distanceToPlayerSQ <= mCloseToCenterDistanceSQ)
-    {
-        CallMyFunction();
+    case Event::Contains:
+        triggered = isPlayerContainedInMe;
+        break;
+    case Event::AtStart:
+        break;
     }
 
-    else if (mEvent == "contains" && mIsPlayerContainedInMe)
+    // Actions that destroy this object only take effect at the end of the frame
+    if (triggered && GetState() == ActorState::Active)
     {
         CallMyFunction();
     }
-
-    mWasPlayerInside = mIsPlayerInside;
-    mIsPlayerInside = false;
-    mIsPlayerContainedInMe = false;
-}
-
-void MapObject::OnVerticalCollision(const float minOverlap, AABBColliderComponent *other)
-{
-    if (other->GetLayer() == ColliderLayer::Player)
-    {
-        mIsPlayerInside = true;
-        mIsPlayerContainedInMe = other->IsContainedIn(*mColliderComponent);
-    }
-}
-
-void MapObject::OnHorizontalCollision(const float minOverlap, AABBColliderComponent *other)
-{
-    if (other->GetLayer() == ColliderLayer::Player)
-    {
-        mIsPlayerInside = true;
-        mIsPlayerContainedInMe = other->IsContainedIn(*mColliderComponent);
-    }
 }
 
 void MapObject::Log()
@@ -181,55 +163,49 @@ void MapObject::Log()
 
 void MapObject::PlayCutscene()
 {
-    // if (mParameters.contains("cutscene_name")) verified in constructor
-    std::string cutsceneName = mParameters["cutscene_name"].get<std::string>();
-    
-    mGame->StartCutscene(cutsceneName);
+    mGame->StartCutscene(mCutsceneName);
     SetState(ActorState::Destroy);
 }
 
 void MapObject::SpawnEntity()
 {
-    // if (!mParameters.contains("entity_code")) verified in constructor
-    EntityCode code = static_cast<EntityCode>(mParameters["entity_code"].get<int>());
-    
-    switch (code)
+    switch (mEntityCode)
     {
     case EntityCode::Zoe:
-        new Zoe(mGame, 2000.0f, GetCenter());
+        new Zoe(mGame, 2000.0f, GetTriggerCenter());
         break;
     case EntityCode::Sith:
-        new Sith(mGame, GetCenter());
+        new Sith(mGame, GetTriggerCenter());
         break;
     case EntityCode::Zod:
-        new Zod(mGame, GetCenter());
+        new Zod(mGame, GetTriggerCenter());
         break;
     case EntityCode::Shuriken:
-        new Shuriken(mGame, GetCenter());
+        new Shuriken(mGame, GetTriggerCenter());
         break;
     case EntityCode::Spear:
-        new Spear(mGame, GetCenter());
+        new Spear(mGame, GetTriggerCenter());
         break;
     case EntityCode::Spikes:
-        new Spikes(mGame, GetCenter());
+        new Spikes(mGame, GetTriggerCenter());
         break;
     case EntityCode::Portal:
-        new Portal(mGame, GetCenter());
+        new Portal(mGame, GetTriggerCenter());
         break;
     case EntityCode::Quasar:
-        new Quasar(mGame, GetCenter());
+        new Quasar(mGame, GetTriggerCenter());
         break;
     case EntityCode::InversedSpear:
-        new Spear(mGame, GetCenter(), true);
+        new Spear(mGame, GetTriggerCenter(), true);
         break;
     case EntityCode::Zathura:
-        new Zathura(mGame, GetCenter());
+        new Zathura(mGame, GetTriggerCenter());
         break;
     case EntityCode::Father:
-        new Father(mGame, GetCenter());
+        new Father(mGame, GetTriggerCenter());
         break;
     case EntityCode::Mother:
-        new Mother(mGame, GetCenter());
+        new Mother(mGame, GetTriggerCenter());
         break;
     default:
         throw std::runtime_error("MapObject unknown SpawnCode");
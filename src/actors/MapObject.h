@@ -28,21 +28,48 @@ public:
         Mother=11
     };
 
+    // Parsed from the map's strings once, when the object is created
+    enum class Event {
+        In,
+        Out,
+        Enter,
+        Exit,
+        CloseToCenter,
+        Contains,
+        AtStart
+    };
+
+    enum class Action {
+        Log,
+        PlayCutscene,
+        SpawnEntity,
+        TeleportToCheckpoint,
+        TeleportToCheckpointIfDamaged
+    };
+
     MapObject(Game *game, int inId, const std::string &ev, const std::string &func_name, 
               const Vector2 &pos, const Vector2 &size, const json &parameters=json::object());
+    ~MapObject() override;
 
-    void OnUpdate(float deltaTime) override;
-    void OnVerticalCollision(const float minOverlap, AABBColliderComponent* other) override;
-    void OnHorizontalCollision(const float minOverlap, AABBColliderComponent* other) override;
+    // Called by the scene's TriggerIndex, which tracks where the player is
+    void Evaluate(bool isPlayerInside, bool wasPlayerInside, bool isPlayerContainedInMe);
 
     int mID;
-    json mParameters;
-    std::string mEvent, mFunctionName;
-    AABBColliderComponent *mColliderComponent;
-    RigidBodyComponent *mRigidBodyComponent; // only to check collision
-    bool mIsPlayerInside, mWasPlayerInside, mIsPlayerContainedInMe;
+    Event mEvent;
+    Action mAction;
+    Vector2 mSize;
+    int mTrigger; // in the scene's TriggerIndex, -1 for atStart objects
     float mCloseToCenterDistanceSQ;
 
+    // Action parameters, read from the map's parameters by the action that needs them
+    std::string mCutsceneName;
+    EntityCode mEntityCode;
+
+    static Event ParseEvent(const std::string &event);
+    static Action ParseAction(const std::string &functionName);
+
+    Vector2 GetTriggerCenter() const { return GetPosition() + mSize * 0.5f; }
+
     void Log();
     void PlayCutscene();
     void SpawnEntity();
@@ -41,12 +41,6 @@ void MetalCrate::OnHorizontalCollision(const float minOverlap, AABBColliderCompo
 {
     if (IsFrozen()) return;
 
-    if (other->GetLayer() == ColliderLayer::Nevasca)
-    {
-        IncreaseFreezing();
-        return;
-    }
-    
     if (other->GetLayer() == ColliderLayer::Player) {
         float force = mGame->GetConfig()->Get<float>("METAL_CRATE_PUSH_FORCE");
         mRigidBodyComponent->ApplyForce(Vector2(-minOverlap * force, 0.f));
@@ -67,11 +61,13 @@ void MetalCrate::OnHorizontalCollision(const float minOverlap, AABBColliderCompo
 
 void MetalCrate::OnVerticalCollision(const float minOverlap, AABBColliderComponent *other)
 {
-    if (other->GetLayer() == ColliderLayer::Nevasca && !IsFrozen())
-    {
-        IncreaseFreezing();
-        return;
-    }
+}
+
+void MetalCrate::OnSnowHit(const ParticleHit &hit)
+{
+    if (IsFrozen()) return;
+
+    IncreaseFreezing(static_cast<float>(hit.horizontalHits + hit.verticalHits));
 }
 
 void MetalCrate::ManageAnimations()
@@ -11,6 +11,7 @@ class MetalCrate : public Actor
 private:
     void OnHorizontalCollision(const float minOverlap, AABBColliderComponent* other) override;
     void OnVerticalCollision(const float minOverlap, AABBColliderComponent* other) override;
+    void OnSnowHit(const struct ParticleHit &hit) override;
     void ManageAnimations();
     void OnUpdate(float deltaTime) override;
     void AnimationEndCallback(std::string animationName);
@@ -1,5 +1,8 @@
 #include "./Mother.h"
 
+static const AnimationId ANIM_IDLE = InternAnimation("idle");
+static const AnimationId ANIM_MOVING = InternAnimation("moving");
+
 Mother::Mother(
     Game *game,
     const Vector2& center
@@ -14,7 +17,7 @@ Mother::Mother(
 
     mDrawComponent->AddAnimation("idle", 0, 3);
     mDrawComponent->AddAnimation("moving", 4, 9);
-    mDrawComponent->SetAnimation("idle");
+    mDrawComponent->SetAnimation(ANIM_IDLE);
     
     mColliderComponent = new AABBColliderComponent(
         this,
@@ -35,12 +38,12 @@ void Mother::ManageAnimations()
     switch (GetBehaviorState())
     {
     case BehaviorState::Idle:
-        mDrawComponent->SetAnimation("idle");
+        mDrawComponent->SetAnimation(ANIM_IDLE);
         mDrawComponent->SetAnimFPS(6.f);
         break;
 
     case BehaviorState::Moving:
-        mDrawComponent->SetAnimation("moving");
+        mDrawComponent->SetAnimation(ANIM_MOVING);
         mDrawComponent->SetAnimFPS(10.f);
         break;
 
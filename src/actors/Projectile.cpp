@@ -11,7 +11,7 @@ Projectile::Projectile(
     Actor* shooter,
     float mDieTime
 ): Actor(game), mKnockbackIntensity(10.f), mShooter(shooter), mDieTime(mDieTime), 
-   mLastFireDirection(Vector2::Zero), mDieTimer(nullptr)
+   mLastFireDirection(Vector2::Zero), mDieTimer(NO_TIMER)
 {
     SetPosition(position);
 
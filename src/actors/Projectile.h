@@ -2,6 +2,7 @@
 #include <SDL.h>
 #include "../core/Game.h"
 #include "Actor.h"
+#include "../components/TimerComponent.h"
 
 class Projectile : public Actor
 {    
@@ -34,7 +35,7 @@ protected:
 
     Actor *mShooter;
     float mDieTime;
-    Timer *mDieTimer;
+    TimerHandle mDieTimer;
 
     Vector2 GetLastFireDirection() const { return mLastFireDirection; }
 };
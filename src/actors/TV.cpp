@@ -10,7 +10,7 @@ TV::TV(Game *game, const Vector2 &position)
           std::bind(&TV::OnPick, this),
           Button::A,
           0, 0, 1, false, true), 
-    mTurnOnTimer(nullptr)
+    mTurnOnTimer(NO_TIMER)
 {
     mDrawComponent->SetDrawOrder(static_cast<int>(DrawLayerPosition::DetailsDown));
 
@@ -23,7 +23,7 @@ TV::TV(Game *game, const Vector2 &position)
 void TV::OnPick()
 {
     if (
-        mTurnOnTimer != nullptr &&
+        mTurnOnTimer != NO_TIMER &&
         mTimerComponent->checkTimerRemaining(mTurnOnTimer) > 0.f
     )
     {
@@ -34,7 +34,7 @@ void TV::OnPick()
 
     SetBehaviorState(mBehaviorState == BehaviorState::Idle ? BehaviorState::Moving : BehaviorState::Idle);
 
-    if (mTurnOnTimer == nullptr)
+    if (mTurnOnTimer == NO_TIMER)
         mTurnOnTimer = mTimerComponent->AddNotRemovableTimer(.5f, nullptr);
     else
         mTimerComponent->Restart(mTurnOnTimer);
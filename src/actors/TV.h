@@ -11,5 +11,5 @@ public:
 
     void OnPick() override;
 
-    Timer *mTurnOnTimer;
+    TimerHandle mTurnOnTimer;
 };
\ No newline at end of file
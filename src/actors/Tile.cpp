@@ -2,6 +2,7 @@
 #include "../core/Game.h"
 #include "../components/draw/DrawTileComponent.h"
 #include "../components/collider/AABBColliderComponent.h"
+#include "../components/draw/ParticleEmitterComponent.h"
 
 Tile::Tile(
     Game *game,
@@ -51,23 +52,37 @@ void Tile::OnHorizontalCollision(const float minOverlap, AABBColliderComponent *
 {
     // Actor::OnHorizontalCollision(minOverlap, other);
     // dont want some of the collisions checked above, so moving logic up.
-
-    if (other->GetLayer() == ColliderLayer::Nevasca && !IsFrozen())
-    {
-        IncreaseFreezing(10.f);
-        mLastSnowCollision = minOverlap > 0 ? SnowDirection::RIGHT : SnowDirection::LEFT;
-    }
 }
 
 void Tile::OnVerticalCollision(const float minOverlap, AABBColliderComponent *other)
 {
     // Actor::OnVerticalCollision(minOverlap, other);
     // dont want some of the collisions checked above, so moving logic up.
-    
-    if (other->GetLayer() == ColliderLayer::Nevasca && !IsFrozen())
+}
+
+void Tile::OnSnowHit(const ParticleHit &hit)
+{
+    if (IsFrozen())
+        return;
+
+    IncreaseFreezing(10.f * hit.horizontalHits + hit.verticalHits);
+
+    if (hit.verticalHits > 0)
+    {
+        mLastSnowCollision = hit.verticalOverlap > 0 ? SnowDirection::DOWN : SnowDirection::UP;
+    }
+    else
+    {
+        mLastSnowCollision = hit.horizontalOverlap > 0 ? SnowDirection::RIGHT : SnowDirection::LEFT;
+    }
+}
+
+void Tile::OnSnapshotRestored()
+{
+    // Snow from a freeze that started after the checkpoint
+    if (mSnow != nullptr && mSnow->GetState() == ActorState::Destroy)
     {
-        IncreaseFreezing();
-        mLastSnowCollision = minOverlap > 0 ? SnowDirection::DOWN : SnowDirection::UP;
+        mSnow = nullptr;
     }
 }
 
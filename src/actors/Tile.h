@@ -12,6 +12,8 @@ class Tile : public Actor
 private:
     void OnHorizontalCollision(const float minOverlap, AABBColliderComponent* other) override;
     void OnVerticalCollision(const float minOverlap, AABBColliderComponent* other) override;
+    void OnSnowHit(const struct ParticleHit &hit) override;
+    void OnSnapshotRestored() override;
     void OnUpdate(float deltaTime) override;
     void StopFreeze() override;
     void Freeze() override;
@@ -1,15 +1,29 @@
 #include "Zoe.h"
 
+// ManageAnimations sets one of these every frame
+static const AnimationId ANIM_IDLE = InternAnimation("idle");
+static const AnimationId ANIM_SPRAYING = InternAnimation("spraying");
+static const AnimationId ANIM_RUN = InternAnimation("run");
+static const AnimationId ANIM_JUMP = InternAnimation("jump");
+static const AnimationId ANIM_HURT = InternAnimation("hurt");
+static const AnimationId ANIM_CHARGING = InternAnimation("charging");
+static const AnimationId ANIM_GROUND_CRUSH = InternAnimation("ground-crush");
+static const AnimationId ANIM_DODGING = InternAnimation("dodging");
+static const AnimationId ANIM_AERIAL_CRUSH = InternAnimation("aerial-crush");
+static const AnimationId ANIM_CLINGING = InternAnimation("clinging");
+static const AnimationId ANIM_GROUND_CRUSH_CHARGE = InternAnimation("ground-crush-charge");
+static const AnimationId ANIM_GROUND_CRUSH_CHARGED = InternAnimation("ground-crush-charged");
+
 Zoe::Zoe(
     Game *game, const float forwardSpeed, const Vector2 &center)
     : Actor(game, game->GetConfig()->Get<int>("ZOE.LIFE_POINTS"), true, "zoe"), mForwardSpeed(forwardSpeed),
-      mTryingToFireFireball(false), mFireballCooldownTimer(), mDodgeCooldownTimer(),
+      mTryingToFireFireball(false), mFireballCooldownTimer(NO_TIMER), mDodgeCooldownTimer(NO_TIMER),
       mLandedAfterVentania(false), mTryingToTriggerVentania(false),
       mIsTryingToHit(false), mAttackCollider(nullptr), mIsTryingToDodge(false),
       mInputMovementDir(0.f, 0.f), mMovementLocked(false), mAbilitiesLocked(false),
       mDamageSoundHandle(SoundHandle::Invalid), mIsTryingToJump(false), mNevascaSoundHandle(SoundHandle::Invalid),
       mIsTryingToNevasca(false), mIsFiringNevasca(false), mNevascaTimer(0.f), mAerialAttackCollider(nullptr),
-      mCoyoteTimer(nullptr), mDashGravityDisableTimer(nullptr), mCurrentCheckpoint(nullptr), mDeaths(0), 
+      mCoyoteTimer(NO_TIMER), mDashGravityDisableTimer(NO_TIMER), mCurrentCheckpoint(nullptr), mDeaths(0), 
       mMana(game->GetConfig()->Get<float>("ZOE.MAX_MANA")), mConsumedManaThisFrame(false), 
       mIsDodgeAllowed(game->GetConfig()->Get<bool>("ZOE.IS_DODGE_ALLOWED")), 
       mIsVentaniaAllowed(game->GetConfig()->Get<bool>("ZOE.IS_VENTANIA_ALLOWED")),
@@ -47,7 +61,28 @@ Zoe::Zoe(
     mDrawComponent->AddAnimation("charging", 42, 47);
     mDrawComponent->AddAnimation("spraying", 45, 47);
 
-    mDrawComponent->SetAnimation("idle");
+    mDrawComponent->SetAnimation(ANIM_IDLE);
+
+    // Three flakes per Nevasca tick, living a second and a half
+    mNevascaEmitter = new ParticleEmitterComponent(
+        this,
+        "../assets/Sprites/Zoe/Nevasca/texture.png",
+        "../assets/Sprites/Zoe/Nevasca/texture.json",
+        128,
+        static_cast<int>(DrawLayerPosition::Player) - 1);
+
+    mNevascaEmitter->SetLifetime(1.5f);
+    mNevascaEmitter->SetGravity(GRAVITY * .3f / .1f);
+    mNevascaEmitter->SetGroundFriction(10.f);
+    mNevascaEmitter->SetMaxSpeed(750.f);
+    mNevascaEmitter->SetCollision(ParticleCollision::Tiles, Vector2(4.f, 4.f), Vector2(8.f, 8.f));
+    mNevascaEmitter->SetHitLayer(ColliderLayer::Nevasca);
+    mNevascaEmitter->SetHitCallback([](const std::vector<ParticleHit> &hits)
+                                    {
+        for (const ParticleHit &hit : hits)
+        {
+            hit.actor->OnSnowHit(hit);
+        } });
 
     mColliderComponent->SetIgnoreLayers(
         Zoe::IGNORED_LAYERS_DEFAULT);
@@ -67,7 +102,7 @@ Zoe::Zoe(
         1.f, 
         [this]() {
             RegenerateMana();
-            mManaRegenTimerHandle->Restart();
+            mTimerComponent->Restart(mManaRegenTimerHandle);
         }
     );
 
@@ -92,9 +127,7 @@ void Zoe::OnProcessInput(const uint8_t *state, const std::vector<SDL_Event> &eve
         return;
     }
 
-    SDL_GameController *controller = GetGame()->GetController();
-
-    CheckAbilitiesKeys(events, controller);
+    CheckAbilitiesKeys(events);
 
     if (mMovementLocked)
     {
@@ -442,7 +475,7 @@ void Zoe::OnUpdate(float deltaTime)
 {
     if (mGame->GetGamePlayState() == Game::GamePlayState::Dialogue)
     {
-        mDrawComponent->SetAnimation("idle");
+        mDrawComponent->SetAnimation(ANIM_IDLE);
         return;
     }
 
@@ -519,70 +552,70 @@ void Zoe::ManageAnimations()
     {
         if (mIsFiringNevasca)
         {
-            mDrawComponent->SetAnimation("spraying");
+            mDrawComponent->SetAnimation(ANIM_SPRAYING);
             mDrawComponent->SetAnimFPS(6.f);
             break;
         }
 
-        mDrawComponent->SetAnimation("idle");
+        mDrawComponent->SetAnimation(ANIM_IDLE);
         mDrawComponent->SetAnimFPS(10.0f);
         break;
     }
     case BehaviorState::Moving:
-        mDrawComponent->SetAnimation("run");
+        mDrawComponent->SetAnimation(ANIM_RUN);
         mDrawComponent->SetAnimFPS(10.0f);
         break;
     case BehaviorState::Jumping:
-        mDrawComponent->SetAnimation("jump");
+        mDrawComponent->SetAnimation(ANIM_JUMP);
         break;
     case BehaviorState::Falling:
-        mDrawComponent->SetAnimation("jump");
+        mDrawComponent->SetAnimation(ANIM_JUMP);
         break;
     case BehaviorState::Dying:
         break;
     case BehaviorState::Dead:
-        mDrawComponent->SetAnimation("hurt");
+        mDrawComponent->SetAnimation(ANIM_HURT);
         mDrawComponent->SetAnimFPS(14.f);
         break;
     case BehaviorState::TakingDamage:
-        mDrawComponent->SetAnimation("hurt");
+        mDrawComponent->SetAnimation(ANIM_HURT);
         mDrawComponent->SetAnimFPS(14.f);
         break;
     case BehaviorState::Charging:
-        mDrawComponent->SetAnimation("charging");
+        mDrawComponent->SetAnimation(ANIM_CHARGING);
         mDrawComponent->SetAnimFPS(32.0f);
         break;
 
     case BehaviorState::Attacking:
-        mDrawComponent->SetAnimation("ground-crush");
+        mDrawComponent->SetAnimation(ANIM_GROUND_CRUSH);
         mDrawComponent->SetAnimFPS(12.0f);
         break;
 
     case BehaviorState::Dodging:
-        mDrawComponent->SetAnimation("dodging");
+        mDrawComponent->SetAnimation(ANIM_DODGING);
         mDrawComponent->SetAnimFPS(1.75f);
         break;
 
     case BehaviorState::AerialAttacking:
-        mDrawComponent->SetAnimation("aerial-crush");
+        mDrawComponent->SetAnimation(ANIM_AERIAL_CRUSH);
         mDrawComponent->SetAnimFPS(12.0f);
         break;
 
     case BehaviorState::Clinging:
-        mDrawComponent->SetAnimation("clinging");
+        mDrawComponent->SetAnimation(ANIM_CLINGING);
         mDrawComponent->SetAnimFPS(8.f);
         break;
 
     case BehaviorState::Dashing:
-        mDrawComponent->SetAnimation("jump");
+        mDrawComponent->SetAnimation(ANIM_JUMP);
         break;
 
     case BehaviorState::ChargingAttack:
         if (mAttackChargeCounter < mGame->GetConfig()->Get<float>("ZOE.ATTACK_CHARGE_TIME")) {
-            mDrawComponent->SetAnimation("ground-crush-charge");
+            mDrawComponent->SetAnimation(ANIM_GROUND_CRUSH_CHARGE);
             mDrawComponent->SetAnimFPS(6);
         } else {
-            mDrawComponent->SetAnimation("ground-crush-charged");
+            mDrawComponent->SetAnimation(ANIM_GROUND_CRUSH_CHARGED);
             mDrawComponent->SetAnimFPS(1);
         }
         break;
@@ -620,12 +653,41 @@ void Zoe::Kill()
     mDeaths++;
     mGame->SetCameraCenterToShake(0.4f, 5);
     mGame->GetAudio()->PlaySound("respawn.wav");
+
+    // The rest of the scene follows at the end of the frame, when there is a snapshot
+    mGame->RestoreSceneSnapshot();
+    RespawnAtCheckpoint();
+}
+
+void Zoe::RespawnAtCheckpoint()
+{
     SetPosition(GetCurrentCheckpoint()->position - GetHalfSize());
     SetLifes(mGame->GetConfig()->Get<int>("ZOE.LIFE_POINTS"));
     SetBehaviorState(BehaviorState::Idle);
     mRigidBodyComponent->ResetVelocity();
 }
 
+void Zoe::OnSnapshotRestored()
+{
+    // Attacks started after the checkpoint are gone with the actors created since
+    if (mAttackCollider != nullptr && mAttackCollider->GetState() == ActorState::Destroy)
+    {
+        mAttackCollider = nullptr;
+    }
+
+    if (mAerialAttackCollider != nullptr && mAerialAttackCollider->GetState() == ActorState::Destroy)
+    {
+        mAerialAttackCollider = nullptr;
+    }
+
+    mNevascaEmitter->Clear();
+
+    if (GetCurrentCheckpoint() != nullptr)
+    {
+        RespawnAtCheckpoint();
+    }
+}
+
 void Zoe::OnHorizontalCollision(const float minOverlap, AABBColliderComponent *other)
 {
     if (other->GetLayer() == ColliderLayer::EnemyProjectile)
@@ -803,12 +865,12 @@ void Zoe::AnimationEndCallback(std::string animationName)
 
 bool Zoe::CheckFireballOnCooldown()
 {
-    return mFireballCooldownTimer != nullptr && mTimerComponent->checkTimerRemaining(mFireballCooldownTimer) > 0.f;
+    return mFireballCooldownTimer != NO_TIMER && mTimerComponent->checkTimerRemaining(mFireballCooldownTimer) > 0.f;
 }
 
 float Zoe::GetFireballCooldownProgress()
 {
-    if (mFireballCooldownTimer)
+    if (mFireballCooldownTimer != NO_TIMER)
     {
         float cooldown = mGame->GetConfig()->Get<float>("ZOE.POWERS.FIREBALL.COOLDOWN");
         return mTimerComponent->checkTimerRemaining(mFireballCooldownTimer) / cooldown;
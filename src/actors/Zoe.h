@@ -7,9 +7,9 @@
 #include "../components/collider/AABBColliderComponent.h"
 #include "Tile.h"
 #include "ZoeFireball.h"
-#include "Nevasca.h"
 #include "../core/Game.h"
 #include "../components/draw/DrawAnimatedComponent.h"
+#include "../components/draw/ParticleEmitterComponent.h"
 #include "../ui/DialogueSystem.h"
 #include "../components/TimerComponent.h"
 #include "./Collider.h"
@@ -100,12 +100,14 @@ public:
     void OnFireballReleased();
     void OnNevascaPressed();
     void OnNevascaReleased();
-    void CheckAbilitiesKeys(const std::vector<SDL_Event>& events, SDL_GameController* controller);
+    void CheckAbilitiesKeys(const std::vector<SDL_Event>& events);
 
     void OnHorizontalCollision(const float minOverlap, AABBColliderComponent* other) override;
     void OnVerticalCollision(const float minOverlap, AABBColliderComponent* other) override;
 
     void Kill() override;
+    void OnSnapshotRestored() override;
+    void RespawnAtCheckpoint();
     void ManageState();
     void AnimationEndCallback(std::string animationName);
     
@@ -168,10 +170,11 @@ private:
     void ConsumeMana(float amount);
     void RegenerateMana();
 
-    Timer* mManaRegenTimerHandle;
+    TimerHandle mManaRegenTimerHandle;
 
     class RigidBodyComponent* mRigidBodyComponent;
     class DrawAnimatedComponent* mDrawComponent;
+    class ParticleEmitterComponent* mNevascaEmitter;
     class AABBColliderComponent* mColliderComponent;
     class TimerComponent *mTimerComponent;
 
@@ -182,14 +185,14 @@ private:
     float mAttackChargeCounter;
     bool mIsFiringNevasca;
     float mNevascaTimer;
-    Timer* mDodgeCooldownTimer;
-    Timer* mDashGravityDisableTimer;
+    TimerHandle mDodgeCooldownTimer;
+    TimerHandle mDashGravityDisableTimer;
 
     bool mIsFireballAllowed, mIsDodgeAllowed, mIsVentaniaAllowed, mIsNevascaAllowed;
 
     void FireFireball();
     bool mTryingToFireFireball;
-    Timer* mFireballCooldownTimer;
+    TimerHandle mFireballCooldownTimer;
 
     bool CheckVentania();
     void SetLandedAfterVentania(bool landed) { mLandedAfterVentania = landed; }
@@ -197,7 +200,7 @@ private:
 
     Collider *mAttackCollider, *mAerialAttackCollider;
 
-    Timer *mCoyoteTimer;
+    TimerHandle mCoyoteTimer;
 
     SoundHandle mDamageSoundHandle, mNevascaSoundHandle;
 
@@ -80,7 +80,7 @@ void Zoe::OnNevascaReleased()
     mIsTryingToNevasca = false;
 }
 
-void Zoe::CheckAbilitiesKeys(const std::vector<SDL_Event>& events, SDL_GameController* controller)
+void Zoe::CheckAbilitiesKeys(const std::vector<SDL_Event>& events)
 {
     // these abilities should be reset every frame - to avoid keeping them pressed for trigger
     mIsTryingToJump = false;
@@ -90,7 +90,7 @@ void Zoe::CheckAbilitiesKeys(const std::vector<SDL_Event>& events, SDL_GameContr
     // mTryingToFireFireball = false; - this must be because there is a charging part.
     // mIsTryingToNevasca = false; - isnt per frame!
 
-    if (mAbilitiesLocked || controller == nullptr) return;
+    if (mAbilitiesLocked || !mGame->HasController()) return;
 
     for (const auto &event : events)
     {
@@ -156,7 +156,7 @@ void Zoe::CheckAbilitiesKeys(const std::vector<SDL_Event>& events, SDL_GameContr
 
     if (
         !IsSDLButtonBlocked(Zoe::NEVASCA_BUTTON) && 
-        SDL_GameControllerGetAxis(controller, Zoe::NEVASCA_AXIS) > 0
+        mGame->GetControllerAxis(Zoe::NEVASCA_AXIS) > 0
     )
     {
         OnNevascaPressed();
@@ -238,7 +238,7 @@ bool Zoe::CheckVentania()
 
     SetBehaviorState(BehaviorState::Dashing);
 
-    mDashGravityDisableTimer->Restart();
+    mTimerComponent->Restart(mDashGravityDisableTimer);
     return true;
 }
 
@@ -292,7 +292,7 @@ bool Zoe::CheckDodge()
     if (!mIsTryingToDodge || mBehaviorState == BehaviorState::Dodging)
         return false;
 
-    if (mDodgeCooldownTimer != nullptr && mTimerComponent->checkTimerRemaining(mDodgeCooldownTimer) > 0.f)
+    if (mDodgeCooldownTimer != NO_TIMER && mTimerComponent->checkTimerRemaining(mDodgeCooldownTimer) > 0.f)
     {
         return false;
     }
@@ -319,7 +319,7 @@ void Zoe::DodgeEnd()
 
     float cooldown = mGame->GetConfig()->Get<float>("ZOE.DODGE_COOLDOWN");
     mDodgeCooldownTimer = mTimerComponent->AddTimer(cooldown, [this]
-                                                    { mDodgeCooldownTimer = nullptr; });
+                                                    { mDodgeCooldownTimer = NO_TIMER; });
 
     SetInvincibilityOn();
     mTimerComponent->AddTimer(0.25f, [this]()
@@ -346,7 +346,7 @@ void Zoe::FireFireball()
 
     float cooldown = mGame->GetConfig()->Get<float>("ZOE.POWERS.FIREBALL.COOLDOWN");
     mFireballCooldownTimer = mTimerComponent->AddTimer(cooldown, [this]
-                                                       { mFireballCooldownTimer = nullptr; });
+                                                       { mFireballCooldownTimer = NO_TIMER; });
     mGame->GetAudio()->PlaySound("fireball.wav");
 }
 
@@ -384,6 +384,8 @@ bool Zoe::CheckNevasca()
         Vector2::RotateVec(nevascaDir, dissipationAngle),
         Vector2::RotateVec(nevascaDir, -dissipationAngle)};
 
+    float speed = mGame->GetConfig()->Get<float>("ZOE.POWERS.NEVASCA.SPEED");
+
     while (mNevascaTimer >= rate)
     {
         if (HasMana(mGame->GetConfig()->Get<float>("ZOE.POWERS.NEVASCA.MANA_COST")))
@@ -399,11 +401,8 @@ bool Zoe::CheckNevasca()
 
         for (const Vector2 &dir : dirs)
         {
-            new Nevasca(
-                mGame,
-                GetNevascaOffset(),
-                dir,
-                this);
+            // Fired as an impulse on a 0.1 mass flake
+            mNevascaEmitter->Emit(GetNevascaOffset(), dir * speed * 10.f, Math::RandRangeInt(0, 4));
         }
     }
 
@@ -7,8 +7,16 @@
 #include "../Zoe.h"
 #include "../Actor.h"
 
+static const AnimationId ANIM_ASLEEP = InternAnimation("asleep");
+static const AnimationId ANIM_IDLE = InternAnimation("idle");
+static const AnimationId ANIM_WALK = InternAnimation("walk");
+static const AnimationId ANIM_HIT = InternAnimation("hit");
+static const AnimationId ANIM_DIE = InternAnimation("die");
+static const AnimationId ANIM_ATTACK = InternAnimation("attack");
+static const AnimationId ANIM_FROZEN = InternAnimation("frozen");
+
 Quasar::Quasar(Game *game, const Vector2 &center)
-    : Enemy(game, center, 300.f, 120.f), mAppliedImpulseInAttack(false), mAttackTimerHandle(nullptr),
+    : Enemy(game, center, 300.f, 120.f), mAppliedImpulseInAttack(false), mAttackTimerHandle(NO_TIMER),
     mBlockedPlayerSoundHandle(SoundHandle::Invalid)
 {
     mRigidBodyComponent = new RigidBodyComponent(this, 1.f, 10.0f);
@@ -49,7 +57,7 @@ Quasar::Quasar(Game *game, const Vector2 &center)
     mDrawComponent->AddAnimation("attack", 36, 45);
     mDrawComponent->AddAnimation("frozen", 46, 50, false);
 
-    mDrawComponent->SetAnimation("asleep");
+    mDrawComponent->SetAnimation(ANIM_ASLEEP);
 
     SetBehaviorState(BehaviorState::Asleep);
 
@@ -89,7 +97,7 @@ void Quasar::ManageState()
 
             if (
                 IsPlayerOnSightThisFrame() &&
-                (mAttackTimerHandle == nullptr ||
+                (mAttackTimerHandle == NO_TIMER ||
                  mTimerComponent->checkTimerRemaining(mAttackTimerHandle) <= 0.f)
             )
             {
@@ -105,7 +113,7 @@ void Quasar::ManageState()
                 break;
             }
 
-            if (PlayerOnFov()) mAIMovementComponent->SeekPlayer();
+            if (HasSeenPlayerThisFrame()) mAIMovementComponent->SeekPlayer();
             else mAIMovementComponent->LoosePlayer();
 
             break;
@@ -167,12 +175,12 @@ void Quasar::ManageAnimations()
     switch (mBehaviorState)
     {
         case BehaviorState::Asleep:
-            mDrawComponent->SetAnimation("asleep");
+            mDrawComponent->SetAnimation(ANIM_ASLEEP);
             mDrawComponent->SetAnimFPS(1.f);
             break;
 
         case BehaviorState::Idle:
-            mDrawComponent->SetAnimation("idle");
+            mDrawComponent->SetAnimation(ANIM_IDLE);
             mDrawComponent->SetAnimFPS(5.f);
             break;
 
@@ -183,39 +191,39 @@ void Quasar::ManageAnimations()
 
             if (velocity.LengthSq() <= 0.01f)
             {
-                mDrawComponent->SetAnimation("idle");
+                mDrawComponent->SetAnimation(ANIM_IDLE);
                 mDrawComponent->SetAnimFPS(5.f);
             }
             else
             {
-                mDrawComponent->SetAnimation("walk");
+                mDrawComponent->SetAnimation(ANIM_WALK);
                 mDrawComponent->SetAnimFPS(8.f);
             }
             break;
         }
 
         case BehaviorState::TakingDamage:
-            mDrawComponent->SetAnimation("hit");
+            mDrawComponent->SetAnimation(ANIM_HIT);
             mDrawComponent->SetAnimFPS(6.f);
             break;
 
         case BehaviorState::Dying:
-            mDrawComponent->SetAnimation("die");
+            mDrawComponent->SetAnimation(ANIM_DIE);
             mDrawComponent->SetAnimFPS(14.f);
             break;
 
         case BehaviorState::Attacking:
-            mDrawComponent->SetAnimation("attack");
+            mDrawComponent->SetAnimation(ANIM_ATTACK);
             mDrawComponent->SetAnimFPS(7.f);
             break;
 
         case BehaviorState::Frozen:
-            mDrawComponent->SetAnimation("frozen");
+            mDrawComponent->SetAnimation(ANIM_FROZEN);
             mDrawComponent->SetAnimFPS(6.f);
             break;
 
         default:
-            mDrawComponent->SetAnimation("asleep");
+            mDrawComponent->SetAnimation(ANIM_ASLEEP);
             break;
     }
 }
@@ -21,6 +21,6 @@ public:
 
 private:
     bool mAppliedImpulseInAttack, mIsCloseAttack;
-    Timer* mAttackTimerHandle;
+    TimerHandle mAttackTimerHandle;
     SoundHandle mBlockedPlayerSoundHandle;
 };
\ No newline at end of file
@@ -7,6 +7,14 @@
 #include "../Zoe.h"
 #include "../Actor.h"
 
+static const AnimationId ANIM_MOVING = InternAnimation("moving");
+static const AnimationId ANIM_CHARGING = InternAnimation("charging");
+static const AnimationId ANIM_ATTACK = InternAnimation("attack");
+static const AnimationId ANIM_ATTACK2 = InternAnimation("attack2");
+static const AnimationId ANIM_DEATH = InternAnimation("death");
+static const AnimationId ANIM_DAMAGE = InternAnimation("damage");
+static const AnimationId ANIM_FREEZE = InternAnimation("freeze");
+
 Sith::Sith(Game *game, const Vector2 &position)
     : Enemy(game, position, 800.f, 200.f),
       mIsProjectileOnCooldown(false), mIsAttack1OnCooldown(false), mIsAttack2OnCooldown(false),
@@ -52,7 +60,7 @@ Sith::Sith(Game *game, const Vector2 &position)
     mDrawComponent->AddAnimation("charging", 27, 32);
     mDrawComponent->AddAnimation("freeze", 33, 37, false);
 
-    mDrawComponent->SetAnimation("moving");
+    mDrawComponent->SetAnimation(ANIM_MOVING);
 
     SetBehaviorState(BehaviorState::Moving);
     SetPosition(position);
@@ -188,7 +196,7 @@ void Sith::ManageState()
     }
 
     case BehaviorState::Charging:
-        if (!PlayerOnSight())
+        if (!IsPlayerOnSightThisFrame())
             SetBehaviorState(BehaviorState::Moving);
         break;
     case BehaviorState::TakingDamage:
@@ -244,17 +252,17 @@ void Sith::ManageAnimations()
     switch (mBehaviorState)
     {
     case BehaviorState::Moving:
-        mDrawComponent->SetAnimation("moving");
+        mDrawComponent->SetAnimation(ANIM_MOVING);
         mDrawComponent->SetAnimFPS(10.f);
         break;
     case BehaviorState::Charging:
-        mDrawComponent->SetAnimation("charging");
+        mDrawComponent->SetAnimation(ANIM_CHARGING);
         mDrawComponent->SetAnimFPS(8.f);
         break;
     case BehaviorState::Attacking:
         if (mCurrentAttack == Attacks::Attack1)
         {
-            mDrawComponent->SetAnimation("attack");
+            mDrawComponent->SetAnimation(ANIM_ATTACK);
 
             if (mDrawComponent->GetCurrentSprite() <= 2)
                 mDrawComponent->SetAnimFPS(7.f);
@@ -263,7 +271,7 @@ void Sith::ManageAnimations()
         }
         else if (mCurrentAttack == Attacks::Attack2)
         {
-            mDrawComponent->SetAnimation("attack2");
+            mDrawComponent->SetAnimation(ANIM_ATTACK2);
 
             if (mDrawComponent->GetCurrentSprite() <= 4)
                 mDrawComponent->SetAnimFPS(7.f);
@@ -272,19 +280,19 @@ void Sith::ManageAnimations()
         }
         break;
     case BehaviorState::Dying:
-        mDrawComponent->SetAnimation("death");
+        mDrawComponent->SetAnimation(ANIM_DEATH);
         mDrawComponent->SetAnimFPS(5.f);
         break;
     case BehaviorState::TakingDamage:
-        mDrawComponent->SetAnimation("damage");
+        mDrawComponent->SetAnimation(ANIM_DAMAGE);
         mDrawComponent->SetAnimFPS(9.f);
         break;
     case BehaviorState::Frozen:
-        mDrawComponent->SetAnimation("freeze");
+        mDrawComponent->SetAnimation(ANIM_FREEZE);
         mDrawComponent->SetAnimFPS(6.f);
         break;
     default:
-        mDrawComponent->SetAnimation("moving");
+        mDrawComponent->SetAnimation(ANIM_MOVING);
         break;
     }
 }
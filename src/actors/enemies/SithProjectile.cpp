@@ -7,6 +7,9 @@
 #include "../Zoe.h"
 #include "../Actor.h"
 
+static const AnimationId ANIM_FLYING = InternAnimation("flying");
+static const AnimationId ANIM_DYING = InternAnimation("dying");
+
 SithProjectile::SithProjectile(
     class Game *game, Vector2 position,
     Vector2 direction, Actor *sith
@@ -48,7 +51,7 @@ SithProjectile::SithProjectile(
     mDrawAnimatedComponent->AddAnimation("flying", 0, 2);
     mDrawAnimatedComponent->AddAnimation("dying", 3, 7);
 
-    mDrawAnimatedComponent->SetAnimation("flying");
+    mDrawAnimatedComponent->SetAnimation(ANIM_FLYING);
     SetBehaviorState(BehaviorState::Moving);
 
     SetPosition(position - GetHalfSize());
@@ -68,10 +71,10 @@ void SithProjectile::ManageAnimations()
 {
     if (mBehaviorState == BehaviorState::Dying)
     {
-        mDrawAnimatedComponent->SetAnimation("dying");
+        mDrawAnimatedComponent->SetAnimation(ANIM_DYING);
     }
     else if (mBehaviorState == BehaviorState::Moving)
     {
-        mDrawAnimatedComponent->SetAnimation("flying");
+        mDrawAnimatedComponent->SetAnimation(ANIM_FLYING);
     }
 }
\ No newline at end of file
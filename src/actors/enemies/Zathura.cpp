@@ -7,12 +7,24 @@
 #include "../Zoe.h"
 #include "../Actor.h"
 
+static const AnimationId ANIM_APPEAR = InternAnimation("appear");
+static const AnimationId ANIM_IDLE = InternAnimation("idle");
+static const AnimationId ANIM_WALK = InternAnimation("walk");
+static const AnimationId ANIM_HIT = InternAnimation("hit");
+static const AnimationId ANIM_DIE = InternAnimation("die");
+static const AnimationId ANIM_ATTACK1 = InternAnimation("attack1");
+static const AnimationId ANIM_ATTACK2 = InternAnimation("attack2");
+static const AnimationId ANIM_ATTACK3 = InternAnimation("attack3");
+static const AnimationId ANIM_VANISH = InternAnimation("vanish");
+static const AnimationId ANIM_FROZEN = InternAnimation("frozen");
+static const AnimationId ANIM_ASLEEP = InternAnimation("asleep");
+
 Zathura::Zathura(Game *game, const Vector2 &center)
     : Enemy(game, center, 300.f), mCurrentAttack(ZathuraAttacks::None),
     mBlockedPlayerSoundHandle(SoundHandle::Invalid),
-    mRockAttackTimerHandle(nullptr), mIsWaitingToThrowRocks(false),
-    mAttack1CooldownTimer(nullptr), mAttack2CooldownTimer(nullptr), 
-    mAttack3CooldownTimer(nullptr), mSpawnedAttackCollider(false),
+    mRockAttackTimerHandle(NO_TIMER), mIsWaitingToThrowRocks(false),
+    mAttack1CooldownTimer(NO_TIMER), mAttack2CooldownTimer(NO_TIMER), 
+    mAttack3CooldownTimer(NO_TIMER), mSpawnedAttackCollider(false),
     mPreDeathCutscenePlayed(false)
 {
     mRigidBodyComponent = new RigidBodyComponent(this, 1.f, 10.0f);
@@ -57,7 +69,7 @@ Zathura::Zathura(Game *game, const Vector2 &center)
     mDrawComponent->AddAnimation("appear", {63,62,61,60,59}, false);
 
     SetBehaviorState(BehaviorState::Appearing);
-    mDrawComponent->SetAnimation("appear");
+    mDrawComponent->SetAnimation(ANIM_APPEAR);
 
     SetPosition(center - GetHalfSize());
 
@@ -100,7 +112,7 @@ void Zathura::ManageState()
                 break;
 
             if (
-                (mRockAttackTimerHandle == nullptr ||
+                (mRockAttackTimerHandle == NO_TIMER ||
                  mTimerComponent->checkTimerRemaining(mRockAttackTimerHandle) <= 0.f)
             )
             {
@@ -109,7 +121,7 @@ void Zathura::ManageState()
                 break;
             }
             
-            if (PlayerOnFov()) mAIMovementComponent->SeekPlayer();
+            if (HasSeenPlayerThisFrame()) mAIMovementComponent->SeekPlayer();
             else mAIMovementComponent->LoosePlayer();
 
             if (!IsPlayerOnSightThisFrame())
@@ -117,7 +129,7 @@ void Zathura::ManageState()
 
             if (
                 GetDistanceToPlayerSquared() <= 10000 &&
-                (mAttack1CooldownTimer == nullptr ||
+                (mAttack1CooldownTimer == NO_TIMER ||
                  mTimerComponent->checkTimerRemaining(mAttack1CooldownTimer) <= 0.f)
             )
             {
@@ -133,7 +145,7 @@ void Zathura::ManageState()
 
             if (
                 GetDistanceToPlayerSquared() <= 12100 &&
-                (mAttack2CooldownTimer == nullptr ||
+                (mAttack2CooldownTimer == NO_TIMER ||
                  mTimerComponent->checkTimerRemaining(mAttack2CooldownTimer) <= 0.f)
             )
             {
@@ -149,7 +161,7 @@ void Zathura::ManageState()
 
             if (
                 GetDistanceToPlayerSquared() <= 8100 &&
-                (mAttack3CooldownTimer == nullptr ||
+                (mAttack3CooldownTimer == NO_TIMER ||
                  mTimerComponent->checkTimerRemaining(mAttack3CooldownTimer) <= 0.f)
             )
             {
@@ -354,22 +366,22 @@ void Zathura::ManageAnimations()
     switch (mBehaviorState)
     {
         case BehaviorState::Idle:
-            mDrawComponent->SetAnimation("idle");
+            mDrawComponent->SetAnimation(ANIM_IDLE);
             mDrawComponent->SetAnimFPS(5.f);
             break;
 
         case BehaviorState::Moving:
-            mDrawComponent->SetAnimation("walk");
+            mDrawComponent->SetAnimation(ANIM_WALK);
             mDrawComponent->SetAnimFPS(8.f);
             break;
 
         case BehaviorState::TakingDamage:
-            mDrawComponent->SetAnimation("hit");
+            mDrawComponent->SetAnimation(ANIM_HIT);
             mDrawComponent->SetAnimFPS(5.f);
             break;
 
         case BehaviorState::Dying:
-            mDrawComponent->SetAnimation("die");
+            mDrawComponent->SetAnimation(ANIM_DIE);
             
             if (mPreDeathCutscenePlayed)
             {
@@ -386,15 +398,15 @@ void Zathura::ManageAnimations()
             switch (mCurrentAttack)
             {
                 case ZathuraAttacks::Attack1:
-                    mDrawComponent->SetAnimation("attack1");
+                    mDrawComponent->SetAnimation(ANIM_ATTACK1);
                     mDrawComponent->SetAnimFPS(7.f);
                     break;
                 case ZathuraAttacks::Attack2:
-                    mDrawComponent->SetAnimation("attack2");
+                    mDrawComponent->SetAnimation(ANIM_ATTACK2);
                     mDrawComponent->SetAnimFPS(7.f);
                     break;
                 case ZathuraAttacks::Attack3:
-                    mDrawComponent->SetAnimation("attack3");
+                    mDrawComponent->SetAnimation(ANIM_ATTACK3);
                     mDrawComponent->SetAnimFPS(7.f);
                     break;
                 case ZathuraAttacks::Rocks:
@@ -408,22 +420,22 @@ void Zathura::ManageAnimations()
         }
 
         case BehaviorState::Vanishing:
-            mDrawComponent->SetAnimation("vanish");
+            mDrawComponent->SetAnimation(ANIM_VANISH);
             mDrawComponent->SetAnimFPS(7.f);
             break;
 
         case BehaviorState::Appearing:
-            mDrawComponent->SetAnimation("appear");
+            mDrawComponent->SetAnimation(ANIM_APPEAR);
             mDrawComponent->SetAnimFPS(7.f);
             break;
 
         case BehaviorState::Frozen:
-            mDrawComponent->SetAnimation("frozen");
+            mDrawComponent->SetAnimation(ANIM_FROZEN);
             mDrawComponent->SetAnimFPS(6.f);
             break;
 
         default:
-            mDrawComponent->SetAnimation("asleep");
+            mDrawComponent->SetAnimation(ANIM_ASLEEP);
             break;
     }
 }
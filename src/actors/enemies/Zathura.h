@@ -40,7 +40,7 @@ protected:
 private:
     ZathuraAttacks mCurrentAttack;
     SoundHandle mBlockedPlayerSoundHandle;
-    Timer* mRockAttackTimerHandle, *mAttack1CooldownTimer, *mAttack2CooldownTimer, *mAttack3CooldownTimer;
+    TimerHandle mRockAttackTimerHandle, mAttack1CooldownTimer, mAttack2CooldownTimer, mAttack3CooldownTimer;
 
     bool mIsWaitingToThrowRocks, mSpawnedAttackCollider, mPreDeathCutscenePlayed;
 };
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "../Zoe.h"
 #include "../Actor.h"
 
+static const AnimationId ANIM_JOINING = InternAnimation("joining");
+static const AnimationId ANIM_FLYING = InternAnimation("flying");
+
 void Rock::SpawnRocks(Game *game, class Zathura* zathura)
 {
     zathura->SetIsWaitingToThrowRocks(true);
@@ -86,7 +89,7 @@ Rock::Rock(
 
     mDrawAnimatedComponent->AddAnimation("joining", 0, 13, false);
     mDrawAnimatedComponent->AddAnimation("flying", {13});
-    mDrawAnimatedComponent->SetAnimation("joining");
+    mDrawAnimatedComponent->SetAnimation(ANIM_JOINING);
     
     SetBehaviorState(BehaviorState::Idle);
 
@@ -100,12 +103,12 @@ void Rock::ManageAnimations()
     switch (mBehaviorState)
     {
         case BehaviorState::Moving:
-            mDrawAnimatedComponent->SetAnimation("flying");
+            mDrawAnimatedComponent->SetAnimation(ANIM_FLYING);
             mDrawAnimatedComponent->SetAnimFPS(1.f);
             break;
 
         case BehaviorState::Idle:
-            mDrawAnimatedComponent->SetAnimation("joining");
+            mDrawAnimatedComponent->SetAnimation(ANIM_JOINING);
             mDrawAnimatedComponent->SetAnimFPS(8.f);
             break;
     }
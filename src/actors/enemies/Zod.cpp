@@ -6,6 +6,15 @@
 #include "../Actor.h"
 #include "ZodProjectile.h"
 
+static const AnimationId ANIM_ASLEEP = InternAnimation("asleep");
+static const AnimationId ANIM_WAKING = InternAnimation("waking");
+static const AnimationId ANIM_IDLE = InternAnimation("idle");
+static const AnimationId ANIM_MOVING = InternAnimation("moving");
+static const AnimationId ANIM_CHARGING = InternAnimation("charging");
+static const AnimationId ANIM_DAMAGE = InternAnimation("damage");
+static const AnimationId ANIM_DYING = InternAnimation("dying");
+static const AnimationId ANIM_FREEZE = InternAnimation("freeze");
+
 Zod::Zod(Game* game, const Vector2& position)
     : Enemy(game, position, 400.f, 80.f), mProjectileOnCooldown(false)
 {
@@ -48,7 +57,7 @@ Zod::Zod(Game* game, const Vector2& position)
     mDrawComponent->AddAnimation("dying", 20, 25);
     mDrawComponent->AddAnimation("freeze", 26, 30, false);
 
-    mDrawComponent->SetAnimation("asleep");
+    mDrawComponent->SetAnimation(ANIM_ASLEEP);
 
     SetBehaviorState(BehaviorState::Asleep);
     SetPosition(position);
@@ -103,7 +112,7 @@ void Zod::ManageState()
             break;
         }
 
-        if (PlayerOnFov()) mAIMovementComponent->SeekPlayer();
+        if (HasSeenPlayerThisFrame()) mAIMovementComponent->SeekPlayer();
         else mAIMovementComponent->LoosePlayer();
         
         break;
@@ -171,14 +180,14 @@ void Zod::ManageAnimations()
     switch (mBehaviorState)
     {
     case BehaviorState::Asleep:
-        mDrawComponent->SetAnimation("asleep");
+        mDrawComponent->SetAnimation(ANIM_ASLEEP);
         break;
     case BehaviorState::Waking:
-        mDrawComponent->SetAnimation("waking");
+        mDrawComponent->SetAnimation(ANIM_WAKING);
         mDrawComponent->SetAnimFPS(4.5f);
         break;
     case BehaviorState::Idle:
-        mDrawComponent->SetAnimation("idle");
+        mDrawComponent->SetAnimation(ANIM_IDLE);
         break;
     case BehaviorState::Moving: {
         RigidBodyComponent* rb = GetComponent<RigidBodyComponent>();
@@ -187,34 +196,34 @@ void Zod::ManageAnimations()
 
         if (velocity.LengthSq() <= 0.01f)
         {
-            mDrawComponent->SetAnimation("idle");
+            mDrawComponent->SetAnimation(ANIM_IDLE);
             mDrawComponent->SetAnimFPS(5.f);
         }
         else
         {
-            mDrawComponent->SetAnimation("moving");
+            mDrawComponent->SetAnimation(ANIM_MOVING);
             mDrawComponent->SetAnimFPS(8.f);
         }
         break;
     }
     case BehaviorState::Charging:
-        mDrawComponent->SetAnimation("charging");
+        mDrawComponent->SetAnimation(ANIM_CHARGING);
         mDrawComponent->SetAnimFPS(8.f);
         break;
     case BehaviorState::TakingDamage:
-        mDrawComponent->SetAnimation("damage");
+        mDrawComponent->SetAnimation(ANIM_DAMAGE);
         mDrawComponent->SetAnimFPS(5.f);
         break;
     case BehaviorState::Dying:
-        mDrawComponent->SetAnimation("dying");
+        mDrawComponent->SetAnimation(ANIM_DYING);
         mDrawComponent->SetAnimFPS(9.f);
         break;
     case BehaviorState::Frozen:
-        mDrawComponent->SetAnimation("freeze");
+        mDrawComponent->SetAnimation(ANIM_FREEZE);
         mDrawComponent->SetAnimFPS(6.f);
         break;
     default:
-        mDrawComponent->SetAnimation("asleep");
+        mDrawComponent->SetAnimation(ANIM_ASLEEP);
         break;
     }
 }
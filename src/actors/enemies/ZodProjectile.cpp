@@ -6,6 +6,8 @@
 #include "../Zoe.h"
 #include "../Actor.h"
 
+static const AnimationId ANIM_FLYING = InternAnimation("flying");
+
 ZodProjectile::ZodProjectile(
     Game* game, Vector2 position, Vector2 target, float speed, Actor* zod
 ): Projectile(game, position, zod)
@@ -45,7 +47,7 @@ ZodProjectile::ZodProjectile(
         static_cast<int>(DrawLayerPosition::Player) - 10);
 
     mDrawAnimatedComponent->AddAnimation("flying", 0, 3);
-    mDrawAnimatedComponent->SetAnimation("flying");
+    mDrawAnimatedComponent->SetAnimation(ANIM_FLYING);
     
     SetBehaviorState(BehaviorState::Moving);
 
@@ -59,7 +61,7 @@ void ZodProjectile::ManageAnimations()
 {
     if (mBehaviorState == BehaviorState::Moving)
     {
-        mDrawAnimatedComponent->SetAnimation("flying");
+        mDrawAnimatedComponent->SetAnimation(ANIM_FLYING);
     }
 }
 
@@ -0,0 +1,46 @@
+#include "ProjectileEmitter.h"
+#include "../enemies/ZodProjectile.h"
+
+static const AnimationId ANIM_CHARGING = InternAnimation("charging");
+
+ProjectileEmitter::ProjectileEmitter(Game *game, const Vector2 &position, float cooldown)
+    : Actor(game, 1), mFireTimer(NO_TIMER), mDirection(1.f)
+{
+    mTimerComponent = new TimerComponent(this);
+
+    // Same box as Zod, its projectiles ignore the layer
+    mColliderComponent = new AABBColliderComponent(
+        this,
+        17, 8,
+        10, 20,
+        ColliderLayer::Enemy);
+
+    mDrawComponent = new DrawAnimatedComponent(
+        this,
+        "../assets/Sprites/Enemies/Zod/texture.png",
+        "../assets/Sprites/Enemies/Zod/texture.json",
+        nullptr,
+        static_cast<int>(DrawLayerPosition::BelowPlayer));
+
+    mDrawComponent->AddAnimation("charging", 16, 19);
+    mDrawComponent->SetAnimation(ANIM_CHARGING);
+    mDrawComponent->SetAnimFPS(8.f);
+
+    mFireTimer = mTimerComponent->AddNotRemovableTimer(cooldown, [this]() {
+        Fire();
+        mTimerComponent->Restart(mFireTimer);
+    });
+
+    SetPosition(position);
+    SetBehaviorState(BehaviorState::Idle);
+}
+
+void ProjectileEmitter::Fire()
+{
+    float speed = mGame->GetConfig()->Get<float>("ZOD.PROJECTILE_SPEED");
+    Vector2 origin = mColliderComponent->GetCenter();
+
+    new ZodProjectile(mGame, origin, origin + Vector2(mDirection, 0.f), speed, this);
+
+    mDirection = -mDirection;
+}
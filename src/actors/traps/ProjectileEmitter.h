@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SDL.h>
+#include "../Actor.h"
+#include "../../components/TimerComponent.h"
+#include "../../components/collider/AABBColliderComponent.h"
+#include "../../components/draw/DrawAnimatedComponent.h"
+
+// A charging Zod that never moves and fires a projectile every cooldown, alternating
+// left and right. Only the stress test scene spawns it
+class ProjectileEmitter : public Actor
+{
+public:
+    ProjectileEmitter(Game* game, const Vector2& position, float cooldown);
+
+private:
+    void Fire();
+
+    TimerComponent *mTimerComponent;
+    AABBColliderComponent *mColliderComponent;
+    DrawAnimatedComponent *mDrawComponent;
+
+    TimerHandle mFireTimer;
+    float mDirection;
+};
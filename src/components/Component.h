@@ -19,6 +19,11 @@ public:
     virtual ~Component();
     // Reinsert this component by delta time
     virtual void Update(float deltaTime);
+    // Reduced update of actors near but off camera, only components that keep the
+    // actor consistent (physics, timers) do anything
+    virtual void CoarseUpdate(float deltaTime) {}
+    // True for the components overriding CoarseUpdate, actors without any stay out of the band
+    virtual bool HasCoarseUpdate() const { return false; }
     // Process input for this component (if needed)
     virtual void ProcessInput(const Uint8* keyState);
     // Handle key press for this component (if needed)
@@ -5,105 +5,146 @@
 #include <SDL.h>
 #include "../actors/Actor.h"
 #include "../core/Game.h"
+#include "../core/Profiler.h"
+#include "../core/PhysicsWorld.h"
 #include "RigidBodyComponent.h"
 #include "collider/AABBColliderComponent.h"
 
-const float MAX_SPEED_X = 750.0f;
-const float MAX_SPEED_Y = 750.0f;
-
 RigidBodyComponent::RigidBodyComponent(class Actor* owner, float mass, float friction, bool applyGravity, int updateOrder)
         :Component(owner, updateOrder)
-        ,mMass(mass)
-        ,mApplyGravity(applyGravity)
-        ,mApplyFriction(true)
-        ,mFrictionCoefficient(friction)
-        ,mVelocity(Vector2::Zero)
-        ,mAcceleration(Vector2::Zero)
-        ,mIsOnGround(false)
-        ,mGravityScale(1.0f)
+        ,mWorld(owner->GetGame()->GetPhysicsWorld())
+        ,mBody(-1)
 {
-    if (mMass <= 0.f) {
+    if (mass <= 0.f) {
         throw std::invalid_argument("Mass must be greater than zero");
     }
+
+    mBody = mWorld->AddBody(this, mass, friction, applyGravity);
 }
 
-void RigidBodyComponent::ApplyFriction() {        
-    float friction = mFrictionCoefficient;
+RigidBodyComponent::~RigidBodyComponent()
+{
+    mWorld->RemoveBody(mBody);
+}
 
-    if (mOwner->GetIsSlidingOnSnow()) {
-        friction *= 0.35f; // Reduce friction when sliding on snow
-    }
+Vector2 RigidBodyComponent::GetVelocity() const {
+    return Vector2(mWorld->mVelocityX[mBody], mWorld->mVelocityY[mBody]);
+}
 
-    if (mOwner->GetGame()->GetApplyGravityScene() && mApplyGravity) {
-        ApplyForce(Vector2(mVelocity.x, 0.f) * -friction);
-    } else {
-        ApplyForce(mVelocity * -friction);
-    }
+void RigidBodyComponent::ResetVelocity() {
+    mWorld->mVelocityX[mBody] = 0.f;
+    mWorld->mVelocityY[mBody] = 0.f;
+}
+
+void RigidBodyComponent::ResetVelocityX() { mWorld->mVelocityX[mBody] = 0.f; }
+void RigidBodyComponent::ResetVelocityY() { mWorld->mVelocityY[mBody] = 0.f; }
+
+void RigidBodyComponent::SetVelocity(const Vector2& velocity) {
+    mWorld->mVelocityX[mBody] = velocity.x;
+    mWorld->mVelocityY[mBody] = velocity.y;
+}
+
+Vector2 RigidBodyComponent::GetAcceleration() const {
+    return Vector2(mWorld->mAccelerationX[mBody], mWorld->mAccelerationY[mBody]);
+}
+
+void RigidBodyComponent::ResetAcceleration() {
+    mWorld->mAccelerationX[mBody] = 0.f;
+    mWorld->mAccelerationY[mBody] = 0.f;
+}
+
+void RigidBodyComponent::SetApplyGravity(const bool applyGravity) { mWorld->mApplyGravity[mBody] = applyGravity; }
+void RigidBodyComponent::SetApplyFriction(const bool applyFriction) { mWorld->mApplyFriction[mBody] = applyFriction; }
+
+bool RigidBodyComponent::GetApplyGravity() const { return mWorld->mApplyGravity[mBody]; }
+bool RigidBodyComponent::GetOnGround() { return mWorld->mIsOnGround[mBody]; }
+
+Vector2 RigidBodyComponent::GetAppliedForce() const {
+    return GetAcceleration() * mWorld->mMass[mBody];
+}
+
+void RigidBodyComponent::SetGravityScale(float scale) {
+    if (scale < 0.f) scale = 0.f;
+    if (scale > 1.f) scale = 1.f;
+
+    mWorld->mGravityScale[mBody] = scale;
 }
 
 // Force changes acceleration
-// Continues application over time
+// Continues application over time, consumed when the world integrates the body
 void RigidBodyComponent::ApplyForce(const Vector2 &force) {
-    mAcceleration += force * (1.f/mMass);
+    mWorld->mAccelerationX[mBody] += force.x * mWorld->mInverseMass[mBody];
+    mWorld->mAccelerationY[mBody] += force.y * mWorld->mInverseMass[mBody];
 }
 
 // Impulse changes velocity directly
 // Should be applied in a single frame
 void RigidBodyComponent::ApplyImpulse(const Vector2 &impulse) {
-    mVelocity += impulse * (1.f/mMass);
+    mWorld->mVelocityX[mBody] += impulse.x * mWorld->mInverseMass[mBody];
+    mWorld->mVelocityY[mBody] += impulse.y * mWorld->mInverseMass[mBody];
 }
 
 void RigidBodyComponent::Update(float deltaTime)
 {
+    PROFILE_ZONE("RigidBodyComponent");
+
     if (mOwner->GetGame()->GetPhysicsFrozen()) {
-        mAcceleration = Vector2::Zero;
+        ResetAcceleration();
         return;
     }
 
-    bool sceneAppliesGravity = mOwner->GetGame()->GetApplyGravityScene();
-    bool applyGravity = mApplyGravity && sceneAppliesGravity;
-    
-    if (applyGravity) ApplyForce(Vector2(0.f, GRAVITY * mGravityScale));
-
-    if (mApplyFriction && mIsOnGround) ApplyFriction();
-
-    // Euler Integration
-    mVelocity += mAcceleration * deltaTime;
-
-    mVelocity.x = Math::Clamp<float>(mVelocity.x, -MAX_SPEED_X, MAX_SPEED_X);
-    mVelocity.y = Math::Clamp<float>(mVelocity.y, -MAX_SPEED_Y, MAX_SPEED_Y);
-
-    if (Math::NearZero(mVelocity.x, .01f)) {
-        mVelocity.x = 0.f;
+    // Bodies outside this frame's batch (spawned during it, coarse updates) integrate alone
+    if (!mWorld->WasIntegrated(mBody)) {
+        mWorld->IntegrateBody(mBody, deltaTime);
     }
 
-    if (Math::NearZero(mVelocity.y, .01f)) {
-        mVelocity.y = 0.f;
-    }
+    bool applyGravity = mWorld->mApplyGravity[mBody] && mOwner->GetGame()->GetApplyGravityScene();
 
     auto collider = mOwner->GetComponent<AABBColliderComponent>();
 
-    mOwner->SetPosition(Vector2(mOwner->GetPosition().x + mVelocity.x * deltaTime,
+    // Fast bodies are swept so they can't step over a tile
+    float moveX = mWorld->mVelocityX[mBody] * deltaTime;
+    if (collider) {
+        moveX = collider->SweepHorizontal(moveX);
+    }
+
+    mOwner->SetPosition(Vector2(mOwner->GetPosition().x + moveX,
                                 mOwner->GetPosition().y));
 
     if (collider) {
         collider->DetectHorizontalCollision(this);
     }
 
+    // Horizontal collisions may have changed the velocity
+    float moveY = mWorld->mVelocityY[mBody] * deltaTime;
+    if (collider) {
+        moveY = collider->SweepVertical(moveY);
+    }
+
     mOwner->SetPosition(Vector2(mOwner->GetPosition().x,
-                                mOwner->GetPosition().y + mVelocity.y * deltaTime));
+                                mOwner->GetPosition().y + moveY));
 
     if (collider) {
         float t = collider->DetectVerticalCollision(this);
-        mIsOnGround = applyGravity ? (t > 0.0f) : true;
+        mWorld->mIsOnGround[mBody] = applyGravity ? (t > 0.0f) : true;
     }
+}
 
-    mAcceleration = Vector2::Zero;
+void RigidBodyComponent::CoarseUpdate(float deltaTime)
+{
+    // A coarse update covers several frames, split so bodies don't tunnel through tiles
+    const float maxStep = 1.f / 30.f;
+    while (deltaTime > 0.f)
+    {
+        float step = Math::Min(deltaTime, maxStep);
+        Update(step);
+        deltaTime -= step;
+    }
 }
 
 float RigidBodyComponent::GetJumpImpulseY(float totalBlocks) {
     const float height = totalBlocks * Game::TILE_SIZE;
     const float v0 = std::sqrt(2.0f * GRAVITY * height);
 
-    return -mMass * v0;
+    return -mWorld->mMass[mBody] * v0;
 }
\ No newline at end of file
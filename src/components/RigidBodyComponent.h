@@ -14,61 +14,51 @@ public:
     // Lower update order to update first
     RigidBodyComponent(class Actor* owner, float mass = 1.0f, float friction = 0.0f,
                         bool applyGravity = true, int updateOrder = 10);
+    ~RigidBodyComponent() override;
 
+    // Velocities are integrated by the PhysicsWorld, this moves the owner and collides
     void Update(float deltaTime) override;
+    void CoarseUpdate(float deltaTime) override;
+    bool HasCoarseUpdate() const override { return true; }
 
-    const Vector2& GetVelocity() const { return mVelocity; }
-    void ResetVelocity() { mVelocity = Vector2(0,0); }
-    void ResetVelocityX() { mVelocity.x = 0; }
-    void ResetVelocityY() { mVelocity.y = 0; }
+    Vector2 GetVelocity() const;
+    void ResetVelocity();
+    void ResetVelocityX();
+    void ResetVelocityY();
 
-    const Vector2& GetAcceleration() const { return mAcceleration; }
-    void ResetAcceleration() { mAcceleration = Vector2(0,0); }
+    Vector2 GetAcceleration() const;
+    void ResetAcceleration();
 
-    void SetApplyGravity(const bool applyGravity) { mApplyGravity = applyGravity; }
-    void SetApplyFriction(const bool applyFriction) { mApplyFriction = applyFriction;  }
+    void SetApplyGravity(const bool applyGravity);
+    void SetApplyFriction(const bool applyFriction);
 
     void ApplyForce(const Vector2 &force);
     void ApplyImpulse(const Vector2 &impulse);
 
-    bool GetOnGround() { return mIsOnGround; }
+    bool GetOnGround();
 
     float GetJumpImpulseY(float totalBlocks);
 
     int SpeedHDir() {
-        if (mVelocity.x == 0) return 0;
-        if (mVelocity.x > 0) return 1;
+        float velocityX = GetVelocity().x;
+        if (velocityX == 0) return 0;
+        if (velocityX > 0) return 1;
         return -1;
     }
 
-    bool GetApplyGravity() const { return mApplyGravity; }
-    Vector2 GetAppliedForce() const { return mAcceleration * mMass; }
+    bool GetApplyGravity() const;
+    Vector2 GetAppliedForce() const;
 
-    void SetGravityScale(float scale) { 
-        if (scale < 0.f) scale = 0.f;
-        if (scale > 1.f) scale = 1.f;
-        
-        mGravityScale = scale; 
-    }
+    void SetGravityScale(float scale);
 
 protected:
     friend class AIMovementComponent;
+    friend class SceneSnapshot;
     // this is a really delicate method, be careful when using it.
     // it was created for the ENEMIES AI for fliers.
-    void SetVelocity(const Vector2& velocity) { mVelocity = velocity; }
+    void SetVelocity(const Vector2& velocity);
 
 private:
-    bool mApplyGravity;
-    bool mApplyFriction;
-
-    // Physical properties
-    float mFrictionCoefficient;
-    float mMass;
-    bool mIsOnGround;
-    float mGravityScale;
-
-    Vector2 mVelocity;
-    Vector2 mAcceleration;
-
-    void ApplyFriction();
+    class PhysicsWorld* mWorld;
+    int mBody; // slot in mWorld
 };
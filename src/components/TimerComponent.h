@@ -1,7 +1,10 @@
 #pragma once
 #include <vector>
+#include <algorithm>
 #include <functional>
 #include "./Component.h"
+#include "../core/Profiler.h"
+#include "../core/EngineStats.h"
 
 class Timer {
 public:
@@ -16,6 +19,11 @@ public:
     void Restart() { elapsed = 0.f; }
 };
 
+// Timers are referred to by id: a snapshot restore deletes and re-creates timers, so their
+// addresses can't be kept. A handle whose timer is gone has no time remaining
+using TimerHandle = int;
+const TimerHandle NO_TIMER = -1;
+
 class TimerComponent : public Component
 {
 private:
@@ -24,7 +32,13 @@ private:
 public:
     TimerComponent(class Actor* owner) : Component(owner) {}
     
+    // Timers keep running off camera, any delta time is fine
+    void CoarseUpdate(float deltaTime) override { Update(deltaTime); }
+    bool HasCoarseUpdate() const override { return true; }
+
     void Update(float deltaTime) override {
+        PROFILE_ZONE("TimerComponent");
+        ENGINE_STAT(Stat::TimersTicked, static_cast<int>(mTimers.size()));
         Component::Update(deltaTime);
         
         for (size_t i = 0; i < mTimers.size(); ++i) {
@@ -46,7 +60,7 @@ public:
         }
     }
 
-    Timer* AddTimer(float duration, std::function<void()> callback) {
+    TimerHandle AddTimer(float duration, std::function<void()> callback) {
         struct Timer* newTimer = new Timer(
             nextTimerId,
             duration,
@@ -58,11 +72,11 @@ public:
 
         mTimers.push_back(newTimer);
 
-        return newTimer;
+        return newTimer->id;
     }
 
     // take care to avoid memory overloads with this timer
-    Timer *AddNotRemovableTimer(float duration, std::function<void()> callback) {
+    TimerHandle AddNotRemovableTimer(float duration, std::function<void()> callback) {
         struct Timer* newTimer = new Timer(
             nextTimerId,
             duration,
@@ -74,27 +88,57 @@ public:
 
         mTimers.push_back(newTimer);
 
-        return newTimer;
+        return newTimer->id;
     }
 
-    float checkTimerRemaining(Timer* timer) {
+    float checkTimerRemaining(TimerHandle timer) {
         for (const auto& t : mTimers) {
-            if (t->id == timer->id) {
+            if (t->id == timer) {
                 return t->duration - t->elapsed;
             }
         }
         return 0.f;
     }
 
-    void Restart(Timer *timer) {
+    void Restart(TimerHandle timer) {
         for (const auto& t : mTimers) {
-            if (t->id == timer->id) {
+            if (t->id == timer) {
                 t->elapsed = 0.f;
                 return;
             }
         }
     }
 
+    // Copies, callbacks included, for scene snapshots
+    void SaveTimers(std::vector<Timer> &timers) const {
+        timers.reserve(mTimers.size());
+        for (const auto &t : mTimers) {
+            timers.push_back(*t);
+        }
+    }
+
+    // Ids are kept, so handles find their timer again if it was in the snapshot
+    void RestoreTimers(const std::vector<Timer> &timers) {
+        std::vector<Timer*> restored;
+        restored.reserve(timers.size());
+
+        for (const auto &saved : timers) {
+            auto it = std::find_if(mTimers.begin(), mTimers.end(), [&saved](Timer *t) { return t->id == saved.id; });
+            if (it != mTimers.end()) {
+                **it = saved;
+                restored.push_back(*it);
+                mTimers.erase(it);
+            } else {
+                restored.push_back(new Timer(saved));
+            }
+        }
+
+        for (auto t : mTimers) {
+            delete t;
+        }
+        mTimers.swap(restored);
+    }
+
 protected:
     std::vector<Timer*> mTimers;
 };
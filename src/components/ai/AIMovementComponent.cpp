@@ -3,6 +3,7 @@
 #include "../../actors/Zoe.h"
 #include "../../core/Game.h"
 #include "../../core/SpatialHashing.h"
+#include "../../core/Profiler.h"
 #include "../../actors/Enemy.h"
 
 const float MAX_CRAZINESS = 1.f;
@@ -14,8 +15,8 @@ AIMovementComponent::AIMovementComponent(
     : Component(owner), mMovementState(MovementState::Wandering),
       mPreviousMovementState(MovementState::Wandering), mInteligence(0.0f),
       mCraziness(craziness), mSpeed(fowardSpeed), mTypeOfMovement(typeOfMovement),
-      mOwnerEnemy(nullptr), mCrazyDecisionTimer(nullptr),
-      mBlockChangeForceTimer(nullptr), mSpeedFlipped(false), mObstaclesAroundCenters()
+      mOwnerEnemy(nullptr), mCrazyDecisionTimer(NO_TIMER),
+      mBlockChangeForceTimer(NO_TIMER), mSpeedFlipped(false), mObstaclesAroundCenters(), mHasSensed(false)
 {
     if (mOwner->GetComponent<RigidBodyComponent>() == nullptr)
     {
@@ -43,15 +44,17 @@ void AIMovementComponent::PopulateObstaclesAround()
 
     if (!rigidBody) return;
 
-    std::vector<ColliderLayer> obstacleColliders = {
+    // Only traps, most cells around hold nothing but tiles
+    const ColliderLayerMask obstacleLayers = LayerMask({
         ColliderLayer::Spikes, ColliderLayer::SpikesBlock,
         ColliderLayer::SpearBlock, ColliderLayer::SpearTip,
         ColliderLayer::Shuriken
-    };
+    });
 
     std::vector<AABBColliderComponent *> closeColliders = mOwner->GetGame()->GetNearbyColliders(
         mOwner->GetCenter(),
-        3);
+        3,
+        obstacleLayers);
 
     mObstaclesAroundCenters.clear();
 
@@ -59,15 +62,6 @@ void AIMovementComponent::PopulateObstaclesAround()
 
     for (const auto &collider : closeColliders)
     {
-        if (
-            std::find(
-                obstacleColliders.begin(),
-                obstacleColliders.end(),
-                collider->GetLayer()) == obstacleColliders.end())
-        {
-            continue;
-        }
-
         if (collider->IsCollidingRect(threatRect))
         {
             mObstaclesAroundCenters.push_back(collider->GetCenter());
@@ -75,9 +69,10 @@ void AIMovementComponent::PopulateObstaclesAround()
     }
 }
 
-void AIMovementComponent::Sense(float deltaTime)
+void AIMovementComponent::Sense()
 {
     PopulateObstaclesAround();
+    mHasSensed = true;
 }
 
 void AIMovementComponent::Plan(float deltaTime)
@@ -239,7 +234,7 @@ bool AIMovementComponent::CrazyDecision()
     float randomValue = Math::RandRange(MIN_CRAZINESS, MAX_CRAZINESS);
     bool crazy = (randomValue <= mCraziness);
 
-    if (crazy) mCrazyDecisionTimer->Restart();
+    if (crazy) mOwnerTimerComponent->Restart(mCrazyDecisionTimer);
 
     return crazy;
 }
@@ -256,17 +251,27 @@ bool AIMovementComponent::CrazyDecision(float modifier)
         return false;
     }
 
-    mCrazyDecisionTimer->Restart();
+    mOwnerTimerComponent->Restart(mCrazyDecisionTimer);
     float randomValue = Math::RandRange(MIN_CRAZINESS, MAX_CRAZINESS);
     return (randomValue <= (mCraziness * modifier));
 }
 
 void AIMovementComponent::Update(float deltaTime)
 {
+    PROFILE_ZONE("AIMovementComponent");
+
+    // A sense is only good for the update of its frame, even when that one doesn't move
+    bool hasSensed = mHasSensed;
+    mHasSensed = false;
+
     if (mOwner->GetBehaviorState() != BehaviorState::Moving)
         return;
 
-    Sense(deltaTime);
+    if (!hasSensed)
+    {
+        Sense();
+    }
+
     Plan(deltaTime);
     Act(deltaTime);
 }
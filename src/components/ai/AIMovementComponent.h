@@ -56,8 +56,12 @@ public:
 
     bool IsDangerousToMoveAround() const { return mObstaclesAroundCenters.size() > 0; }
 
+    // Read-only, called by Enemy::Sense during the parallel sense phase
+    void Sense();
+    // The next update senses again instead of using the last Sense
+    void ClearSense() { mHasSensed = false; }
+
 private:
-    void Sense(float deltaTime);
     void Plan(float deltaTime);
     void Act(float deltaTime);
     void Update(float deltaTime) override;
@@ -68,6 +72,7 @@ private:
     float mInteligence, mCraziness, mSpeed;
     bool mSpeedFlipped;
     class Enemy* mOwnerEnemy;
-    Timer *mCrazyDecisionTimer, *mBlockChangeForceTimer;
+    TimerHandle mCrazyDecisionTimer, mBlockChangeForceTimer;
     std::vector<Vector2> mObstaclesAroundCenters;
+    bool mHasSensed;
 };
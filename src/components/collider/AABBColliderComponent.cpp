@@ -5,6 +5,9 @@
 #include "AABBColliderComponent.h"
 #include "../../actors/Actor.h"
 #include "../../core/Game.h"
+#include "../../core/SpatialHashing.h"
+#include "../../core/Profiler.h"
+#include "../../core/EngineStats.h"
 #include <algorithm>
 
 AABBColliderComponent::AABBColliderComponent(class Actor *owner, int dx, int dy, int w, int h,
@@ -12,6 +15,7 @@ AABBColliderComponent::AABBColliderComponent(class Actor *owner, int dx, int dy,
     : Component(owner, updateOrder), mOffset(Vector2((float)dx, (float)dy)),
       mWidth(w), mHeight(h), mLayer(layer), mIsTangible(isTangible)
 {
+    owner->GetGame()->GetSpatialHashing()->UpdateCollider(owner);
 }
 
 AABBColliderComponent::~AABBColliderComponent()
@@ -35,6 +39,8 @@ Vector2 AABBColliderComponent::GetCenter() const
 
 bool AABBColliderComponent::Intersect(const AABBColliderComponent &b) const
 {
+    ENGINE_STAT(Stat::AABBTests, 1);
+
     return (GetMin().x < b.GetMax().x && GetMax().x > b.GetMin().x &&
             GetMin().y < b.GetMax().y && GetMax().y > b.GetMin().y);
 }
@@ -60,12 +66,18 @@ void AABBColliderComponent::CallHorizontalCollisionCallbacks(const float overlap
     if (thisColliderIgnoreOption != IgnoreOption::IgnoreCallback &&
         thisColliderIgnoreOption != IgnoreOption::Both
     )
+    {
+        ENGINE_STAT(Stat::CollisionCallbacks, 1);
         mOwner->OnHorizontalCollision(overlap, other);
+    }
 
     if (otherColliderIgnoreOption != IgnoreOption::IgnoreCallback &&
         otherColliderIgnoreOption != IgnoreOption::Both
     )
+    {
+        ENGINE_STAT(Stat::CollisionCallbacks, 1);
         other->GetOwner()->OnHorizontalCollision(-overlap, this);
+    }
 }
 
 void AABBColliderComponent::CallVerticalCollisionCallbacks(const float overlap, class AABBColliderComponent *other, IgnoreOption thisColliderIgnoreOption, IgnoreOption otherColliderIgnoreOption)
@@ -73,22 +85,30 @@ void AABBColliderComponent::CallVerticalCollisionCallbacks(const float overlap,
     if (thisColliderIgnoreOption != IgnoreOption::IgnoreCallback &&
         thisColliderIgnoreOption != IgnoreOption::Both
     )
+    {
+        ENGINE_STAT(Stat::CollisionCallbacks, 1);
         mOwner->OnVerticalCollision(overlap, other);
+    }
 
     if (otherColliderIgnoreOption != IgnoreOption::IgnoreCallback &&
         otherColliderIgnoreOption != IgnoreOption::Both
     )
+    {
+        ENGINE_STAT(Stat::CollisionCallbacks, 1);
         other->GetOwner()->OnVerticalCollision(-overlap, this);
+    }
 }
 
 float AABBColliderComponent::DetectHorizontalCollision(RigidBodyComponent *rigidBody)
 {
+    PROFILE_ZONE("DetectHorizontalCollision");
+
     if (!mIsEnabled)
         return false;
 
     // Use spatial hashing to get nearby colliders
     int radius = static_cast<int>(mWidth / Game::TILE_SIZE) + 1;
-    auto colliders = mOwner->GetGame()->GetNearbyColliders(GetCenter(), radius);
+    auto colliders = mOwner->GetGame()->GetNearbyColliders(GetCenter(), radius, ~LayerMask(mLayer));
 
     std::sort(colliders.begin(), colliders.end(), [this](AABBColliderComponent *a, AABBColliderComponent *b)
               { return Math::Abs((a->GetCenter() - GetCenter()).LengthSq() < (b->GetCenter() - GetCenter()).LengthSq()); });
@@ -139,12 +159,14 @@ float AABBColliderComponent::DetectHorizontalCollision(RigidBodyComponent *rigid
 
 float AABBColliderComponent::DetectVerticalCollision(RigidBodyComponent *rigidBody)
 {
+    PROFILE_ZONE("DetectVerticalCollision");
+
     if (!mIsEnabled)
         return false;
 
     // Use spatial hashing to get nearby colliders
     int radius = static_cast<int>(mHeight / Game::TILE_SIZE) + 2;
-    auto colliders = mOwner->GetGame()->GetNearbyColliders(GetCenter(), radius);
+    auto colliders = mOwner->GetGame()->GetNearbyColliders(GetCenter(), radius, ~LayerMask(mLayer));
 
     std::sort(colliders.begin(), colliders.end(), [this](AABBColliderComponent *a, AABBColliderComponent *b)
               { return Math::Abs((a->GetCenter() - GetCenter()).LengthSq() < (b->GetCenter() - GetCenter()).LengthSq()); });
@@ -193,6 +215,91 @@ float AABBColliderComponent::DetectVerticalCollision(RigidBodyComponent *rigidBo
     return 0.0f;
 }
 
+float AABBColliderComponent::SweepHorizontal(float displacement)
+{
+    return Sweep(displacement, true);
+}
+
+float AABBColliderComponent::SweepVertical(float displacement)
+{
+    return Sweep(displacement, false);
+}
+
+float AABBColliderComponent::Sweep(float displacement, bool horizontal)
+{
+    // Slow moves can't skip anything, the discrete detection is enough
+    float extent = static_cast<float>(horizontal ? mWidth : mHeight);
+    if (!mIsEnabled || Math::Abs(displacement) <= Math::Min(extent, static_cast<float>(Game::TILE_SIZE)) * 0.5f)
+        return displacement;
+
+    PROFILE_ZONE("SweepCollision");
+
+    Vector2 min = GetMin();
+    Vector2 max = GetMax();
+
+    // Broadphase: every cell the box passes through
+    Vector2 halfMove = horizontal ? Vector2(displacement * 0.5f, 0.f) : Vector2(0.f, displacement * 0.5f);
+    int radius = static_cast<int>((Math::Abs(displacement) + std::max(mWidth, mHeight)) / Game::TILE_SIZE) + 2;
+    auto colliders = mOwner->GetGame()->GetNearbyColliders(GetCenter() + halfMove, radius);
+
+    // Earliest time of impact along the axis, as a fraction of the displacement
+    float earliest = 1.f;
+    for (auto collider : colliders)
+    {
+        if (!BlocksMovement(collider))
+            continue;
+
+        ENGINE_STAT(Stat::AABBTests, 1);
+
+        Vector2 otherMin = collider->GetMin();
+        Vector2 otherMax = collider->GetMax();
+
+        // Must overlap on the other axis to be in the way
+        bool inLane = horizontal ? (min.y < otherMax.y && max.y > otherMin.y)
+                                 : (min.x < otherMax.x && max.x > otherMin.x);
+        if (!inLane)
+            continue;
+
+        // Only colliders ahead, the ones overlapping already are the Detect functions' job
+        float gap;
+        if (displacement > 0.f)
+            gap = horizontal ? otherMin.x - max.x : otherMin.y - max.y;
+        else
+            gap = horizontal ? otherMax.x - min.x : otherMax.y - min.y;
+
+        float time = gap / displacement;
+        if (time >= 0.f && time < earliest)
+        {
+            earliest = time;
+        }
+    }
+
+    if (earliest >= 1.f)
+        return displacement;
+
+    // Just inside the blocker, so the detection sees the overlap
+    constexpr float penetration = 0.01f;
+    float allowed = displacement * earliest + (displacement > 0.f ? penetration : -penetration);
+    return Math::Abs(allowed) < Math::Abs(displacement) ? allowed : displacement;
+}
+
+bool AABBColliderComponent::BlocksMovement(const AABBColliderComponent *other) const
+{
+    // Same filters as the Detect functions, for the colliders that get resolved
+    if (!other->IsEnabled() || other->GetLayer() == mLayer)
+        return false;
+
+    if (!other->IsTangible() || !mIsTangible)
+        return false;
+
+    if (other->CheckLayerIgnored(mLayer) == IgnoreOption::Both)
+        return false;
+
+    IgnoreOption thisColliderIgnoreOption = CheckLayerIgnored(other->GetLayer());
+    return thisColliderIgnoreOption != IgnoreOption::Both &&
+           thisColliderIgnoreOption != IgnoreOption::IgnoreResolution;
+}
+
 void AABBColliderComponent::ResolveHorizontalCollisions(RigidBodyComponent *rigidBody, const float minXOverlap)
 {
     constexpr float epsilon = 0.001f; // Small separation buffer
@@ -376,8 +483,8 @@ int AABBColliderComponent::IsCloseToTileWallHorizontally(float distance)
     Vector2 center = GetCenter();
     Vector2 size = Vector2((float)mWidth, (float)mHeight);
 
-    // Use spatial hashing to get nearby colliders
-    auto colliders = mOwner->GetGame()->GetNearbyColliders(center, 2);
+    // Only walls count, cells without tiles are skipped
+    auto colliders = mOwner->GetGame()->GetNearbyColliders(center, 2, LayerMask(ColliderLayer::Blocks));
 
     std::sort(colliders.begin(), colliders.end(), [this](AABBColliderComponent *a, AABBColliderComponent *b)
               { return Math::Abs((a->GetCenter() - GetCenter()).LengthSq() < (b->GetCenter() - GetCenter()).LengthSq()); });
@@ -416,8 +523,8 @@ int AABBColliderComponent::IsCloseToTileWallVertically(float distance)
     Vector2 center = GetCenter();
     Vector2 size = Vector2((float)mWidth, (float)mHeight);
 
-    // Use spatial hashing to get nearby colliders
-    auto colliders = mOwner->GetGame()->GetNearbyColliders(center, 2);
+    // Only walls count, cells without tiles are skipped
+    auto colliders = mOwner->GetGame()->GetNearbyColliders(center, 2, LayerMask(ColliderLayer::Blocks));
 
     std::sort(colliders.begin(), colliders.end(), [this](AABBColliderComponent *a, AABBColliderComponent *b)
               { return Math::Abs((a->GetCenter() - GetCenter()).LengthSq() < (b->GetCenter() - GetCenter()).LengthSq()); });
@@ -472,7 +579,7 @@ bool AABBColliderComponent::IsSegmentIntersectingPlayerLayer(const Vector2 &star
         float t = (float)i / (float)totalPoints;
         Vector2 point = Vector2::Lerp(start, end, t);
 
-        auto colliders = mOwner->GetGame()->GetNearbyColliders(point, 0);
+        auto colliders = mOwner->GetGame()->GetNearbyColliders(point, 0, ~LayerMask(GetLayer()));
 
         for (auto &collider : colliders)
         {
@@ -9,6 +9,8 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <cstdint>
+#include <initializer_list>
 #include <SDL.h>
 
 enum class ColliderLayer
@@ -45,6 +47,26 @@ enum class ColliderLayer
     ZathuraAttack3
 };
 
+// One bit per layer, for spatial queries that only want some layers
+using ColliderLayerMask = uint32_t;
+const ColliderLayerMask ALL_COLLIDER_LAYERS = ~ColliderLayerMask(0);
+static_assert(static_cast<int>(ColliderLayer::ZathuraAttack3) < 32, "ColliderLayerMask needs a bit per layer");
+
+inline ColliderLayerMask LayerMask(ColliderLayer layer)
+{
+    return ColliderLayerMask(1) << static_cast<int>(layer);
+}
+
+inline ColliderLayerMask LayerMask(std::initializer_list<ColliderLayer> layers)
+{
+    ColliderLayerMask mask = 0;
+    for (ColliderLayer layer : layers)
+    {
+        mask |= LayerMask(layer);
+    }
+    return mask;
+}
+
 enum class IgnoreOption
 {
     None, // this is for internal AABBColliderComponent use only
@@ -66,6 +88,13 @@ public:
     float DetectHorizontalCollision(RigidBodyComponent *rigidBody);
     float DetectVerticalCollision(RigidBodyComponent *rigidBody);
 
+    // Swept test for fast bodies: how much of the displacement along one axis the collider
+    // can move before it reaches something that would stop it. A move over half the collider
+    // could skip a thin tile, so it stops just inside the first blocker and the Detect
+    // functions then resolve it and run the callbacks as usual
+    float SweepHorizontal(float displacement);
+    float SweepVertical(float displacement);
+
     bool IsOnCamera();
 
     Vector2 GetMin() const;
@@ -102,6 +131,9 @@ public:
     int IsCloseToTileWallVertically(float distance);
 
 private:
+    float Sweep(float displacement, bool horizontal);
+    bool BlocksMovement(const AABBColliderComponent* other) const;
+
     float GetMinVerticalOverlap(AABBColliderComponent* b) const;
     float GetMinHorizontalOverlap(AABBColliderComponent* b) const;
 
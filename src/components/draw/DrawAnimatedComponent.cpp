@@ -2,8 +2,8 @@
 #include "DrawAnimatedComponent.h"
 #include "../../actors/Actor.h"
 #include "../../core/Game.h"
-#include "../../libs/Json.h"
-#include <fstream>
+#include "../../core/Profiler.h"
+#include "../../core/EngineStats.h"
 
 DrawAnimatedComponent::DrawAnimatedComponent(
     class Actor *owner, 
@@ -12,68 +12,42 @@ DrawAnimatedComponent::DrawAnimatedComponent(
     std::function<void(std::string animationName)> animationEndCallback,
     int drawOrder): 
     DrawComponent(owner, drawOrder), 
+    mSpriteSheet(nullptr), mClipTable(nullptr), mClip(nullptr), mAnimId(-1),
     mSpriteSheetTexture(nullptr), mAnimTimer(0.0f), mAnimFPS(10.0f), 
-    mIsPaused(false), mAnimName(""), mAnimationEndCallback(animationEndCallback),
+    mIsPaused(false), mAnimationEndCallback(animationEndCallback),
     mScaleFactor(1.0f), mPivot(0.5f, 0.5f), mUsePivotForRotation(false)
 {
-    LoadSpriteSheet(spriteSheetPath, spriteSheetData);
+    mSpriteSheet = mOwner->GetGame()->LoadSpriteSheet(spriteSheetPath, spriteSheetData);
+    mSpriteSheetTexture = mSpriteSheet->GetTexture();
 }
 
-DrawAnimatedComponent::~DrawAnimatedComponent()
+void DrawAnimatedComponent::CompileClipTable()
 {
-    DrawComponent::~DrawComponent();
+    mClipTable = mSpriteSheet->GetClipTable(mPendingClips);
+    mPendingClips.clear();
 
-    for (const auto &rect : mSpriteSheetData)
+    // The new table holds the current clip too, if it was defined
+    if (mAnimId >= 0)
     {
-        delete rect;
+        mClip = mClipTable->Find(mAnimId);
     }
-    mSpriteSheetData.clear();
 }
 
-void DrawAnimatedComponent::LoadSpriteSheet(const std::string &texturePath, const std::string &dataPath)
+void DrawAnimatedComponent::Draw(SDL_Renderer *renderer, const Vector3 &modColor)
 {
-    // Load sprite sheet texture
-    mSpriteSheetTexture = mOwner->GetGame()->LoadTexture(texturePath);
-
-    // Load sprite sheet data
-    std::ifstream spriteSheetFile(dataPath);
-    nlohmann::json spriteSheetData = nlohmann::json::parse(spriteSheetFile);
-
-    std::vector<std::pair<std::string, SDL_Rect*>> rects;
-    rects.reserve(spriteSheetData["frames"].size());
-
-    for (const auto &frame : spriteSheetData["frames"])
-    {
-        int x = frame["frame"]["x"].get<int>();
-        int y = frame["frame"]["y"].get<int>();
-        int w = frame["frame"]["w"].get<int>();
-        int h = frame["frame"]["h"].get<int>();
-        std::string fileName = frame["filename"].get<std::string>();
-
-        SDL_Rect *r = new SDL_Rect{ x, y, w, h };
-        rects.emplace_back(fileName, r);
+    CompileClips();
+    if (!mClip) {
+        return;
     }
 
-    // Move sorted rect pointers into mSpriteSheetData
-    mSpriteSheetData.reserve(rects.size());
-    for (auto &p : rects)
-    {
-        mSpriteSheetData.emplace_back(p.second);
-    }
-}
-
-void DrawAnimatedComponent::Draw(SDL_Renderer *renderer, const Vector3 &modColor)
-{
-    int spriteIdx = mAnimations[mAnimName].frames[static_cast<int>(mAnimTimer)];
-    SDL_Rect *srcRect = mSpriteSheetData[spriteIdx];
+    int spriteIdx = mClip->frames[static_cast<int>(mAnimTimer)];
+    const SDL_Rect *srcRect = &mSpriteSheet->GetFrames()[spriteIdx];
 
     SDL_Rect dstRect = {
         static_cast<int>(mOwner->GetPosition().x - mOwner->GetGame()->GetCameraPos().x + mOffset.x),
         static_cast<int>(mOwner->GetPosition().y - mOwner->GetGame()->GetCameraPos().y + mOffset.y),
         srcRect->w * mScaleFactor,
         srcRect->h * mScaleFactor};
-    
-    std::string ownerType = this->mOwner->GetType();
 
     // Calculate pivot point
     SDL_Point pivotPoint;
@@ -86,6 +60,8 @@ void DrawAnimatedComponent::Draw(SDL_Renderer *renderer, const Vector3 &modColor
                            static_cast<Uint8>(modColor.y),
                            static_cast<Uint8>(modColor.z));
 
+    ENGINE_STAT_DRAW(mSpriteSheetTexture);
+
     // Use pivot point for rotation only if enabled
     if (mUsePivotForRotation)
     {
@@ -106,39 +82,74 @@ void DrawAnimatedComponent::Draw(SDL_Renderer *renderer, const Vector3 &modColor
 
 void DrawAnimatedComponent::Update(float deltaTime)
 {
+    PROFILE_ZONE("DrawAnimatedComponent");
+
     if (mIsPaused) {
         return;
     }
 
+    CompileClips();
+    if (!mClip) {
+        return;
+    }
+
     mAnimTimer += mAnimFPS * deltaTime;
 
-    if (mAnimTimer >= mAnimations[mAnimName].frames.size()) {
-        if (mAnimationEndCallback) mAnimationEndCallback(mAnimName);
+    if (mAnimTimer >= mClip->numFrames) {
+        if (mAnimationEndCallback) mAnimationEndCallback(GetAnimationName(mAnimId));
 
-        if (mAnimations[mAnimName].isLoop) {
+        // The callback may have set another animation
+        if (mClip->isLoop) {
             mAnimTimer = 0.0f;
         }
         else {
             // block in last frame
-            mAnimTimer = static_cast<float>(mAnimations[mAnimName].frames.size() - 1);
+            mAnimTimer = static_cast<float>(mClip->numFrames - 1);
         }
     }
 }
 
-void DrawAnimatedComponent::SetAnimation(const std::string &name)
+void DrawAnimatedComponent::SetAnimation(AnimationId id)
 {
-    if (mAnimName == name) {
+    if (mAnimId == id) {
+        return;
+    }
+
+    CompileClips();
+
+    const AnimationClip *clip = mClipTable ? mClipTable->Find(id) : nullptr;
+    if (!clip) {
+        // Keep drawing (and reporting) the previous clip rather than indexing a missing one
+        SDL_Log("Animation %s is not defined for %s", GetAnimationName(id).c_str(), mOwner->GetType().c_str());
         return;
     }
 
     mAnimTimer = 0.0f;
-    mAnimName = name;
+    mAnimId = id;
+    mClip = clip;
     Update(0.0f);
 }
 
+void DrawAnimatedComponent::SetAnimation(const std::string &name)
+{
+    SetAnimation(InternAnimation(name));
+}
+
 void DrawAnimatedComponent::AddAnimation(const std::string &name, const std::vector<int> &spriteNums, bool isLoop)
 {
-    mAnimations.emplace(name, std::move(Animation(spriteNums, isLoop)));
+    // Tables are shared and immutable, so later additions recompile from a copy
+    if (mPendingClips.empty() && mClipTable) {
+        mClipTable->GetDefinitions(mPendingClips);
+    }
+
+    AnimationId id = InternAnimation(name);
+    for (const auto &definition : mPendingClips) {
+        if (definition.id == id) {
+            return;
+        }
+    }
+
+    mPendingClips.push_back({id, spriteNums, isLoop});
 }
 
 void DrawAnimatedComponent::AddAnimation(const std::string &name, int begin, int end, bool isLoop)
@@ -147,6 +158,5 @@ void DrawAnimatedComponent::AddAnimation(const std::string &name, int begin, int
     for (int i = begin; i <= end; ++i) {
         spriteNums.emplace_back(i);
     }
-    mAnimations.emplace(name, std::move(Animation(spriteNums, isLoop)));
+    AddAnimation(name, spriteNums, isLoop);
 }
-
@@ -6,6 +6,7 @@
 #include <functional>
 #include <utility>
 #include "DrawComponent.h"
+#include "../../core/SpriteSheet.h"
 
 class Animation {
 public:
@@ -25,7 +26,6 @@ public:
         const std::string &spriteSheetData,
         std::function<void(std::string animationName)> animationEndCallback = nullptr,
         int drawOrder = 100);
-    ~DrawAnimatedComponent() override;
 
     void Draw(SDL_Renderer* renderer, const Vector3 &modColor = Color::White) override;
     void Update(float deltaTime) override;
@@ -33,8 +33,11 @@ public:
     // Use to change the FPS of the animation
     void SetAnimFPS(float fps) { mAnimFPS = fps; }
 
-    // Set the current active animation
+    // Set the current active animation. Prefer the id overload for calls made every
+    // frame, the name one interns the name first
+    void SetAnimation(AnimationId id);
     void SetAnimation(const std::string& name);
+    AnimationId GetAnimation() const { return mAnimId; }
 
     // Use to pause/unpause the animation
     void SetIsPaused(bool pause) { mIsPaused = pause; }
@@ -57,36 +60,36 @@ public:
     bool GetUsePivotForRotation() const { return mUsePivotForRotation; }
 
     int GetSpriteWidth() const {
-        if (mSpriteSheetData.empty()) return 0;
-        return mSpriteSheetData[0]->w * mScaleFactor;
+        if (mSpriteSheet->GetFrames().empty()) return 0;
+        return mSpriteSheet->GetFrames()[0].w * mScaleFactor;
     };
 
     int GetSpriteHeight() const {
-        if (mSpriteSheetData.empty()) return 0;
-        return mSpriteSheetData[0]->h * mScaleFactor;
+        if (mSpriteSheet->GetFrames().empty()) return 0;
+        return mSpriteSheet->GetFrames()[0].h * mScaleFactor;
     };
 
     Vector2 GetSpriteSize() const {
-        if (mSpriteSheetData.empty()) return Vector2::Zero;
+        if (mSpriteSheet->GetFrames().empty()) return Vector2::Zero;
         return Vector2(
-            static_cast<float>(mSpriteSheetData[0]->w * mScaleFactor),
-            static_cast<float>(mSpriteSheetData[0]->h * mScaleFactor)
+            static_cast<float>(mSpriteSheet->GetFrames()[0].w * mScaleFactor),
+            static_cast<float>(mSpriteSheet->GetFrames()[0].h * mScaleFactor)
         );
     };
 
     Vector2 GetHalfSpriteSize() const {
-        if (mSpriteSheetData.empty()) return Vector2::Zero;
+        if (mSpriteSheet->GetFrames().empty()) return Vector2::Zero;
         return Vector2(
-            static_cast<float>(mSpriteSheetData[0]->w * 0.5f * mScaleFactor),
-            static_cast<float>(mSpriteSheetData[0]->h * 0.5f * mScaleFactor)
+            static_cast<float>(mSpriteSheet->GetFrames()[0].w * 0.5f * mScaleFactor),
+            static_cast<float>(mSpriteSheet->GetFrames()[0].h * 0.5f * mScaleFactor)
         );
     };
 
     // ZERO INDEXED
     int GetCurrentSprite() {
-        if (mAnimName.empty()) return -1;
-        int firstFrame = mAnimations[mAnimName].frames[0];
-        return mAnimations[mAnimName].frames[static_cast<int>(mAnimTimer)] - firstFrame;
+        CompileClips();
+        if (!mClip) return -1;
+        return mClip->frames[static_cast<int>(mAnimTimer)] - mClip->frames[0];
     }
 
     void SetAnimationEndCallback(std::function<void(std::string animationName)> callback) {
@@ -94,10 +97,12 @@ public:
     }
 
 private:
-    std::vector<SDL_Rect*> mSpriteSheetData;
-    std::unordered_map<std::string, class Animation> mAnimations;
+    class SpriteSheet* mSpriteSheet; // shared, owned by Game
+    const AnimationClipTable* mClipTable; // shared, owned by mSpriteSheet
+    std::vector<AnimationDefinition> mPendingClips; // added since mClipTable was compiled
+    const AnimationClip* mClip; // null until an animation of the table is set
+    AnimationId mAnimId;
     std::function<void(std::string animationName)> mAnimationEndCallback;
-    std::string mAnimName;
     SDL_Texture* mSpriteSheetTexture;
     float mAnimTimer;
     float mAnimFPS;
@@ -106,5 +111,9 @@ private:
     Vector2 mPivot;
     bool mUsePivotForRotation;
 
-    void LoadSpriteSheet(const std::string& texturePath, const std::string& dataPath);
+    // Builds (or finds) the table of the clips added so far, when some are pending
+    void CompileClips() {
+        if (!mPendingClips.empty()) CompileClipTable();
+    }
+    void CompileClipTable();
 };
@@ -5,6 +5,7 @@
 #include "DrawSpriteComponent.h"
 #include "../../actors/Actor.h"
 #include "../../core/Game.h"
+#include "../../core/EngineStats.h"
 
 DrawSpriteComponent::DrawSpriteComponent(
     class Actor* owner, 
@@ -55,5 +56,6 @@ void DrawSpriteComponent::Draw(SDL_Renderer *renderer, const Vector3 &modColor)
     double rotationDeg = Math::ToDegrees(mOwner->GetRotation());
 
     SDL_RendererFlip flip = mFlip ? SDL_FLIP_VERTICAL  : SDL_FLIP_NONE;
+    ENGINE_STAT_DRAW(mSpriteSheetSurface);
     SDL_RenderCopyEx(renderer, mSpriteSheetSurface, &srcrect, &dstrect, rotationDeg, &center, flip);
 }
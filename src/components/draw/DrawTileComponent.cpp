@@ -1,6 +1,7 @@
 #include "./DrawTileComponent.h"
 #include "../../actors/Actor.h"
 #include "../../core/Game.h"
+#include "../../core/EngineStats.h"
 
 DrawTileComponent::DrawTileComponent(
     class Actor *owner,
@@ -41,5 +42,6 @@ void DrawTileComponent::Draw(SDL_Renderer *renderer, const Vector3 &modColor)
         mHeight
     };
 
+    ENGINE_STAT_DRAW(mTilesetSurface);
     SDL_RenderCopyEx(renderer, mTilesetSurface, &srcrect, &dstrect, 0.0f, nullptr, SDL_FLIP_NONE);
 }
\ No newline at end of file
@@ -0,0 +1,355 @@
+#include "ParticleEmitterComponent.h"
+#include "../../actors/Actor.h"
+#include "../../actors/Tile.h"
+#include "../../core/Game.h"
+#include "../../core/SpatialHashing.h"
+#include "../../core/SpriteSheet.h"
+#include "../../core/Profiler.h"
+#include "../../core/EngineStats.h"
+
+ParticleEmitterComponent::ParticleEmitterComponent(Actor *owner, const std::string &texturePath, const std::string &dataPath,
+                                                   int capacity, int drawOrder)
+    : DrawComponent(owner, drawOrder), mSpriteSheet(nullptr), mTextureWidth(1), mTextureHeight(1),
+      mCapacity(capacity), mNumParticles(0), mLifetime(1.f), mGravity(0.f), mMaxSpeed(750.f),
+      mGroundFriction(0.f), mCollision(ParticleCollision::None), mBoxOffset(Vector2::Zero),
+      mBoxSize(Vector2::Zero), mHitLayer(ColliderLayer::Nevasca)
+{
+    mSpriteSheet = mOwner->GetGame()->LoadSpriteSheet(texturePath, dataPath);
+    if (mSpriteSheet->GetTexture())
+    {
+        SDL_QueryTexture(mSpriteSheet->GetTexture(), nullptr, nullptr, &mTextureWidth, &mTextureHeight);
+    }
+
+    mPositionX.resize(capacity);
+    mPositionY.resize(capacity);
+    mVelocityX.resize(capacity);
+    mVelocityY.resize(capacity);
+    mAge.resize(capacity);
+    mFrame.resize(capacity);
+    mIsOnGround.resize(capacity);
+
+    mVertices.reserve(capacity * 4);
+    mIndices.reserve(capacity * 6);
+}
+
+void ParticleEmitterComponent::SetCollision(ParticleCollision collision, const Vector2 &boxOffset, const Vector2 &boxSize)
+{
+    mCollision = collision;
+    mBoxOffset = boxOffset;
+    mBoxSize = boxSize;
+}
+
+bool ParticleEmitterComponent::Emit(const Vector2 &position, const Vector2 &velocity, int frame)
+{
+    const auto &frames = mSpriteSheet->GetFrames();
+    if (mNumParticles == mCapacity || frames.empty())
+    {
+        return false;
+    }
+
+    frame = Math::Clamp(frame, 0, static_cast<int>(frames.size()) - 1);
+
+    int particle = mNumParticles++;
+    mPositionX[particle] = position.x - frames[frame].w * 0.5f;
+    mPositionY[particle] = position.y - frames[frame].h * 0.5f;
+    mVelocityX[particle] = velocity.x;
+    mVelocityY[particle] = velocity.y;
+    mAge[particle] = 0.f;
+    mFrame[particle] = frame;
+    mIsOnGround[particle] = false;
+    return true;
+}
+
+void ParticleEmitterComponent::Kill(int particle)
+{
+    // The last one takes its place, so the alive particles stay packed
+    int last = --mNumParticles;
+    mPositionX[particle] = mPositionX[last];
+    mPositionY[particle] = mPositionY[last];
+    mVelocityX[particle] = mVelocityX[last];
+    mVelocityY[particle] = mVelocityY[last];
+    mAge[particle] = mAge[last];
+    mFrame[particle] = mFrame[last];
+    mIsOnGround[particle] = mIsOnGround[last];
+}
+
+void ParticleEmitterComponent::Update(float deltaTime)
+{
+    PROFILE_ZONE("ParticleEmitterComponent");
+
+    if (mNumParticles == 0)
+        return;
+
+    Game *game = mOwner->GetGame();
+    bool isFrozen = game->GetPhysicsFrozen();
+    bool sceneAppliesGravity = game->GetApplyGravityScene();
+
+    mHits.clear();
+
+    for (int i = 0; i < mNumParticles;)
+    {
+        mAge[i] += deltaTime;
+        if (mAge[i] >= mLifetime)
+        {
+            Kill(i);
+            continue;
+        }
+
+        if (isFrozen)
+        {
+            i++;
+            continue;
+        }
+
+        // Without gravity particles always drag, on both axes
+        float accelerationX = 0.f;
+        float accelerationY = sceneAppliesGravity ? mGravity : 0.f;
+        if (!sceneAppliesGravity || mIsOnGround[i])
+        {
+            accelerationX -= mGroundFriction * mVelocityX[i];
+            if (!sceneAppliesGravity)
+            {
+                accelerationY -= mGroundFriction * mVelocityY[i];
+            }
+        }
+
+        float velocityX = Math::Clamp(mVelocityX[i] + accelerationX * deltaTime, -mMaxSpeed, mMaxSpeed);
+        float velocityY = Math::Clamp(mVelocityY[i] + accelerationY * deltaTime, -mMaxSpeed, mMaxSpeed);
+        mVelocityX[i] = Math::NearZero(velocityX, .01f) ? 0.f : velocityX;
+        mVelocityY[i] = Math::NearZero(velocityY, .01f) ? 0.f : velocityY;
+
+        mPositionX[i] += mVelocityX[i] * deltaTime;
+        if (mCollision == ParticleCollision::Tiles)
+        {
+            CollideWithTiles(i, true);
+        }
+
+        mPositionY[i] += mVelocityY[i] * deltaTime;
+        if (mCollision == ParticleCollision::Tiles)
+        {
+            mIsOnGround[i] = false;
+            CollideWithTiles(i, false);
+        }
+
+        i++;
+    }
+
+    if (mHitCallback && !isFrozen && mNumParticles > 0)
+    {
+        HitActors();
+    }
+
+    if (mHitCallback && !mHits.empty())
+    {
+        mHitCallback(mHits);
+    }
+}
+
+void ParticleEmitterComponent::CollideWithTiles(int particle, bool horizontal)
+{
+    SpatialHashing *spatialHashing = mOwner->GetGame()->GetSpatialHashing();
+
+    Vector2 min(mPositionX[particle] + mBoxOffset.x, mPositionY[particle] + mBoxOffset.y);
+    Vector2 max = min + mBoxSize;
+
+    // Boxes are smaller than a tile, so only the tiles under their corners can overlap
+    const Vector2 corners[] = {min, Vector2(max.x, min.y), Vector2(min.x, max.y), max};
+    Tile *checked[4];
+    int numChecked = 0;
+
+    for (const Vector2 &corner : corners)
+    {
+        Tile *tile = spatialHashing->GetTileAtPos(corner);
+        if (!tile || std::find(checked, checked + numChecked, tile) != checked + numChecked)
+            continue;
+
+        checked[numChecked++] = tile;
+
+        if (tile->GetState() != ActorState::Active)
+            continue;
+
+        auto collider = tile->GetComponent<AABBColliderComponent>();
+        if (!collider || !collider->IsEnabled())
+            continue;
+
+        IgnoreOption ignoreOption = collider->CheckLayerIgnored(mHitLayer);
+        if (ignoreOption == IgnoreOption::Both)
+            continue;
+
+        Vector2 tileMin = collider->GetMin();
+        Vector2 tileMax = collider->GetMax();
+        if (!(min.x < tileMax.x && max.x > tileMin.x && min.y < tileMax.y && max.y > tileMin.y))
+            continue;
+
+        // Signed like AABBColliderComponent::GetMinHorizontalOverlap and GetMinVerticalOverlap
+        float overlap;
+        if (horizontal)
+        {
+            float right = max.x - tileMin.x;
+            float left = min.x - tileMax.x;
+            overlap = Math::Abs(left) < Math::Abs(right) ? left : right;
+        }
+        else
+        {
+            float top = min.y - tileMax.y;
+            float down = max.y - tileMin.y;
+            overlap = Math::Abs(top) < Math::Abs(down) ? top : down;
+        }
+
+        if (ignoreOption != IgnoreOption::IgnoreCallback)
+        {
+            AddHit(tile, horizontal, -overlap);
+        }
+
+        if (!collider->IsTangible())
+            continue;
+
+        // Pushed out with the same separation as the collider's resolution
+        constexpr float epsilon = 0.001f;
+        float adjustment = overlap + (overlap > 0 ? epsilon : -epsilon);
+        if (horizontal)
+        {
+            mPositionX[particle] -= adjustment;
+            mVelocityX[particle] = 0.f;
+        }
+        else
+        {
+            mPositionY[particle] -= adjustment;
+            mVelocityY[particle] = 0.f;
+            mIsOnGround[particle] = overlap > 0.f;
+        }
+        return;
+    }
+}
+
+void ParticleEmitterComponent::HitActors()
+{
+    // One spatial query around the whole pool, then each particle against the few results
+    Vector2 poolMin(mPositionX[0], mPositionY[0]);
+    Vector2 poolMax = poolMin;
+    for (int i = 1; i < mNumParticles; i++)
+    {
+        poolMin.x = Math::Min(poolMin.x, mPositionX[i]);
+        poolMin.y = Math::Min(poolMin.y, mPositionY[i]);
+        poolMax.x = Math::Max(poolMax.x, mPositionX[i]);
+        poolMax.y = Math::Max(poolMax.y, mPositionY[i]);
+    }
+    poolMin += mBoxOffset;
+    poolMax += mBoxOffset + mBoxSize;
+
+    Vector2 center = (poolMin + poolMax) * 0.5f;
+    float halfExtent = Math::Max(poolMax.x - poolMin.x, poolMax.y - poolMin.y) * 0.5f;
+    int range = static_cast<int>(halfExtent / Game::TILE_SIZE) + 1;
+
+    // Tiles were handled while moving
+    ColliderLayerMask layers = ~LayerMask(mHitLayer);
+    if (mCollision == ParticleCollision::Tiles)
+        layers &= ~LayerMask(ColliderLayer::Blocks);
+
+    for (AABBColliderComponent *collider : mOwner->GetGame()->GetNearbyColliders(center, range, layers))
+    {
+        if (!collider->IsEnabled() || collider->GetOwner() == mOwner)
+            continue;
+
+        IgnoreOption ignoreOption = collider->CheckLayerIgnored(mHitLayer);
+        if (ignoreOption == IgnoreOption::IgnoreCallback || ignoreOption == IgnoreOption::Both)
+            continue;
+
+        Vector2 otherMin = collider->GetMin();
+        Vector2 otherMax = collider->GetMax();
+        if (poolMax.x <= otherMin.x || poolMin.x >= otherMax.x || poolMax.y <= otherMin.y || poolMin.y >= otherMax.y)
+            continue;
+
+        for (int i = 0; i < mNumParticles; i++)
+        {
+            Vector2 min(mPositionX[i] + mBoxOffset.x, mPositionY[i] + mBoxOffset.y);
+            Vector2 max = min + mBoxSize;
+            if (!(min.x < otherMax.x && max.x > otherMin.x && min.y < otherMax.y && max.y > otherMin.y))
+                continue;
+
+            // An overlapping collider reported both its horizontal and vertical callbacks
+            float right = max.x - otherMin.x;
+            float left = min.x - otherMax.x;
+            float top = min.y - otherMax.y;
+            float down = max.y - otherMin.y;
+            AddHit(collider->GetOwner(), true, -(Math::Abs(left) < Math::Abs(right) ? left : right));
+            AddHit(collider->GetOwner(), false, -(Math::Abs(top) < Math::Abs(down) ? top : down));
+        }
+    }
+}
+
+void ParticleEmitterComponent::AddHit(Actor *actor, bool horizontal, float overlap)
+{
+    auto hit = std::find_if(mHits.begin(), mHits.end(), [actor](const ParticleHit &h)
+                            { return h.actor == actor; });
+    if (hit == mHits.end())
+    {
+        mHits.push_back({actor, 0, 0, 0.f, 0.f});
+        hit = mHits.end() - 1;
+    }
+
+    if (horizontal)
+    {
+        hit->horizontalHits++;
+        hit->horizontalOverlap = overlap;
+    }
+    else
+    {
+        hit->verticalHits++;
+        hit->verticalOverlap = overlap;
+    }
+}
+
+void ParticleEmitterComponent::Draw(SDL_Renderer *renderer, const Vector3 &modColor)
+{
+    SDL_Texture *texture = mSpriteSheet->GetTexture();
+    if (mNumParticles == 0 || !texture)
+        return;
+
+    const auto &frames = mSpriteSheet->GetFrames();
+    const Vector2 &cameraPos = mOwner->GetGame()->GetCameraPos();
+
+    SDL_Color color = {
+        static_cast<Uint8>(modColor.x),
+        static_cast<Uint8>(modColor.y),
+        static_cast<Uint8>(modColor.z),
+        255};
+
+    float texelWidth = 1.f / mTextureWidth;
+    float texelHeight = 1.f / mTextureHeight;
+
+    mVertices.clear();
+    mIndices.clear();
+
+    for (int i = 0; i < mNumParticles; i++)
+    {
+        const SDL_Rect &source = frames[mFrame[i]];
+
+        // Snapped to whole pixels like the sprites
+        float left = static_cast<float>(static_cast<int>(mPositionX[i] - cameraPos.x + mOffset.x));
+        float top = static_cast<float>(static_cast<int>(mPositionY[i] - cameraPos.y + mOffset.y));
+        float right = left + source.w;
+        float bottom = top + source.h;
+
+        float u0 = source.x * texelWidth;
+        float v0 = source.y * texelHeight;
+        float u1 = (source.x + source.w) * texelWidth;
+        float v1 = (source.y + source.h) * texelHeight;
+
+        int first = static_cast<int>(mVertices.size());
+        mVertices.push_back({{left, top}, color, {u0, v0}});
+        mVertices.push_back({{right, top}, color, {u1, v0}});
+        mVertices.push_back({{right, bottom}, color, {u1, v1}});
+        mVertices.push_back({{left, bottom}, color, {u0, v1}});
+
+        mIndices.insert(mIndices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+    // The vertices carry the color, the sheet's texture is shared with sprites that set theirs
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureColorMod(texture, 255, 255, 255);
+
+    ENGINE_STAT_DRAW(texture);
+    SDL_RenderGeometry(renderer, texture, mVertices.data(), static_cast<int>(mVertices.size()),
+                       mIndices.data(), static_cast<int>(mIndices.size()));
+}
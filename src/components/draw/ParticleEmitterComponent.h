@@ -0,0 +1,95 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "DrawComponent.h"
+#include "../collider/AABBColliderComponent.h"
+
+// Hits of one frame's particles on one actor. Overlaps are the last ones, signed from the
+// actor's side like in its collision callbacks
+struct ParticleHit
+{
+    class Actor *actor;
+    int horizontalHits;
+    int verticalHits;
+    float horizontalOverlap;
+    float verticalOverlap;
+};
+
+enum class ParticleCollision
+{
+    None,
+    Tiles // stop at the tiles of the spatial hashing, other actors are only hit
+};
+
+// A pool of small sprites simulated as structure of arrays and drawn with one geometry call,
+// for effects that would otherwise be an actor per particle. Particles live in world space,
+// the owner only decides when the component updates and draws
+class ParticleEmitterComponent : public DrawComponent
+{
+public:
+    ParticleEmitterComponent(class Actor *owner, const std::string &texturePath, const std::string &dataPath,
+                             int capacity, int drawOrder = 100);
+
+    void Update(float deltaTime) override;
+    void Draw(SDL_Renderer *renderer, const Vector3 &modColor = Color::White) override;
+
+    // Centered on position, dropped when the pool is full
+    bool Emit(const Vector2 &position, const Vector2 &velocity, int frame);
+    void Clear() { mNumParticles = 0; }
+    int GetNumParticles() const { return mNumParticles; }
+
+    void SetLifetime(float lifetime) { mLifetime = lifetime; }
+    void SetGravity(float acceleration) { mGravity = acceleration; }
+    void SetMaxSpeed(float speed) { mMaxSpeed = speed; }
+
+    // Velocity lost per second while resting on a tile, the scene has no gravity
+    void SetGroundFriction(float friction) { mGroundFriction = friction; }
+
+    // Box relative to the frame's top left corner
+    void SetCollision(ParticleCollision collision, const Vector2 &boxOffset, const Vector2 &boxSize);
+
+    // Actors are hit as if by a collider of this layer, so their ignore lists apply
+    void SetHitLayer(ColliderLayer layer) { mHitLayer = layer; }
+
+    // Called once per update with every actor hit, when any was
+    void SetHitCallback(std::function<void(const std::vector<ParticleHit> &hits)> callback) { mHitCallback = std::move(callback); }
+
+private:
+    void Kill(int particle);
+    void AddHit(class Actor *actor, bool horizontal, float overlap);
+    void CollideWithTiles(int particle, bool horizontal);
+    void HitActors();
+
+    const class SpriteSheet *mSpriteSheet;
+    int mTextureWidth;
+    int mTextureHeight;
+
+    int mCapacity;
+    int mNumParticles; // alive ones are [0, mNumParticles)
+
+    std::vector<float> mPositionX; // frame's top left corner
+    std::vector<float> mPositionY;
+    std::vector<float> mVelocityX;
+    std::vector<float> mVelocityY;
+    std::vector<float> mAge;
+    std::vector<int> mFrame;
+    std::vector<Uint8> mIsOnGround;
+
+    float mLifetime;
+    float mGravity;
+    float mMaxSpeed;
+    float mGroundFriction;
+
+    ParticleCollision mCollision;
+    Vector2 mBoxOffset;
+    Vector2 mBoxSize;
+    ColliderLayer mHitLayer;
+
+    std::function<void(const std::vector<ParticleHit> &hits)> mHitCallback;
+    std::vector<ParticleHit> mHits;
+
+    std::vector<SDL_Vertex> mVertices;
+    std::vector<int> mIndices;
+};
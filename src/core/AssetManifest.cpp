@@ -0,0 +1,103 @@
+#include "AssetManifest.h"
+#include "../libs/Json.h"
+#include <SDL.h>
+#include <filesystem>
+#include <fstream>
+
+// A missing or mistyped list reads as an empty one
+static const nlohmann::json &GetArray(const nlohmann::json &data, const char *key)
+{
+    static const nlohmann::json empty = nlohmann::json::array();
+
+    auto it = data.find(key);
+    if (it == data.end() || !it->is_array())
+        return empty;
+
+    return *it;
+}
+
+bool AssetManifest::Load(const std::string &path)
+{
+    mTextures.clear();
+    mSpriteSheets.clear();
+    mSounds.clear();
+
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    nlohmann::json data = nlohmann::json::parse(file, nullptr, false);
+    if (data.is_discarded() || !data.is_object())
+    {
+        SDL_Log("[AssetManifest] Failed to parse %s", path.c_str());
+        return false;
+    }
+
+    // Hand edited files may have broken entries, those are skipped and the rest still prefetched
+    int skipped = 0;
+
+    for (const auto &texture : GetArray(data, "textures"))
+    {
+        if (texture.is_string())
+            mTextures.insert(texture.get<std::string>());
+        else
+            skipped++;
+    }
+
+    for (const auto &spriteSheet : GetArray(data, "spriteSheets"))
+    {
+        if (spriteSheet.is_object() && spriteSheet.contains("texture") && spriteSheet["texture"].is_string() &&
+            spriteSheet.contains("data") && spriteSheet["data"].is_string())
+            mSpriteSheets.emplace(spriteSheet["texture"].get<std::string>(), spriteSheet["data"].get<std::string>());
+        else
+            skipped++;
+    }
+
+    for (const auto &sound : GetArray(data, "sounds"))
+    {
+        if (sound.is_string())
+            mSounds.insert(sound.get<std::string>());
+        else
+            skipped++;
+    }
+
+    if (skipped > 0)
+    {
+        SDL_Log("[AssetManifest] Skipped %d invalid entries in %s", skipped, path.c_str());
+    }
+
+    return true;
+}
+
+bool AssetManifest::Save(const std::string &path) const
+{
+    nlohmann::json data;
+    data["textures"] = mTextures;
+    data["sounds"] = mSounds;
+
+    data["spriteSheets"] = nlohmann::json::array();
+    for (const auto &spriteSheet : mSpriteSheets)
+    {
+        data["spriteSheets"].push_back({{"texture", spriteSheet.first}, {"data", spriteSheet.second}});
+    }
+
+    std::error_code ec{};
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        SDL_Log("[AssetManifest] Failed to write %s", path.c_str());
+        return false;
+    }
+
+    file << data.dump(4) << std::endl;
+    return true;
+}
+
+void AssetManifest::Merge(const AssetManifest &other)
+{
+    mTextures.insert(other.mTextures.begin(), other.mTextures.end());
+    mSpriteSheets.insert(other.mSpriteSheets.begin(), other.mSpriteSheets.end());
+    mSounds.insert(other.mSounds.begin(), other.mSounds.end());
+}
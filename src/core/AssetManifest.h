@@ -0,0 +1,35 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <utility>
+
+// Textures, sprite sheets and sounds a scene touches, including the ones only used mid-gameplay
+// (projectiles, dropped items, cutscene spawns). Recorded by playing the scene with
+// --record-manifests, usually through a --replay, and prefetched while the transition to the
+// scene is running. Sets keep the saved files sorted, so new recordings diff cleanly
+class AssetManifest
+{
+public:
+    // Returns false if the file does not exist or cannot be parsed, the manifest is left empty.
+    // Entries that aren't strings are skipped with a log line
+    bool Load(const std::string &path);
+    bool Save(const std::string &path) const;
+
+    void AddTexture(const std::string &texturePath) { mTextures.insert(texturePath); }
+    void AddSpriteSheet(const std::string &texturePath, const std::string &dataPath) { mSpriteSheets.emplace(texturePath, dataPath); }
+    void AddSound(const std::string &soundName) { mSounds.insert(soundName); }
+    void RemoveTexture(const std::string &texturePath) { mTextures.erase(texturePath); }
+    void Merge(const AssetManifest &other);
+
+    bool IsEmpty() const { return mTextures.empty() && mSpriteSheets.empty() && mSounds.empty(); }
+
+    const std::set<std::string> &GetTextures() const { return mTextures; }
+    const std::set<std::pair<std::string, std::string>> &GetSpriteSheets() const { return mSpriteSheets; }
+    const std::set<std::string> &GetSounds() const { return mSounds; }
+
+private:
+    std::set<std::string> mTextures;                               // full paths, as passed to Game::LoadTexture
+    std::set<std::pair<std::string, std::string>> mSpriteSheets;   // texture and data paths
+    std::set<std::string> mSounds;                                 // relative to assets/Sounds
+};
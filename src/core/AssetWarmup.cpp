@@ -0,0 +1,191 @@
+#include "AssetWarmup.h"
+#include "Game.h"
+#include "AudioSystem.h"
+#include "SpriteSheet.h"
+#include "Profiler.h"
+#include <SDL_image.h>
+#include <SDL_mixer.h>
+#include <algorithm>
+#include <filesystem>
+
+// Registering is cheap next to decoding, but texture uploads still cost a little each
+static const int ASSETS_REGISTERED_PER_UPDATE = 4;
+
+AssetWarmup::AssetWarmup(Game *game)
+    : mGame(game), mNumRegistered(0), mNumDecodedInline(0)
+{
+}
+
+AssetWarmup::~AssetWarmup()
+{
+    // Jobs write into mAssets, none can be left running. The queued ones see the flag and
+    // return without decoding, so this only waits for the ones already decoding
+    mCancelled.store(true, std::memory_order_relaxed);
+    mGame->GetJobSystem()->Wait(mCounter);
+
+    for (int i = mNumRegistered; i < static_cast<int>(mAssets.size()); i++)
+    {
+        if (mAssets[i].surface)
+        {
+            SDL_FreeSurface(mAssets[i].surface);
+        }
+        if (mAssets[i].chunk)
+        {
+            Mix_FreeChunk(mAssets[i].chunk);
+        }
+    }
+}
+
+void AssetWarmup::Start()
+{
+    PROFILE_ZONE("AssetWarmupStart");
+
+    std::vector<std::pair<std::string, std::string>> spriteSheets;
+    std::vector<std::string> soundNames;
+
+    std::error_code ec{};
+    for (const auto &entry : std::filesystem::recursive_directory_iterator{"../assets/Sprites", ec})
+    {
+        if (entry.path().extension() != ".png")
+            continue;
+
+        // Same path format as the one the actors pass to LoadSpriteSheet
+        std::filesystem::path dataPath = entry.path();
+        dataPath.replace_extension(".json");
+        if (std::filesystem::exists(dataPath, ec))
+        {
+            spriteSheets.emplace_back(entry.path().generic_string(), dataPath.generic_string());
+        }
+    }
+
+    for (const auto &entry : std::filesystem::directory_iterator{"../assets/Sounds", ec})
+    {
+        std::string extension = entry.path().extension().string();
+        if (extension == ".ogg" || extension == ".wav" || extension == ".mp3")
+        {
+            soundNames.push_back(entry.path().filename().string());
+        }
+    }
+
+    std::sort(spriteSheets.begin(), spriteSheets.end());
+    std::sort(soundNames.begin(), soundNames.end());
+
+    mAssets = std::vector<Asset>(spriteSheets.size() + soundNames.size());
+
+    size_t index = 0;
+    for (const auto &spriteSheet : spriteSheets)
+    {
+        mAssets[index].type = AssetType::SpriteSheet;
+        mAssets[index].path = spriteSheet.first;
+        mAssets[index].dataPath = spriteSheet.second;
+        index++;
+    }
+    for (const auto &soundName : soundNames)
+    {
+        mAssets[index].type = AssetType::Sound;
+        mAssets[index].path = soundName;
+        index++;
+    }
+
+    JobSystem *jobSystem = mGame->GetJobSystem();
+    if (jobSystem->GetNumWorkers() == 0)
+        return;
+
+    // In the background, a frame waiting on its own jobs never ends up decoding a file
+    for (Asset &asset : mAssets)
+    {
+        jobSystem->RunBackground([this, &asset]()
+        {
+            if (!mCancelled.load(std::memory_order_relaxed))
+                Decode(asset);
+        }, &mCounter);
+    }
+}
+
+void AssetWarmup::Decode(Asset &asset)
+{
+    PROFILE_ZONE("DecodeAsset");
+
+    if (asset.type == AssetType::SpriteSheet)
+    {
+        if (SpriteSheet::LoadFrames(asset.dataPath, asset.frames))
+        {
+            asset.surface = IMG_Load(asset.path.c_str());
+        }
+    }
+    else
+    {
+        std::string fileName = "../assets/Sounds/" + asset.path;
+        asset.chunk = Mix_LoadWAV(fileName.c_str());
+    }
+
+    asset.isDecoded.store(true, std::memory_order_release);
+}
+
+bool AssetWarmup::Update()
+{
+    if (IsDone())
+        return true;
+
+    PROFILE_ZONE("AssetWarmup");
+
+    if (mGame->GetJobSystem()->GetNumWorkers() == 0 && mNumDecodedInline < static_cast<int>(mAssets.size()))
+    {
+        Decode(mAssets[mNumDecodedInline++]);
+    }
+
+    int numRegistered = 0;
+    while (!IsDone() && numRegistered < ASSETS_REGISTERED_PER_UPDATE &&
+           mAssets[mNumRegistered].isDecoded.load(std::memory_order_acquire))
+    {
+        Register(mAssets[mNumRegistered]);
+        mNumRegistered++;
+        numRegistered++;
+    }
+
+    if (numRegistered > 0 && mProgressCallback)
+    {
+        mProgressCallback(GetProgress());
+    }
+
+    if (IsDone())
+    {
+        SDL_Log("[AssetWarmup] %d assets ready", static_cast<int>(mAssets.size()));
+    }
+
+    return IsDone();
+}
+
+void AssetWarmup::Register(Asset &asset)
+{
+    if (asset.type == AssetType::SpriteSheet)
+    {
+        if (!asset.surface)
+        {
+            SDL_Log("[AssetWarmup] Failed to load sprite sheet %s", asset.path.c_str());
+            return;
+        }
+
+        mGame->AddSpriteSheet(asset.path, asset.dataPath, asset.surface, std::move(asset.frames));
+        asset.surface = nullptr;
+    }
+    else
+    {
+        if (!asset.chunk)
+        {
+            SDL_Log("[AssetWarmup] Failed to load sound file %s", asset.path.c_str());
+            return;
+        }
+
+        mGame->GetAudio()->AddSound(asset.path, asset.chunk);
+        asset.chunk = nullptr;
+    }
+}
+
+float AssetWarmup::GetProgress() const
+{
+    if (mAssets.empty())
+        return 1.f;
+
+    return static_cast<float>(mNumRegistered) / static_cast<float>(mAssets.size());
+}
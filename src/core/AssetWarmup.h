@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SDL.h>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+#include "JobSystem.h"
+
+// Startup stage that fills the game's caches before gameplay needs them: every sprite sheet
+// under assets/Sprites and every sound under assets/Sounds. Files are decoded by background
+// jobs on the job system's workers; textures are created and everything is registered on the
+// main thread, a few assets per Update so the menu keeps running. Assets a scene loads first
+// are simply skipped when their turn comes. Everything warmed stays in the game's caches for
+// the whole run, so memory holds every sheet and sound even if no scene uses them yet
+class AssetWarmup
+{
+public:
+    explicit AssetWarmup(class Game *game);
+    ~AssetWarmup();
+
+    AssetWarmup(const AssetWarmup &) = delete;
+    AssetWarmup &operator=(const AssetWarmup &) = delete;
+
+    // Lists the assets and queues their decoding
+    void Start();
+
+    // Registers the assets decoded so far, in order. Without workers (web build) it decodes
+    // one asset itself first. Returns true once every asset is registered
+    bool Update();
+
+    bool IsDone() const { return mNumRegistered == static_cast<int>(mAssets.size()); }
+    float GetProgress() const;
+
+    // Called with the progress after each Update that registered something, the last time with 1
+    void SetProgressCallback(std::function<void(float progress)> callback) { mProgressCallback = std::move(callback); }
+
+private:
+    enum class AssetType
+    {
+        SpriteSheet,
+        Sound
+    };
+
+    struct Asset
+    {
+        AssetType type;
+        std::string path;     // texture of sprite sheets, name under assets/Sounds of sounds
+        std::string dataPath; // json of sprite sheets
+
+        // Written by the decoding job, read on the main thread once isDecoded is set
+        SDL_Surface *surface = nullptr;
+        std::vector<SDL_Rect> frames;
+        struct Mix_Chunk *chunk = nullptr;
+        std::atomic<bool> isDecoded{false};
+    };
+
+    static void Decode(Asset &asset);
+    void Register(Asset &asset);
+
+    class Game *mGame;
+    std::vector<Asset> mAssets; // sized once in Start, jobs keep references into it
+    int mNumRegistered;
+    int mNumDecodedInline;
+    JobSystem::Counter mCounter;
+    std::atomic<bool> mCancelled{false}; // set on destruction, queued jobs skip their decoding
+
+    std::function<void(float progress)> mProgressCallback;
+};
@@ -5,21 +5,43 @@
 
 SoundHandle SoundHandle::Invalid;
 
+// Time to fade out the old music and fade in the new one
+const int MUSIC_FADE_MS = 750;
+
 // Create the AudioSystem with specified number of channels
 // (Defaults to 8 channels)
 AudioSystem::AudioSystem(int numChannels)
 {
     Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048);
     Mix_AllocateChannels(numChannels);
-    mChannels.resize(numChannels);
+
+    // Every voice starts in the free list
+    mVoices.resize(numChannels);
+    for (int i = 0; i < numChannels; i++)
+    {
+        mVoices[i].mNextFree = i + 1 < numChannels ? i + 1 : -1;
+    }
+    mFirstFreeVoice = numChannels > 0 ? 0 : -1;
+
+    for (int i = 0; i < static_cast<int>(SoundPriority::Count); i++)
+    {
+        mOldestByPriority[i] = -1;
+        mNewestByPriority[i] = -1;
+    }
 }
 
 // Destroy the AudioSystem
 AudioSystem::~AudioSystem()
 {
+    StopMusic();
+    StopAllSounds();
+
     for (auto& sound : mSounds)
     {
-        Mix_FreeChunk(sound.second);
+        if (sound.second.mChunk)
+        {
+            Mix_FreeChunk(sound.second.mChunk);
+        }
     }
     mSounds.clear();
 
@@ -29,14 +51,17 @@ AudioSystem::~AudioSystem()
 // Updates the status of all the active sounds every frame
 void AudioSystem::Update(float deltaTime)
 {
-    for(int i = 0; i < mChannels.size(); i++)
+    // The previous music finished fading out
+    if (mNextMusic && !Mix_PlayingMusic())
     {
-        if(mChannels[i].IsValid())
+        StartNextMusic();
+    }
+
+    for (int i = 0; i < static_cast<int>(mVoices.size()); i++)
+    {
+        if (mVoices[i].mIsActive && !Mix_Playing(i))
         {
-            if(!Mix_Playing(i)) {
-                mHandleMap.erase(mChannels[i]);
-                mChannels[i].Reset();
-            }
+            ReleaseVoice(i);
         }
     }
 }
@@ -49,127 +74,189 @@ void AudioSystem::Update(float deltaTime)
 //       "Assets/Sounds/ChompLoop.wav".
 SoundHandle AudioSystem::PlaySound(const std::string& soundName, bool looping)
 {
+    if (mSoundPlayedCallback)
+    {
+        mSoundPlayedCallback(soundName);
+    }
+
     // Get the sound with the given name
-    Mix_Chunk *sound = GetSound(soundName);
+    SoundInfo *sound = GetSound(soundName);
 
     if (sound == nullptr) {
         SDL_Log("[AudioSystem] PlaySound couldn't find sound for %s", soundName.c_str());
         return SoundHandle::Invalid;
     }
 
-    // Select an available channel
-    int availableChannel = -1;
-	for(int i = 0; i < mChannels.size(); i++) {
-        if(!mChannels[i].IsValid()) {
-            availableChannel = i;
-            break;
-        }
+    int slot = AcquireVoice(sound);
+    if (slot == -1) {
+        SDL_Log("[AudioSystem] PlaySound ran out of channels playing %s! Dropping it", soundName.c_str());
+        return SoundHandle::Invalid;
     }
 
-    if(availableChannel == -1) {
-        for(auto &handleMap : mHandleMap) {
-            if(handleMap.second.mSoundName == soundName) {
-                availableChannel = handleMap.second.mChannel;
-                SDL_Log("[AudioSystem] PlaySound ran out of channels playing %s! Stopping %s", soundName.c_str(), handleMap.second.mSoundName.c_str());
-                mHandleMap.erase(handleMap.first);
-                break;
-            }
-        }
+    Voice &voice = mVoices[slot];
+    voice.mSound = sound;
+    voice.mIsLooping = looping;
+    voice.mIsPaused = false;
+    LinkVoice(slot);
+
+    // Play sound on selected channel
+    Mix_PlayChannel(slot, sound->mChunk, looping ? -1 : 0);
+
+    // Set the volume for this channel
+    Mix_Volume(slot, mMasterVolume);
+
+    return SoundHandle(slot, voice.mGeneration);
+}
+
+// Stops the sound if it is currently playing
+void AudioSystem::StopSound(SoundHandle sound)
+{
+    Voice *voice = FindVoice(sound);
+    if (voice == nullptr)
+    {
+        SDL_Log("[AudioSystem] StopSound couldn't find handle %s", sound.GetDebugStr());
+        return;
     }
 
-    if(availableChannel == -1) {
-        for (auto &handleMap: mHandleMap) {
-            if (handleMap.second.mIsLooping) {
-                StopSound(handleMap.first);
-                availableChannel = handleMap.second.mChannel;
+    int slot = static_cast<int>(sound.GetSlot());
+    Mix_HaltChannel(slot);
+    ReleaseVoice(slot);
+}
 
-                SDL_Log("[AudioSystem] PlaySound ran out of channels playing %s! Stopping %s", soundName.c_str(), handleMap.second.mSoundName.c_str());
-                break;
-            }
-        }
+// Streams the music on the music channel, fading between the old and the new one
+void AudioSystem::PlayMusic(const std::string& musicName, bool looping)
+{
+    // Keep the music going when the next scene uses the same theme
+    if (mMusic && !mNextMusic && mMusicName == musicName && Mix_PlayingMusic())
+    {
+        return;
     }
 
-    if(availableChannel == -1) {
-        SDL_Log("[AudioSystem] PlaySound ran out of channels playing %s! Stopping %s", soundName.c_str(), mHandleMap.begin()->second.mSoundName.c_str());
+    std::string fileName = "../assets/Sounds/Music/";
+    fileName += musicName;
 
-        StopSound(mHandleMap.begin()->first);
-        availableChannel = mHandleMap.begin()->second.mChannel;
+    Mix_Music* music = Mix_LoadMUS(fileName.c_str());
+    if (!music)
+    {
+        SDL_Log("[AudioSystem] Failed to load music file %s: %s", fileName.c_str(), Mix_GetError());
+        return;
     }
 
-    // Reinsert sound handle
-    mLastHandle++;
+    if (mNextMusic)
+    {
+        Mix_FreeMusic(mNextMusic);
+    }
 
-    // Create handle info
-    HandleInfo hi = {soundName, availableChannel, looping};
-    mHandleMap.emplace(mLastHandle, hi);
-    mChannels[availableChannel] = mLastHandle;
+    mNextMusic = music;
+    mNextMusicName = musicName;
+    mNextMusicLooping = looping;
 
-    // Play sound on selected channel
-    Mix_PlayChannel(availableChannel, sound, looping ? -1 : 0);
-    
-    // Set the volume for this channel
-    Mix_Volume(availableChannel, mMasterVolume);
+    // A paused music would never finish fading out
+    if (Mix_PlayingMusic() && !Mix_PausedMusic())
+    {
+        Mix_FadeOutMusic(MUSIC_FADE_MS);
+        return;
+    }
 
-    return mLastHandle;
+    StartNextMusic();
 }
 
-// Stops the sound if it is currently playing
-void AudioSystem::StopSound(SoundHandle sound)
+void AudioSystem::StartNextMusic()
 {
-    auto it = mHandleMap.find(sound);
-    if (it == mHandleMap.end())
+    Mix_HaltMusic();
+
+    if (mMusic)
     {
-        SDL_Log("[AudioSystem] StopSound couldn't find handle %s", sound.GetDebugStr());
-        return;
+        Mix_FreeMusic(mMusic);
     }
 
-    int channel = it->second.mChannel;
-    Mix_HaltChannel(channel);
-    mHandleMap.erase(it);
-    mChannels[channel].Reset();
+    mMusic = mNextMusic;
+    mMusicName = mNextMusicName;
+    mNextMusic = nullptr;
+    mNextMusicName.clear();
+
+    Mix_VolumeMusic(mMasterVolume);
+    if (Mix_FadeInMusic(mMusic, mNextMusicLooping ? -1 : 1, MUSIC_FADE_MS) == -1)
+    {
+        SDL_Log("[AudioSystem] Failed to play music %s: %s", mMusicName.c_str(), Mix_GetError());
+    }
+}
+
+// Stops the music channel right away
+void AudioSystem::StopMusic()
+{
+    Mix_HaltMusic();
+
+    if (mMusic)
+    {
+        Mix_FreeMusic(mMusic);
+        mMusic = nullptr;
+    }
+
+    if (mNextMusic)
+    {
+        Mix_FreeMusic(mNextMusic);
+        mNextMusic = nullptr;
+    }
+
+    mMusicName.clear();
+    mNextMusicName.clear();
+}
+
+void AudioSystem::PauseMusic()
+{
+    Mix_PauseMusic();
+}
+
+void AudioSystem::ResumeMusic()
+{
+    Mix_ResumeMusic();
 }
 
 // Pauses the sound if it is currently playing
 void AudioSystem::PauseSound(SoundHandle sound)
 {
-    if(mHandleMap.find(sound) == mHandleMap.end())
+    Voice *voice = FindVoice(sound);
+    if (voice == nullptr)
     {
         SDL_Log("[AudioSystem] PauseSound couldn't find handle %s", sound.GetDebugStr());
         return;
     }
 
-    if(!mHandleMap[sound].mIsPaused)
+    if (!voice->mIsPaused)
     {
-        Mix_Pause(mHandleMap[sound].mChannel);
-        mHandleMap[sound].mIsPaused = true;
+        Mix_Pause(static_cast<int>(sound.GetSlot()));
+        voice->mIsPaused = true;
     }
 }
 
 // Resumes the sound if it is currently paused
 void AudioSystem::ResumeSound(SoundHandle sound)
 {
-    if(mHandleMap.find(sound) == mHandleMap.end())
+    Voice *voice = FindVoice(sound);
+    if (voice == nullptr)
     {
         SDL_Log("[AudioSystem] ResumeSound couldn't find handle %s", sound.GetDebugStr());
         return;
     }
 
-    if(mHandleMap[sound].mIsPaused)
+    if (voice->mIsPaused)
     {
-        Mix_Resume(mHandleMap[sound].mChannel);
-        mHandleMap[sound].mIsPaused = false;
+        Mix_Resume(static_cast<int>(sound.GetSlot()));
+        voice->mIsPaused = false;
     }
 }
 
 // Returns the current state of the sound
 SoundState AudioSystem::GetSoundState(SoundHandle sound)
 {
-    if(mHandleMap.find(sound) == mHandleMap.end())
+    Voice *voice = FindVoice(sound);
+    if (voice == nullptr)
     {
         return SoundState::Stopped;
     }
 
-    if(mHandleMap[sound].mIsPaused)
+    if (voice->mIsPaused)
     {
         return SoundState::Paused;
     }
@@ -182,12 +269,13 @@ void AudioSystem::StopAllSounds()
 {
     Mix_HaltChannel(-1);
 
-    for(auto & mChannel : mChannels)
+    for (int i = 0; i < static_cast<int>(mVoices.size()); i++)
     {
-        mChannel.Reset();
+        if (mVoices[i].mIsActive)
+        {
+            ReleaseVoice(i);
+        }
     }
-
-    mHandleMap.clear();
 }
 
 // Sets the master volume (0.0 to 1.0)
@@ -203,28 +291,33 @@ void AudioSystem::SetMasterVolume(float volume)
     // Update volume for all currently loaded sounds
     for (auto& sound : mSounds)
     {
-        Mix_VolumeChunk(sound.second, mMasterVolume);
+        if (sound.second.mChunk)
+        {
+            Mix_VolumeChunk(sound.second.mChunk, mMasterVolume);
+        }
     }
     
+    Mix_VolumeMusic(mMasterVolume);
+
     // Update volume for all currently playing channels
-    for (int i = 0; i < mChannels.size(); i++)
+    for (int i = 0; i < static_cast<int>(mVoices.size()); i++)
     {
-        if (mChannels[i].IsValid())
+        if (mVoices[i].mIsActive)
         {
             Mix_Volume(i, mMasterVolume);
         }
     }
 }
 
-// Cache all sounds under Assets/Sounds
+// Cache all sounds under ../assets/Sounds, the folder GetSound loads from
 void AudioSystem::CacheAllSounds()
 {
 #ifndef __clang_analyzer__
 	std::error_code ec{};
-	for (const auto& rootDirEntry : std::filesystem::directory_iterator{"Assets/Sounds", ec})
+	for (const auto& rootDirEntry : std::filesystem::directory_iterator{"../assets/Sounds", ec})
 	{
 		std::string extension = rootDirEntry.path().extension().string();
-		if (extension == ".ogg" || extension == ".wav")
+		if (extension == ".ogg" || extension == ".wav" || extension == ".mp3")
 		{
 			std::string fileName = rootDirEntry.path().stem().string();
 			fileName += extension;
@@ -243,37 +336,211 @@ void AudioSystem::CacheSound(const std::string& soundName)
 	GetSound(soundName);
 }
 
-// If the sound is already loaded, returns Mix_Chunk from the map.
+bool AudioSystem::IsSoundCached(const std::string& soundName) const
+{
+	auto iter = mSounds.find(soundName);
+	return iter != mSounds.end() && iter->second.mChunk != nullptr;
+}
+
+void AudioSystem::AddSound(const std::string& soundName, Mix_Chunk* chunk)
+{
+	SoundInfo& sound = mSounds[soundName];
+	if (sound.mChunk)
+	{
+		Mix_FreeChunk(chunk);
+		return;
+	}
+
+	Mix_VolumeChunk(chunk, mMasterVolume);
+	sound.mName = soundName;
+	sound.mChunk = chunk;
+}
+
+// Sets the priority and instance limit used when the sound is played
+void AudioSystem::SetSoundProperties(const std::string& soundName, SoundPriority priority, int maxInstances)
+{
+	SoundInfo& sound = mSounds[soundName];
+	sound.mName = soundName;
+	sound.mMaxInstances = maxInstances;
+
+	// Playing voices are linked in the list of the current priority, ReleaseVoice unlinks them
+	// from that list, so it can't change under them
+	if (sound.mPriority != priority && sound.mNumInstances > 0)
+	{
+		SDL_Log("[AudioSystem] SetSoundProperties can't change the priority of %s while it plays",
+				soundName.c_str());
+		return;
+	}
+	sound.mPriority = priority;
+}
+
+// If the sound is already loaded, returns its SoundInfo from the map.
 // Otherwise, will attempt to load the file and save it in the map.
 // Returns nullptr if sound is not found.
 // NOTE: The soundName is without the "Assets/Sounds/" part of the file
 //       For example, pass in "ChompLoop.wav" rather than
 //       "Assets/Sounds/ChompLoop.wav".
-Mix_Chunk* AudioSystem::GetSound(const std::string& soundName)
+AudioSystem::SoundInfo* AudioSystem::GetSound(const std::string& soundName)
 {
+	auto iter = mSounds.find(soundName);
+	if (iter != mSounds.end() && iter->second.mChunk)
+	{
+		return &iter->second;
+	}
+
 	std::string fileName = "../assets/Sounds/";
 	fileName += soundName;
 
-	Mix_Chunk* chunk = nullptr;
-	auto iter = mSounds.find(fileName);
-	if (iter != mSounds.end())
+	Mix_Chunk* chunk = Mix_LoadWAV(fileName.c_str());
+	if (!chunk)
+	{
+		SDL_Log("[AudioSystem] Failed to load sound file %s", fileName.c_str());
+		return nullptr;
+	}
+
+	// Set volume using the current master volume
+	Mix_VolumeChunk(chunk, mMasterVolume);
+
+	// Properties may have been set before the sound was loaded
+	SoundInfo& sound = mSounds[soundName];
+	sound.mName = soundName;
+	sound.mChunk = chunk;
+	return &sound;
+}
+
+AudioSystem::Voice* AudioSystem::FindVoice(SoundHandle sound)
+{
+	unsigned int slot = sound.GetSlot();
+	if (!sound.IsValid() || slot >= mVoices.size())
+	{
+		return nullptr;
+	}
+
+	Voice& voice = mVoices[slot];
+	if (!voice.mIsActive || voice.mGeneration != sound.GetGeneration())
 	{
-		chunk = iter->second;
+		return nullptr;
+	}
+
+	return &voice;
+}
+
+int AudioSystem::AcquireVoice(SoundInfo* sound)
+{
+	int slot = -1;
+
+	// Too many copies of this sound, replace its oldest one
+	if (sound->mMaxInstances > 0 && sound->mNumInstances >= sound->mMaxInstances)
+	{
+		slot = sound->mOldestVoice;
+	}
+	else if (mFirstFreeVoice != -1)
+	{
+		slot = mFirstFreeVoice;
+		mFirstFreeVoice = mVoices[slot].mNextFree;
+		mVoices[slot].mNextFree = -1;
+		return slot;
 	}
 	else
 	{
-		chunk = Mix_LoadWAV(fileName.c_str());
-		if (!chunk)
+		// Oldest voice of the lowest priority that is not above the new sound
+		for (int p = 0; p <= static_cast<int>(sound->mPriority); p++)
 		{
-			SDL_Log("[AudioSystem] Failed to load sound file %s", fileName.c_str());
-			return nullptr;
+			if (mOldestByPriority[p] != -1)
+			{
+				slot = mOldestByPriority[p];
+				break;
+			}
 		}
+	}
 
-        // Set volume using the current master volume
-        Mix_VolumeChunk(chunk, mMasterVolume);
-        mSounds.emplace(fileName, chunk);
+	if (slot == -1)
+	{
+		return -1;
 	}
-	return chunk;
+
+	if (mVoices[slot].mSound != sound)
+	{
+		SDL_Log("[AudioSystem] PlaySound ran out of channels playing %s! Stopping %s",
+				sound->mName.c_str(), mVoices[slot].mSound->mName.c_str());
+	}
+
+	Mix_HaltChannel(slot);
+	ReleaseVoice(slot);
+
+	// ReleaseVoice put it back in the free list, take it out again
+	mFirstFreeVoice = mVoices[slot].mNextFree;
+	mVoices[slot].mNextFree = -1;
+	return slot;
+}
+
+// Appends the voice to the lists of its priority and of its sound
+void AudioSystem::LinkVoice(int slot)
+{
+	Voice& voice = mVoices[slot];
+	SoundInfo* sound = voice.mSound;
+	int priority = static_cast<int>(sound->mPriority);
+
+	voice.mIsActive = true;
+
+	voice.mPrevByPriority = mNewestByPriority[priority];
+	voice.mNextByPriority = -1;
+	if (mNewestByPriority[priority] != -1)
+		mVoices[mNewestByPriority[priority]].mNextByPriority = slot;
+	else
+		mOldestByPriority[priority] = slot;
+	mNewestByPriority[priority] = slot;
+
+	voice.mPrevBySound = sound->mNewestVoice;
+	voice.mNextBySound = -1;
+	if (sound->mNewestVoice != -1)
+		mVoices[sound->mNewestVoice].mNextBySound = slot;
+	else
+		sound->mOldestVoice = slot;
+	sound->mNewestVoice = slot;
+	sound->mNumInstances++;
+}
+
+// Unlinks the voice, invalidates its handles and pushes it to the free list
+void AudioSystem::ReleaseVoice(int slot)
+{
+	Voice& voice = mVoices[slot];
+	SoundInfo* sound = voice.mSound;
+	int priority = static_cast<int>(sound->mPriority);
+
+	if (voice.mPrevByPriority != -1)
+		mVoices[voice.mPrevByPriority].mNextByPriority = voice.mNextByPriority;
+	else
+		mOldestByPriority[priority] = voice.mNextByPriority;
+	if (voice.mNextByPriority != -1)
+		mVoices[voice.mNextByPriority].mPrevByPriority = voice.mPrevByPriority;
+	else
+		mNewestByPriority[priority] = voice.mPrevByPriority;
+
+	if (voice.mPrevBySound != -1)
+		mVoices[voice.mPrevBySound].mNextBySound = voice.mNextBySound;
+	else
+		sound->mOldestVoice = voice.mNextBySound;
+	if (voice.mNextBySound != -1)
+		mVoices[voice.mNextBySound].mPrevBySound = voice.mPrevBySound;
+	else
+		sound->mNewestVoice = voice.mPrevBySound;
+	sound->mNumInstances--;
+
+	voice.mSound = nullptr;
+	voice.mIsActive = false;
+	voice.mIsLooping = false;
+	voice.mIsPaused = false;
+	voice.mPrevByPriority = voice.mNextByPriority = -1;
+	voice.mPrevBySound = voice.mNextBySound = -1;
+
+	// Generation 0 is never used, so handles are never 0
+	voice.mGeneration = (voice.mGeneration + 1) & (SoundHandle::SLOT_MASK);
+	if (voice.mGeneration == 0)
+		voice.mGeneration = 1;
+
+	voice.mNextFree = mFirstFreeVoice;
+	mFirstFreeVoice = slot;
 }
 
 // Input for debugging purposes
@@ -283,23 +550,14 @@ void AudioSystem::ProcessInput(const Uint8* keyState)
 	if (keyState[SDL_SCANCODE_PERIOD] && !mLastDebugKey)
 	{
 		SDL_Log("[AudioSystem] Active Sounds:");
-		for (size_t i = 0; i < mChannels.size(); i++)
+		for (size_t i = 0; i < mVoices.size(); i++)
 		{
-			if (mChannels[i].IsValid())
+			const Voice& voice = mVoices[i];
+			if (voice.mIsActive)
 			{
-				auto iter = mHandleMap.find(mChannels[i]);
-				if (iter != mHandleMap.end())
-				{
-					HandleInfo& hi = iter->second;
-					SDL_Log("Channel %d: %s, %s, looping = %d, paused = %d",
-							static_cast<unsigned>(i), mChannels[i].GetDebugStr(),
-							hi.mSoundName.c_str(), hi.mIsLooping, hi.mIsPaused);
-				}
-				else
-				{
-					SDL_Log("Channel %d: %s INVALID", static_cast<unsigned>(i),
-							mChannels[i].GetDebugStr());
-				}
+				SDL_Log("Channel %d: %s, generation %u, priority %d, looping = %d, paused = %d",
+						static_cast<unsigned>(i), voice.mSound->mName.c_str(), voice.mGeneration,
+						static_cast<int>(voice.mSound->mPriority), voice.mIsLooping, voice.mIsPaused);
 			}
 		}
 	}
@@ -1,38 +1,28 @@
 #pragma once
+#include <functional>
 #include <unordered_map>
-#include <map>
 #include <string>
 #include <vector>
 #include "SDL_stdinc.h"
 
 // SoundHandles are used to operate on active sounds
+// The low bits are the voice (channel) slot and the high bits the generation of that
+// slot, so a handle stops matching as soon as its voice is reused by another sound.
 class SoundHandle
 {
 public:
+	SoundHandle() = default;
+
 	// Returns true if this is an active sound handle
 	bool IsValid() const { return mID != 0; }
 
 	// Resets to inactive sound handle
 	void Reset() { mID = 0; }
 
-	// Increments for convenience
-	SoundHandle& operator++()
-	{
-		mID++;
-		return *this;
-	}
-
-	SoundHandle operator++(int)
-	{
-		SoundHandle temp(*this);
-		mID++;
-		return temp;
-	}
-
 	const char* GetDebugStr() const
 	{
 		static std::string tempStr;
-		tempStr = std::to_string(mID);
+		tempStr = std::to_string(GetSlot()) + ":" + std::to_string(GetGeneration());
 		return tempStr.c_str();
 	}
 
@@ -47,9 +37,32 @@ public:
 	static SoundHandle Invalid;
 
 private:
+	friend class AudioSystem;
+
+	static const unsigned int SLOT_BITS = 16;
+	static const unsigned int SLOT_MASK = (1u << SLOT_BITS) - 1;
+
+	// Generations start at 1, so a valid handle is never 0
+	SoundHandle(unsigned int slot, unsigned int generation)
+		: mID((generation << SLOT_BITS) | slot) {}
+
+	unsigned int GetSlot() const { return mID & SLOT_MASK; }
+	unsigned int GetGeneration() const { return mID >> SLOT_BITS; }
+
 	unsigned int mID = 0;
 };
 
+// When all the channels are busy, a new sound takes the voice of the oldest
+// sound with the lowest priority, as long as that priority is not above its own
+enum class SoundPriority
+{
+	Low,
+	Normal,
+	High,
+	Critical,
+	Count
+};
+
 // Used to get information about state of sound
 enum class SoundState
 {
@@ -96,7 +109,7 @@ enum class SoundState
 	// Stops all sounds on all channels
 	void StopAllSounds();
 
-	// Cache all sounds under Assets/Sounds
+	// Cache all sounds under ../assets/Sounds
 	void CacheAllSounds();
 
 	// Used to preload the sound data of a sound
@@ -105,42 +118,100 @@ enum class SoundState
 	//       "Assets/Sounds/ChompLoop.wav".
 	void CacheSound(const std::string& soundName);
 
+	// Sets how the sound competes for channels. maxInstances limits how many copies
+	// of the sound play at once (0 means no limit), the oldest copy is replaced.
+	// The priority is left unchanged while copies of the sound are playing.
+	void SetSoundProperties(const std::string& soundName, SoundPriority priority, int maxInstances);
+
+	// Returns true if the sound data is already loaded
+	bool IsSoundCached(const std::string& soundName) const;
+
+	// Takes ownership of sound data decoded somewhere else (e.g. by the ScenePreloader)
+	void AddSound(const std::string& soundName, struct Mix_Chunk* chunk);
+
+	// Called with the name of every sound PlaySound is asked for, e.g. to record scene manifests
+	void SetSoundPlayedCallback(std::function<void(const std::string& soundName)> callback) { mSoundPlayedCallback = std::move(callback); }
+
+	// Streams the music with the specified name on the music channel, fading out
+	// the current music and fading in the new one. Music is decoded while it plays,
+	// so it is never fully loaded in memory like the sounds are.
+	// NOTE: The musicName is without the "Assets/Sounds/Music/" part of the file
+	void PlayMusic(const std::string& musicName, bool looping = true);
+
+	// Stops the music channel right away
+	void StopMusic();
+
+	// Pauses/resumes the music channel
+	void PauseMusic();
+	void ResumeMusic();
+
 public:
     // Sets the master volume (0.0 to 1.0)
     void SetMasterVolume(float volume);
 
 private:
-	// If the sound is already loaded, returns Mix_Chunk from the map.
+	// Sound data and playback rules of a file, plus the list of voices playing it
+	struct SoundInfo
+	{
+		std::string mName;
+		struct Mix_Chunk* mChunk = nullptr;
+		SoundPriority mPriority = SoundPriority::Normal;
+		int mMaxInstances = 0;
+		int mNumInstances = 0;
+		int mOldestVoice = -1;
+		int mNewestVoice = -1;
+	};
+
+	// If the sound is already loaded, returns its SoundInfo from the map.
 	// Otherwise, will attempt to load the file and save it in the map.
 	// Returns nullptr if sound is not found.
 	// NOTE: The soundName is without the "Assets/Sounds/" part of the file
 	//       For example, pass in "ChompLoop.wav" rather than
 	//       "Assets/Sounds/ChompLoop.wav".
-	struct Mix_Chunk* GetSound(const std::string& soundName);
+	SoundInfo* GetSound(const std::string& soundName);
 
-	// Internal struct used to track the properties of active sound handles
-	struct HandleInfo
+	// Picks a free voice, or steals one following the sound's rules. Returns -1 if
+	// every voice plays something more important.
+	int AcquireVoice(SoundInfo* sound);
+	void LinkVoice(int slot);
+	void ReleaseVoice(int slot);
+
+	// Starts the music waiting for the current one to fade out
+	void StartNextMusic();
+
+	// One voice per channel. Active voices are linked oldest first in the list of
+	// their priority and in the list of their sound, so stealing never scans.
+	struct Voice
 	{
-		std::string mSoundName;
-		int mChannel = -1;
+		SoundInfo* mSound = nullptr;
+		unsigned int mGeneration = 1;
+		bool mIsActive = false;
 		bool mIsLooping = false;
 		bool mIsPaused = false;
+		int mPrevByPriority = -1, mNextByPriority = -1;
+		int mPrevBySound = -1, mNextBySound = -1;
+		int mNextFree = -1;
 	};
+	std::vector<Voice> mVoices;
+
+	// Returns the voice of an active handle, nullptr if the handle is stale
+	Voice* FindVoice(SoundHandle sound);
 
-	// Tracks the active SoundHandle for each channel
-	// An Invalid SoundHandle means the channel is free, otherwise
-	// it's an active handle.
-	std::vector<SoundHandle> mChannels;
+	int mFirstFreeVoice = -1;
+	int mOldestByPriority[static_cast<int>(SoundPriority::Count)];
+	int mNewestByPriority[static_cast<int>(SoundPriority::Count)];
 
-	// Maps all the active SoundHandles to their HandleInfo
-	std::map<SoundHandle, HandleInfo> mHandleMap;
+	// Map to store the sound data for all the files
+	std::unordered_map<std::string, SoundInfo> mSounds;
 
-	// Map to store the Mix_Chunk data for all the files
-	std::unordered_map<std::string, Mix_Chunk*> mSounds;
+	// Music currently streaming and the one waiting for it to fade out
+	struct _Mix_Music* mMusic = nullptr;
+	struct _Mix_Music* mNextMusic = nullptr;
+	std::string mMusicName;
+	std::string mNextMusicName;
+	bool mNextMusicLooping = true;
 
-	// Used to track the last audio handle value used
-	// Will increment prior to playing a new sound
-	SoundHandle mLastHandle;
+	std::function<void(const std::string& soundName)> mSoundPlayedCallback;
 
 	// Used for debug input in ProcessInput
 	bool mLastDebugKey = false;
@@ -5,6 +5,9 @@
 class Checkpoint {
     Checkpoint(const Vector2 &pos) : position(pos) {}
 
+    public:
+        const Vector2 &GetPosition() const { return position; }
+
     protected:
         friend class Zoe;
         Vector2 position;
@@ -55,7 +55,8 @@ void Config::Update(const std::string& key, const nlohmann::json& value, bool sa
 
 template<typename T>
 T Config::Get(const std::string& key) const {
-    nlohmann::json current = mData;
+    // Walk by pointer, actors look values up every frame and copying the config is costly
+    const nlohmann::json *current = &mData;
     
     size_t start = 0;
     while (start < key.length()) {
@@ -66,8 +67,8 @@ T Config::Get(const std::string& key) const {
         // Convert to lowercase for case-insensitive matching
         std::transform(part.begin(), part.end(), part.begin(), ::toupper);
         
-        if (current.contains(part)) {
-            current = current[part];
+        if (current->contains(part)) {
+            current = &(*current)[part];
         } else {
             throw std::runtime_error("Key not found: " + part);
         }
@@ -75,7 +76,7 @@ T Config::Get(const std::string& key) const {
         start = end + 1;
     }
     
-    return current.get<T>();
+    return current->get<T>();
 }
 
 template int Config::Get<int>(const std::string&) const;
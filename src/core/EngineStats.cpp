@@ -0,0 +1,144 @@
+#include "EngineStats.h"
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+std::atomic<int> EngineStats::sCurrent[static_cast<int>(Stat::Count)] = {};
+int EngineStats::sLastFrame[static_cast<int>(Stat::Count)] = {};
+SDL_Texture *EngineStats::sLastTexture = nullptr;
+unsigned int EngineStats::sFrameIndex = 0;
+
+static std::ofstream sCsvFile;
+
+void EngineStats::CountDraw(SDL_Texture *texture)
+{
+    Add(Stat::DrawCalls);
+
+    if (texture != sLastTexture)
+    {
+        Add(Stat::TextureSwitches);
+        sLastTexture = texture;
+    }
+}
+
+const char *EngineStats::GetName(Stat stat)
+{
+    switch (stat)
+    {
+    case Stat::SpatialQueries: return "spatial_queries";
+    case Stat::SpatialCandidates: return "spatial_candidates";
+    case Stat::AABBTests: return "aabb_tests";
+    case Stat::CollisionCallbacks: return "collision_callbacks";
+    case Stat::ActorsUpdated: return "actors_updated";
+    case Stat::ActorsCoarseUpdated: return "actors_coarse_updated";
+    case Stat::ComponentsOnCamera: return "components_on_camera";
+    case Stat::DrawCalls: return "draw_calls";
+    case Stat::TextureSwitches: return "texture_switches";
+    case Stat::TexturesCreated: return "textures_created";
+    case Stat::Allocations: return "allocations";
+    case Stat::TimersTicked: return "timers_ticked";
+    default: return "unknown";
+    }
+}
+
+std::string EngineStats::GetSummary()
+{
+    std::string summary;
+    for (int i = 0; i < static_cast<int>(Stat::Count); i++)
+    {
+        summary += GetName(static_cast<Stat>(i));
+        summary += ": ";
+        summary += std::to_string(sLastFrame[i]);
+        summary += "\n";
+    }
+
+    if (IsRecordingCsv())
+    {
+        summary += "recording csv";
+    }
+
+    return summary;
+}
+
+void EngineStats::EndFrame(float deltaTime)
+{
+    for (int i = 0; i < static_cast<int>(Stat::Count); i++)
+    {
+        sLastFrame[i] = sCurrent[i].exchange(0, std::memory_order_relaxed);
+    }
+
+    // The first draw of every frame counts as a switch
+    sLastTexture = nullptr;
+    sFrameIndex++;
+
+    if (!sCsvFile.is_open())
+        return;
+
+    sCsvFile << sFrameIndex << "," << deltaTime * 1000.f;
+    for (int i = 0; i < static_cast<int>(Stat::Count); i++)
+    {
+        sCsvFile << "," << sLastFrame[i];
+    }
+    sCsvFile << "\n";
+}
+
+bool EngineStats::StartCsv(const std::string &path)
+{
+    StopCsv();
+
+    sCsvFile.open(path);
+    if (!sCsvFile.is_open())
+    {
+        SDL_Log("[EngineStats] Failed to open %s", path.c_str());
+        return false;
+    }
+
+    sCsvFile << "frame,frame_ms";
+    for (int i = 0; i < static_cast<int>(Stat::Count); i++)
+    {
+        sCsvFile << "," << GetName(static_cast<Stat>(i));
+    }
+    sCsvFile << "\n";
+
+    SDL_Log("[EngineStats] Recording counters to %s", path.c_str());
+    return true;
+}
+
+void EngineStats::StopCsv()
+{
+    if (sCsvFile.is_open())
+    {
+        sCsvFile.close();
+    }
+}
+
+bool EngineStats::IsRecordingCsv()
+{
+    return sCsvFile.is_open();
+}
+
+#ifdef ASTRAL_PROFILER
+// Counts C++ heap allocations (new[] forwards here by default, aligned new is not counted)
+void *operator new(std::size_t size)
+{
+    EngineStats::Add(Stat::Allocations);
+
+    void *pointer = std::malloc(size ? size : 1);
+    if (!pointer)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+#endif
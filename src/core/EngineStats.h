@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SDL.h>
+#include <atomic>
+#include <string>
+
+// Counters reset every frame, shown in the debug overlay (g) and optionally
+// written to a CSV file, one row per frame (k toggles the recording)
+enum class Stat
+{
+    SpatialQueries,
+    SpatialCandidates,
+    AABBTests,
+    CollisionCallbacks,
+    ActorsUpdated,
+    ActorsCoarseUpdated,
+    ComponentsOnCamera,
+    DrawCalls,
+    TextureSwitches,
+    TexturesCreated,
+    Allocations,
+    TimersTicked,
+    Count
+};
+
+class EngineStats
+{
+public:
+    static void Add(Stat stat, int amount = 1)
+    {
+        sCurrent[static_cast<int>(stat)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    static void Set(Stat stat, int value)
+    {
+        sCurrent[static_cast<int>(stat)].store(value, std::memory_order_relaxed);
+    }
+
+    // Counts a draw call, and a texture switch if the texture differs from the previous draw
+    static void CountDraw(SDL_Texture *texture);
+
+    // Value of the last finished frame
+    static int Get(Stat stat) { return sLastFrame[static_cast<int>(stat)]; }
+    static const char *GetName(Stat stat);
+
+    // One "name: value" line per counter
+    static std::string GetSummary();
+
+    // Closes the frame: keeps its values, writes the CSV row and resets the counters
+    static void EndFrame(float deltaTime);
+
+    static bool StartCsv(const std::string &path);
+    static void StopCsv();
+    static bool IsRecordingCsv();
+
+private:
+    static std::atomic<int> sCurrent[static_cast<int>(Stat::Count)];
+    static int sLastFrame[static_cast<int>(Stat::Count)];
+    static SDL_Texture *sLastTexture;
+    static unsigned int sFrameIndex;
+};
+
+#ifdef ASTRAL_PROFILER
+#define ENGINE_STAT(stat, amount) EngineStats::Add(stat, amount)
+#define ENGINE_STAT_SET(stat, value) EngineStats::Set(stat, value)
+#define ENGINE_STAT_DRAW(texture) EngineStats::CountDraw(texture)
+#else
+#define ENGINE_STAT(stat, amount)
+#define ENGINE_STAT_SET(stat, value)
+#define ENGINE_STAT_DRAW(texture)
+#endif
@@ -22,6 +22,16 @@
 #include "Game.h"
 #include "HUD.h"
 #include "SpatialHashing.h"
+#include "PhysicsWorld.h"
+#include "SpriteSheet.h"
+#include "TriggerIndex.h"
+#include "SceneSnapshot.h"
+#include "AssetWarmup.h"
+#include "ScenePreloader.h"
+#include "AssetManifest.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "EngineStats.h"
 #include "../libs/Json.h"
 #include "../libs/Random.h"
 #include "../actors/Actor.h"
@@ -44,17 +54,22 @@ Game::Game()
     : mWindow(nullptr), mRenderer(nullptr), mTicksCount(0), mIsRunning(true),
       mZoe(nullptr), mHUD(nullptr), mBackgroundColor(0, 0, 0),
       mModColor(255, 255, 255), mCameraPos(Vector2::Zero), mAudio(nullptr),
-      mSceneManagerTimer(0.0f), mSceneManagerState(SceneManagerState::None), mGameScene(GameScene::MainMenu),
+      mSceneManagerTimer(0.0f), mSceneManagerState(SceneManagerState::None), mScenePreloader(nullptr), mGameScene(GameScene::MainMenu),
       mNextScene(GameScene::Level1), mBackgroundTexture(nullptr), mBackgroundSize(Vector2::Zero),
       mBackgroundPosition(Vector2::Zero), mMap(nullptr), mBackgroundIsCameraWise(true),
       mCurrentCutscene(nullptr), mCutscenes(), mGamePlayState(GamePlayState::Playing),
-      mDebugMode(false), mEnemies(), mStar(nullptr), mApplyGravityScene(true),
+      mDebugMode(false), mShowProfiler(false), mEnemies(), mStar(nullptr), mApplyGravityScene(true),
       mCameraCenter(CameraCenter::Zoe), mMaintainCameraInMap(true), mCameraCenterPos(Vector2::Zero),
       mController(nullptr), mMustAlwaysUpdateActors(), mPreviousGameState(GamePlayState::Playing),
       mRealWindowHeight(0), mRealWindowWidth(0), mDeltatime(0.f), mShakeCounter(0.f), mShakeIntensity(3.f),
       mPortal(nullptr), mIsPhysicsFrozen(false), mHasSpawnedPortalLevel2(false),
       mMetalCratePortionTimeCounter(0.f), mQuasarEncounterTimeCounter(0.f), mZathura(nullptr),
-      mLastUnTooglePauseTick(0), mPreviousScene(GameScene::MainMenu)
+      mGameTime(0.f), mLastUnTooglePauseTime(0.f), mPreviousScene(GameScene::MainMenu),
+      mInputRecorder(nullptr), mRenderEnabled(true), mFrameStartCounter(0), mOutputStartCounter(0), mStressTest(nullptr),
+      mRecordManifests(false), mRecordedManifest(nullptr), mJobSystem(nullptr), mPhysicsWorld(nullptr), mTriggerIndex(nullptr),
+      mAssetWarmup(nullptr), mSceneSnapshot(nullptr), mSceneSnapshotRequested(false), mSceneSnapshotRestoreRequested(false),
+      mActiveEpoch(0), mActiveActorsCameraPos(Vector2::Zero), mActiveActorsDirty(true),
+      mCoarseMargin(0.f), mCoarseStep(0.1f), mMaxCoarseUpdates(0), mCoarseCursor(0)
 {
     mWindowWidth = 640;
     mWindowHeight = 352;
@@ -152,26 +167,81 @@ bool Game::Initialize()
     // Start random number generator
     Random::Init();
 
+    // A recording stores the seed, a replay restores it
+    mInputRecorder = new InputRecorder();
+    if (!mReplayPath.empty())
+    {
+        if (!mInputRecorder->StartReplay(mReplayPath))
+            return false;
+    }
+    else if (!mRecordingPath.empty())
+    {
+        mInputRecorder->StartRecording(mRecordingPath, std::random_device{}());
+    }
+
+    if (mInputRecorder->GetMode() != InputRecorder::Mode::Off)
+    {
+        Random::Seed(mInputRecorder->GetSeed());
+        Math::SeedRand(mInputRecorder->GetSeed());
+    }
+
     mConfig = new Config();
     mConfig->Initialize("config.json");
 
+    mCoarseMargin = mConfig->Get<float>("SIMULATION_LOD.COARSE_MARGIN_TILES") * TILE_SIZE;
+    mCoarseStep = mConfig->Get<float>("SIMULATION_LOD.COARSE_STEP");
+    mMaxCoarseUpdates = mConfig->Get<int>("SIMULATION_LOD.MAX_COARSE_UPDATES_PER_FRAME");
+
     // Initialize game systems
     mAudio = new AudioSystem();
+    mAudio->SetSoundProperties("respawn.wav", SoundPriority::Critical, 1);
+    mAudio->SetSoundProperties("portalSuck.wav", SoundPriority::Critical, 1);
+    mAudio->SetSoundProperties("zoeTakeDamage.wav", SoundPriority::High, 1);
+    mAudio->SetSoundProperties("nevasca.wav", SoundPriority::High, 1);
+    mAudio->SetSoundProperties("portalAmbient.wav", SoundPriority::High, 1);
+    mAudio->SetSoundProperties("fireball.wav", SoundPriority::Normal, 2);
+    mAudio->SetSoundProperties("playerHitBlock.wav", SoundPriority::Normal, 2);
+    mAudio->SetSoundProperties("breakTile.wav", SoundPriority::Low, 3);
+    mAudio->SetSoundProperties("dialogueStep.wav", SoundPriority::Low, 1);
+    if (mRecordManifests)
+    {
+        mAudio->SetSoundPlayedCallback([this](const std::string &soundName) {
+            if (mRecordedManifest)
+                mRecordedManifest->AddSound(soundName);
+        });
+    }
+    mScenePreloader = new ScenePreloader();
+    mJobSystem = new JobSystem();
+    mPhysicsWorld = new PhysicsWorld(this);
     mSpatialHashing = new SpatialHashing(TILE_SIZE,
                                          LEVEL_WIDTH * TILE_SIZE,
                                          LEVEL_HEIGHT * TILE_SIZE);
+    mTriggerIndex = new TriggerIndex(TRIGGER_CELL_SIZE, LEVEL_WIDTH * TILE_SIZE, LEVEL_HEIGHT * TILE_SIZE);
 
     mDialogueSystem->Initialize(this);
 
-    SetGameScene(GameScene::MainMenu);
+    if (mStressTest)
+    {
+        mStressTest->Initialize();
+        SetGameScene(GameScene::StressTest);
+    }
+    else
+    {
+        SetGameScene(GameScene::MainMenu);
+    }
 
     SDL_ShowCursor(SDL_DISABLE);
     SDL_SetRelativeMouseMode(SDL_FALSE);
 
     mTicksCount = SDL_GetTicks();
 
-    mAudio->CacheAllSounds();
-
+    // The main menu shows up right away, caches fill while it runs. The stress test loads
+    // little and its frame times would include the decoding on the workers
+    if (!mStressTest)
+    {
+        mAssetWarmup = new AssetWarmup(this);
+        mAssetWarmup->Start();
+    }
 
     return true;
 }
@@ -187,6 +257,8 @@ void Game::SetGameScene(Game::GameScene scene, float sceneLeftTime)
     mNextScene = scene;
     mSceneManagerState = SceneManagerState::Entering;
     mSceneManagerTimer = sceneLeftTime;
+
+    PreloadScene(scene);
 }
 
 void Game::ResetGameScene(float transitionTime)
@@ -196,9 +268,35 @@ void Game::ResetGameScene(float transitionTime)
 
 void Game::ChangeScene()
 {
+    PROFILE_ZONE("ChangeScene");
+
+    // Usually the preloader is done by now, this only blocks on what is left
+    mScenePreloader->Wait();
+    for (auto &sound : mScenePreloader->TakeSounds())
+    {
+        mAudio->AddSound(sound.first, sound.second);
+    }
+    for (auto &spriteSheet : mScenePreloader->TakeSpriteSheets())
+    {
+        AddSpriteSheet(spriteSheet.texturePath, spriteSheet.dataPath, spriteSheet.surface, std::move(spriteSheet.frames));
+    }
+
     // Unload current Scene
     UnloadScene();
 
+    for (const auto &texturePath : mManifestTextures)
+    {
+        if (SDL_Surface *surface = mScenePreloader->TakeSurface(texturePath))
+        {
+            mSceneSurfaces.emplace(texturePath, surface);
+        }
+    }
+
+    if (mRecordManifests)
+    {
+        mRecordedManifest = new AssetManifest();
+    }
+
     // Reset camera position
     mCameraPos.Set(0.0f, 0.0f);
     SetMaintainCameraInMap(true);
@@ -210,8 +308,16 @@ void Game::ChangeScene()
 
     mAudio->StopAllSounds();
 
-    // Reset scene manager state
-    mSpatialHashing = new SpatialHashing(TILE_SIZE, LEVEL_WIDTH * TILE_SIZE, LEVEL_HEIGHT * TILE_SIZE);
+    // Reset scene manager state. Generated stress maps can be bigger than the levels
+    int widthInTiles = LEVEL_WIDTH, heightInTiles = LEVEL_HEIGHT;
+    if (mNextScene == GameScene::StressTest && mStressTest)
+    {
+        widthInTiles = std::max(widthInTiles, mStressTest->GetWidthInTiles());
+        heightInTiles = std::max(heightInTiles, mStressTest->GetHeightInTiles());
+    }
+    mSpatialHashing = new SpatialHashing(TILE_SIZE, widthInTiles * TILE_SIZE, heightInTiles * TILE_SIZE);
+    mTriggerIndex = new TriggerIndex(TRIGGER_CELL_SIZE, widthInTiles * TILE_SIZE, heightInTiles * TILE_SIZE);
+    mActiveActorsDirty = true;
 
     SetApplyGravityScene(Game::APPLY_GRAVITY_SCENE_DEFAULT);
 
@@ -234,13 +340,23 @@ void Game::ChangeScene()
         LoadTestsLevel();
     else if (mNextScene == GameScene::BedroomFinal)
         LoadBedroomFinal();
+    else if (mNextScene == GameScene::StressTest)
+        LoadStressTestLevel();
 
     // Set new scenes
     mGameScene = mNextScene;
+
+    // Drop anything the scene did not use
+    mScenePreloader->Clear();
 }
 
 void Game::UpdateSceneManager(float deltaTime)
 {
+    if (mSceneManagerState != SceneManagerState::None)
+    {
+        mScenePreloader->Update();
+    }
+
     if (mSceneManagerState == SceneManagerState::Entering)
     {
         mSceneManagerTimer -= deltaTime;
@@ -263,8 +379,18 @@ void Game::UpdateSceneManager(float deltaTime)
 
 void Game::UnloadScene()
 {
+    // Retired actors leave the spatial hashing and the trigger index like the others
+    delete mSceneSnapshot;
+    mSceneSnapshot = nullptr;
+    mSceneSnapshotRequested = false;
+    mSceneSnapshotRestoreRequested = false;
+
     // Delete actors
     delete mSpatialHashing;
+
+    // Map objects deleted with the actors leave it first
+    delete mTriggerIndex;
+    mTriggerIndex = nullptr;
     mZoe = nullptr;
     mStar = nullptr;
     mPortal = nullptr;
@@ -280,6 +406,20 @@ void Game::UnloadScene()
 
     mHUD = nullptr;
 
+    // The main menu's progress text is gone
+    if (mAssetWarmup)
+    {
+        mAssetWarmup->SetProgressCallback(nullptr);
+    }
+
+    SaveRecordedManifest();
+
+    for (auto &surface : mSceneSurfaces)
+    {
+        SDL_FreeSurface(surface.second);
+    }
+    mSceneSurfaces.clear();
+
     // Delete background texture
     if (mBackgroundTexture)
     {
@@ -300,6 +440,8 @@ void Game::RunLoop()
 {
     while (mIsRunning)
     {
+        Profiler::BeginFrame();
+
         ProcessInput();
         UpdateGame();
         GenerateOutput();
@@ -308,26 +450,16 @@ void Game::RunLoop()
 
 void Game::ProcessInput()
 {
-    int numJoysticks = SDL_NumJoysticks();
+    PROFILE_ZONE("ProcessInput");
 
-    for (int i = 0; i < numJoysticks; ++i)
-    {
-        if (SDL_IsGameController(i))
-        {
-            mController = SDL_GameControllerOpen(i);
-            if (!mController)
-            {
-                SDL_Log("Could not open gamecontroller %d: %s", i, SDL_GetError());
-            }
-            break;
-        }
-    }
+    mFrameStartCounter = SDL_GetPerformanceCounter();
 
-    SDL_GameController *controller = GetController();
+    std::vector<SDL_Event> events;
+    ReadInput(events);
 
     // Check if the Return key has been pressed to pause/unpause the game
     if (
-        SDL_GameControllerGetButton(controller, SDL_CONTROLLER_BUTTON_START) &&
+        GetControllerButton(SDL_CONTROLLER_BUTTON_START) &&
         (GetGamePlayState() == GamePlayState::Playing || 
         GetGamePlayState() == GamePlayState::Paused)
     )
@@ -335,7 +467,7 @@ void Game::ProcessInput()
         UnTogglePause();
     }
 
-    if (SDL_GameControllerGetButton(controller, SDL_CONTROLLER_BUTTON_A) && !mUIStack.empty())
+    if (GetControllerButton(SDL_CONTROLLER_BUTTON_A) && !mUIStack.empty())
     {
         UICursor *cursor = mUIStack.back()->GetCursor();
         if (cursor) 
@@ -344,11 +476,6 @@ void Game::ProcessInput()
         }
     }
 
-    std::vector<SDL_Event> events;
-    while (SDL_PollEvent(&events.emplace_back()))
-    {
-    }
-
     for (const auto &event : events)
     {
         switch (event.type)
@@ -364,6 +491,26 @@ void Game::ProcessInput()
                 if (mDebugMode) std::cout << "Debug mode activated" << std::endl;
             }
 
+            // Profiler: h toggles the flame overlay, j dumps a Chrome trace
+            if (event.key.keysym.sym == SDLK_h && event.key.repeat == 0)
+            {
+                mShowProfiler = !mShowProfiler;
+            }
+
+            if (event.key.keysym.sym == SDLK_j && event.key.repeat == 0)
+            {
+                Profiler::DumpChromeTrace("trace_" + std::to_string(SDL_GetTicks()) + ".json");
+            }
+
+            // k starts/stops writing the engine counters to a CSV file
+            if (event.key.keysym.sym == SDLK_k && event.key.repeat == 0)
+            {
+                if (EngineStats::IsRecordingCsv())
+                    EngineStats::StopCsv();
+                else
+                    EngineStats::StartCsv("stats_" + std::to_string(SDL_GetTicks()) + ".csv");
+            }
+
             // Handle key press for UI screens
             if (!mUIStack.empty())
             {
@@ -426,33 +573,90 @@ void Game::ProcessInput()
 
     if (mGamePlayState == GamePlayState::Dialogue)
     {
-        const Uint8 *state = SDL_GetKeyboardState(nullptr);
-        GetDialogueSystem()->HandleInput(state);
+        GetDialogueSystem()->HandleInput(GetKeyboardState());
     }
 }
 
-void Game::ProcessInputActors(const std::vector<SDL_Event>& events)
+void Game::ReadInput(std::vector<SDL_Event> &events)
 {
-    const Uint8 *state = SDL_GetKeyboardState(nullptr);
+    bool isReplaying = mInputRecorder->GetMode() == InputRecorder::Mode::Replaying;
 
-    std::vector<Actor *> toProcessActors = mMustAlwaysUpdateActors;
+    // SDL still needs its events pumped during a replay, only closing the window is honored
+    SDL_Event event;
+    while (SDL_PollEvent(&event))
+    {
+        if (!isReplaying || event.type == SDL_QUIT)
+        {
+            events.push_back(event);
+        }
+    }
 
-    // Get actors on camera
-    std::vector<Actor *> actorsOnCamera = mSpatialHashing->QueryOnCamera(
-        mCameraPos,
-        mWindowWidth,
-        mWindowHeight);
+    if (isReplaying)
+    {
+        if (!mInputRecorder->ReadFrame(mInput))
+        {
+            mInputRecorder->Stop();
+            Quit();
 
-    for (auto actor : actorsOnCamera)
+            // The last frame still runs, with nothing pressed
+            float deltaTime = mInput.deltaTime;
+            mInput = InputFrame();
+            mInput.deltaTime = deltaTime;
+            return;
+        }
+
+        events.insert(events.end(), mInput.events.begin(), mInput.events.end());
+        return;
+    }
+
+    int numJoysticks = SDL_NumJoysticks();
+
+    for (int i = 0; i < numJoysticks; ++i)
+    {
+        if (SDL_IsGameController(i))
+        {
+            mController = SDL_GameControllerOpen(i);
+            if (!mController)
+            {
+                SDL_Log("Could not open gamecontroller %d: %s", i, SDL_GetError());
+            }
+            break;
+        }
+    }
+
+    mInput.events = events;
+
+    int numKeys = 0;
+    const Uint8 *keys = SDL_GetKeyboardState(&numKeys);
+    std::copy(keys, keys + std::min(numKeys, static_cast<int>(SDL_NUM_SCANCODES)), mInput.keys);
+
+    mInput.hasController = mController && SDL_GameControllerGetAttached(mController);
+    mInput.buttons = 0;
+    for (int i = 0; i < SDL_CONTROLLER_AXIS_MAX; i++)
     {
-        // Avoid duplicates
-        if (std::find(toProcessActors.begin(), toProcessActors.end(), actor) == toProcessActors.end())
+        mInput.axes[i] = mInput.hasController
+            ? SDL_GameControllerGetAxis(mController, static_cast<SDL_GameControllerAxis>(i))
+            : 0;
+    }
+
+    if (mInput.hasController)
+    {
+        for (int i = 0; i < SDL_CONTROLLER_BUTTON_MAX; i++)
         {
-            toProcessActors.push_back(actor);
+            if (SDL_GameControllerGetButton(mController, static_cast<SDL_GameControllerButton>(i)))
+            {
+                mInput.buttons |= 1u << i;
+            }
         }
     }
+}
 
-    for (auto actor : toProcessActors)
+void Game::ProcessInputActors(const std::vector<SDL_Event>& events)
+{
+    const Uint8 *state = GetKeyboardState();
+
+    RefreshActiveActors();
+    for (auto actor : mActiveActors)
     {
         actor->ProcessInput(state, events);
     }
@@ -462,13 +666,8 @@ void Game::HandleKeyPressActors(const int key, const bool isPressed)
 {
     if (mGamePlayState == GamePlayState::Playing)
     {
-        // Get actors on camera
-        std::vector<Actor *> actorsOnCamera = mSpatialHashing->QueryOnCamera(
-            mCameraPos,
-            mWindowWidth,
-            mWindowHeight);
-
-        for (auto actor : actorsOnCamera)
+        RefreshActiveActors();
+        for (auto actor : mActiveActors)
         {
             actor->HandleKeyPress(key, isPressed);
         }
@@ -484,43 +683,80 @@ void Game::UnTogglePause()
     )
         return;
 
-    if (
-        !SDL_TICKS_PASSED(SDL_GetTicks(), mLastUnTooglePauseTick + 500)
-    ) 
+    if (mGameTime < mLastUnTooglePauseTime + 0.5f)
     {
         return;
     }
 
-    mLastUnTooglePauseTick = SDL_GetTicks();
+    mLastUnTooglePauseTime = mGameTime;
 
     if (mGamePlayState == GamePlayState::Paused)
     {
         mGamePlayState = GamePlayState::Playing;
-        mAudio->ResumeSound(mMusicHandle);
+        mAudio->ResumeMusic();
         return;
     }
 
     mGamePlayState = GamePlayState::Paused;
-    mAudio->PauseSound(mMusicHandle);
+    mAudio->PauseMusic();
 }
 
 void Game::UpdateGame()
 {
-    // Cap at 60 fps
-    while (!SDL_TICKS_PASSED(SDL_GetTicks(), mTicksCount + 16))
+    bool isReplaying = mInputRecorder->GetMode() == InputRecorder::Mode::Replaying;
+
+    // Cap at 60 fps, a replay or the stress test runs as fast as it can
+    if (!isReplaying && !mStressTest)
     {
-    };
+        PROFILE_ZONE("WaitFrame");
+        while (!SDL_TICKS_PASSED(SDL_GetTicks(), mTicksCount + 16))
+        {
+        };
+    }
 
-    mDeltatime = (SDL_GetTicks() - mTicksCount) / 1000.0f;
-    if (mDeltatime > 0.05f)
+    PROFILE_ZONE("UpdateGame");
+
+    if (isReplaying)
+    {
+        mDeltatime = mInput.deltaTime;
+    }
+    else if (mStressTest)
     {
-        mDeltatime = 0.05f;
+        // Same simulation whatever the frame time, so runs compare
+        mDeltatime = 1.f / 60.f;
     }
-    else if (mDeltatime < 0.0167) {
-        mDeltatime = 0.0167f;
+    else
+    {
+        mDeltatime = (SDL_GetTicks() - mTicksCount) / 1000.0f;
+        if (mDeltatime > 0.05f)
+        {
+            mDeltatime = 0.05f;
+        }
+        else if (mDeltatime < 0.0167) {
+            mDeltatime = 0.0167f;
+        }
     }
 
     mTicksCount = SDL_GetTicks();
+    mGameTime += mDeltatime;
+
+    Vector2 checksum = mZoe ? mZoe->GetPosition() : Vector2::Zero;
+    if (isReplaying)
+    {
+        mInputRecorder->VerifyChecksum(mInput, checksum);
+    }
+    else if (mInputRecorder->GetMode() == InputRecorder::Mode::Recording)
+    {
+        mInput.deltaTime = mDeltatime;
+        mInput.checksum = checksum;
+        mInputRecorder->WriteFrame(mInput);
+    }
+
+    if (mAssetWarmup && mAssetWarmup->Update())
+    {
+        delete mAssetWarmup;
+        mAssetWarmup = nullptr;
+    }
 
     if (mGamePlayState == GamePlayState::Playing ||
         mGamePlayState == GamePlayState::PlayingCutscene)
@@ -668,50 +904,130 @@ void Game::UpdateCamera()
 
 void Game::UpdateActors(float deltaTime)
 {
-    std::vector<Actor *> toUpdateActors = mMustAlwaysUpdateActors;
+    PROFILE_ZONE("UpdateActors");
 
-    // Get actors on camera
-    std::vector<Actor *> actorsOnCamera = mSpatialHashing->QueryOnCamera(
-        mCameraPos,
-        mWindowWidth,
-        mWindowHeight,
-        Game::TILE_SIZE * 2.f);
+    // Actors added or removed while updating only mark the set dirty, so it can be iterated
+    RefreshActiveActors();
+    const std::vector<Actor *> &toUpdateActors = mActiveActors;
 
-    for (auto actor : actorsOnCamera)
+    ENGINE_STAT(Stat::ActorsUpdated, static_cast<int>(toUpdateActors.size()));
+
+    // Sense phase: enemies look at the world before anyone moves, in parallel
+    std::vector<Enemy *> sensingEnemies;
+    for (auto actor : toUpdateActors)
     {
-        // Avoid duplicates
-        if (std::find(toUpdateActors.begin(), toUpdateActors.end(), actor) == toUpdateActors.end())
+        if (actor->GetState() != ActorState::Active)
+            continue;
+
+        if (auto enemy = dynamic_cast<Enemy *>(actor))
         {
-            toUpdateActors.push_back(actor);
+            sensingEnemies.push_back(enemy);
         }
     }
 
+    {
+        PROFILE_ZONE("SenseEnemies");
+        mJobSystem->ParallelFor(static_cast<int>(sensingEnemies.size()), [&sensingEnemies](int i)
+        {
+            sensingEnemies[i]->Sense();
+        });
+    }
+
+    // Velocities of the bodies of the whole set, in one batch before anyone moves
+    mPhysicsWorld->Integrate(deltaTime, mActiveEpoch);
+
+    // Act phase: serial, actors react to what they sensed and move
     for (auto actor : toUpdateActors)
     {
         actor->Update(deltaTime);
     }
 
-    for (auto actor : toUpdateActors)
+    // Map triggers react to where Zoe ended up
+    mTriggerIndex->Update(mZoe ? mZoe->GetComponent<AABBColliderComponent>() : nullptr);
+
+    UpdateCoarseActors(deltaTime);
+
+    for (auto actors : {&mActiveActors, &mCoarseActors})
     {
-        if (actor->GetState() == ActorState::Destroy)
+        for (auto actor : *actors)
         {
-            delete actor;
-            if (actor == mZoe)
+            if (actor->GetState() == ActorState::Destroy)
             {
-                mZoe = nullptr;
+                // Kept for the checkpoint when it can bring it back
+                if (actor != mZoe && mSceneSnapshot && mSceneSnapshot->Retire(actor))
+                    continue;
+
+                delete actor;
+                if (actor == mZoe)
+                {
+                    mZoe = nullptr;
+                }
             }
         }
     }
+
+    UpdateSceneSnapshot();
+}
+
+void Game::UpdateSceneSnapshot()
+{
+    if (mSceneSnapshotRestoreRequested)
+    {
+        mSceneSnapshotRestoreRequested = false;
+        if (mSceneSnapshot)
+        {
+            mSceneSnapshot->Restore();
+        }
+    }
+
+    if (mSceneSnapshotRequested)
+    {
+        mSceneSnapshotRequested = false;
+
+        // Actors retired by the old snapshot can't come back anymore
+        delete mSceneSnapshot;
+        mSceneSnapshot = new SceneSnapshot(this);
+        SDL_Log("Scene snapshot taken with %d actors", mSceneSnapshot->GetNumActors());
+    }
+}
+
+void Game::UpdateCoarseActors(float deltaTime)
+{
+    PROFILE_ZONE("CoarseUpdate");
+
+    for (auto actor : mCoarseActors)
+    {
+        actor->AddCoarseTime(deltaTime);
+    }
+
+    // The budget starts where the last frame's ended, so no actor waits forever
+    size_t numActors = mCoarseActors.size();
+    size_t scanned = 0;
+    int updated = 0;
+    for (; scanned < numActors && updated < mMaxCoarseUpdates; scanned++)
+    {
+        Actor *actor = mCoarseActors[(mCoarseCursor + scanned) % numActors];
+        if (actor->GetCoarseTime() >= mCoarseStep)
+        {
+            actor->CoarseUpdate();
+            updated++;
+        }
+    }
+
+    mCoarseCursor = numActors > 0 ? (mCoarseCursor + scanned) % numActors : 0;
+    ENGINE_STAT(Stat::ActorsCoarseUpdated, updated);
 }
 
 void Game::AddActor(Actor *actor)
 {
     mSpatialHashing->Insert(actor);
+    mActiveActorsDirty = true;
 }
 
 void Game::RemoveActor(Actor *actor)
 {
     mSpatialHashing->Remove(actor);
+    mActiveActorsDirty = true;
 
     auto it = std::find(
         mMustAlwaysUpdateActors.begin(),
@@ -734,12 +1050,13 @@ std::vector<Actor *> Game::GetNearbyActors(const Vector2 &position, const int ra
     return mSpatialHashing->Query(position, range);
 }
 
-std::vector<AABBColliderComponent *> Game::GetNearbyColliders(const Vector2 &position, const int range)
+std::vector<AABBColliderComponent *> Game::GetNearbyColliders(const Vector2 &position, const int range,
+                                                              ColliderLayerMask layers)
 {
-    return mSpatialHashing->QueryColliders(position, range);
+    return mSpatialHashing->QueryColliders(position, range, layers);
 }
 
-void Game::DrawDebugInfo(std::vector<Actor *> &actorsOnCamera)
+void Game::DrawDebugInfo(const std::vector<Actor *> &actorsOnCamera)
 {
     // mSpatialHashing->Draw(mRenderer, mCameraPos, mWindowWidth, mWindowHeight);
 
@@ -835,18 +1152,36 @@ void Game::DrawDebugInfo(std::vector<Actor *> &actorsOnCamera)
         }
     }
 
-    // Swap front buffer and back buffer
-    SDL_RenderPresent(mRenderer);
-
-    int componentsOnCamera = 0;
-    for (auto actor : actorsOnCamera)
+    // Counters of the last frame, top left
+    UIFont *font = LoadFont(FONT_PATH_INTER);
+    GlyphAtlas *atlas = font ? font->GetAtlas(8) : nullptr;
+    if (atlas)
     {
-        componentsOnCamera += static_cast<int>(actor->HowManyComponents());
+        GlyphAtlas::TextLayout statsLayout;
+        atlas->Layout(EngineStats::GetSummary(), 300, statsLayout);
+
+        SDL_SetRenderDrawBlendMode(mRenderer, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderDrawColor(mRenderer, 0, 0, 0, 160);
+        SDL_Rect background = {0, 0, statsLayout.width + 8, statsLayout.height + 8};
+        SDL_RenderFillRect(mRenderer, &background);
+
+        atlas->Draw(statsLayout, 4, 4, UIFont::ToSDLColor(Color::White));
     }
 }
 
 void Game::GenerateOutput()
 {
+    PROFILE_ZONE("GenerateOutput");
+
+    mOutputStartCounter = SDL_GetPerformanceCounter();
+
+    // Headless replays and stress tests only simulate
+    if (!mRenderEnabled)
+    {
+        EndFrame();
+        return;
+    }
+
     // Clear frame with background color
     SDL_SetRenderDrawColor(mRenderer, mBackgroundColor.x, mBackgroundColor.y, mBackgroundColor.z, 255);
 
@@ -867,20 +1202,20 @@ void Game::GenerateOutput()
             static_cast<int>(mBackgroundSize.x),
             static_cast<int>(mBackgroundSize.y)};
 
+        ENGINE_STAT_DRAW(mBackgroundTexture);
         SDL_RenderCopy(mRenderer, mBackgroundTexture, nullptr, &dstRect);
     }
 
-    // Get actors on camera
-    std::vector<Actor *> actorsOnCamera = mSpatialHashing->QueryOnCamera(
-        mCameraPos,
-        mWindowWidth,
-        mWindowHeight,
-        Game::TILE_SIZE * 2.f);
+    // The render set is the on-camera part of the frame's active set
+    RefreshActiveActors();
+    const std::vector<Actor *> &actorsOnCamera = mCameraActors;
 
     // Get list of drawables in draw order
     std::vector<DrawComponent *> drawables;
+    int componentsOnCamera = 0;
     for (auto actor : actorsOnCamera)
     {
+        componentsOnCamera += static_cast<int>(actor->HowManyComponents());
         std::vector<DrawComponent *> actorDrawables = actor->GetComponents<DrawComponent>();
 
         for (auto drawable : actorDrawables)
@@ -892,6 +1227,8 @@ void Game::GenerateOutput()
         }
     }
 
+    ENGINE_STAT_SET(Stat::ComponentsOnCamera, componentsOnCamera);
+
     // Sort drawables by draw order
     std::sort(
         drawables.begin(),
@@ -902,9 +1239,12 @@ void Game::GenerateOutput()
         });
 
     // Draw all drawables
-    for (auto drawable : drawables)
     {
-        drawable->Draw(mRenderer, mModColor);
+        PROFILE_ZONE("DrawActors");
+        for (auto drawable : drawables)
+        {
+            drawable->Draw(mRenderer, mModColor);
+        }
     }
 
     // Draw all UI screens
@@ -936,13 +1276,106 @@ void Game::GenerateOutput()
         SDL_RenderFillRect(mRenderer, &rect);
     }
 
-    if (!mDebugMode)
+    if (mShowProfiler)
+    {
+        Profiler::DrawOverlay(mRenderer, LoadFont(FONT_PATH_INTER), mWindowWidth, mWindowHeight);
+    }
+
+    if (mDebugMode)
+    {
+        DrawDebugInfo(actorsOnCamera);
+    }
+
+    // Swap front buffer and back buffer
+    SDL_RenderPresent(mRenderer);
+
+    EndFrame();
+}
+
+void Game::EndFrame()
+{
+    // A replay doesn't wait for the frame cap, its real frame time is what gets compared
+    if (mInputRecorder->GetMode() == InputRecorder::Mode::Replaying)
+    {
+        float frameMs = (SDL_GetPerformanceCounter() - mFrameStartCounter) * 1000.f /
+                        static_cast<float>(SDL_GetPerformanceFrequency());
+        mInputRecorder->AddFrameTime(frameMs);
+        EngineStats::EndFrame(frameMs / 1000.f);
+    }
+    else
+    {
+        EngineStats::EndFrame(mDeltatime);
+    }
+
+    if (mStressTest)
+    {
+        Uint64 now = SDL_GetPerformanceCounter();
+        float ticksPerMs = static_cast<float>(SDL_GetPerformanceFrequency()) / 1000.f;
+        mStressTest->EndFrame((mOutputStartCounter - mFrameStartCounter) / ticksPerMs,
+                              (now - mOutputStartCounter) / ticksPerMs);
+    }
+
+    // Actors moved between cells, the next frame queries the camera again
+    mActiveActorsDirty = true;
+}
+
+void Game::RefreshActiveActors()
+{
+    // Margin around the camera, half of it is the drift allowed before querying again
+    const float margin = Game::TILE_SIZE * 2.f;
+
+    if (!mActiveActorsDirty &&
+        Math::Abs(mCameraPos.x - mActiveActorsCameraPos.x) <= margin * 0.5f &&
+        Math::Abs(mCameraPos.y - mActiveActorsCameraPos.y) <= margin * 0.5f)
     {
-        SDL_RenderPresent(mRenderer);
         return;
     }
 
-    DrawDebugInfo(actorsOnCamera);
+    PROFILE_ZONE("RefreshActiveActors");
+
+    mActiveActorsDirty = false;
+    mActiveActorsCameraPos = mCameraPos;
+    mSpatialHashing->QueryOnCamera(mCameraPos, mWindowWidth, mWindowHeight, margin, margin + mCoarseMargin,
+                                   mCameraActors, mCoarseActors);
+
+    // Must-always-update actors first, then the ones on camera. Marking each actor with
+    // this set's epoch replaces searching the set for duplicates
+    unsigned int previousEpoch = mActiveEpoch;
+    mActiveEpoch++;
+    mActiveActors.clear();
+    for (auto actor : mMustAlwaysUpdateActors)
+    {
+        if (actor->GetActiveEpoch() != mActiveEpoch)
+        {
+            actor->SetActiveEpoch(mActiveEpoch);
+            mActiveActors.push_back(actor);
+        }
+    }
+
+    for (auto actor : mCameraActors)
+    {
+        if (actor->GetActiveEpoch() != mActiveEpoch)
+        {
+            actor->SetActiveEpoch(mActiveEpoch);
+            mActiveActors.push_back(actor);
+        }
+    }
+
+    // The band only keeps the actors that aren't already fully updated and have physics or
+    // timers, so the budget isn't spent on tiles
+    mCoarseActors.erase(std::remove_if(mCoarseActors.begin(), mCoarseActors.end(), [this](Actor *actor)
+    {
+        return actor->GetActiveEpoch() == mActiveEpoch || !actor->HasCoarseUpdate();
+    }), mCoarseActors.end());
+
+    // Still marked with the previous set's epoch: the enemy was in it and just left
+    for (auto enemy : mEnemies)
+    {
+        if (enemy->GetActiveEpoch() == previousEpoch)
+        {
+            enemy->OnLeftActiveSet();
+        }
+    }
 }
 
 void Game::SetBackgroundImage(
@@ -980,7 +1413,24 @@ void Game::SetBackgroundImage(
 
 SDL_Texture *Game::LoadTexture(const std::string &texturePath)
 {
-    SDL_Surface *surface = IMG_Load(texturePath.c_str());
+    if (mRecordedManifest)
+    {
+        mRecordedManifest->AddTexture(texturePath);
+    }
+
+    auto iter = mSceneSurfaces.find(texturePath);
+    if (iter != mSceneSurfaces.end())
+    {
+        SDL_Surface *copy = SDL_DuplicateSurface(iter->second);
+        if (copy)
+            return CreateTexture(copy);
+    }
+
+    SDL_Surface *surface = mScenePreloader ? mScenePreloader->TakeSurface(texturePath) : nullptr;
+    if (!surface)
+    {
+        surface = IMG_Load(texturePath.c_str());
+    }
 
     if (!surface)
     {
@@ -988,8 +1438,14 @@ SDL_Texture *Game::LoadTexture(const std::string &texturePath)
         return nullptr;
     }
 
+    return CreateTexture(surface);
+}
+
+SDL_Texture *Game::CreateTexture(SDL_Surface *surface)
+{
     SDL_Texture *texture = SDL_CreateTextureFromSurface(mRenderer, surface);
     SDL_FreeSurface(surface);
+    ENGINE_STAT(Stat::TexturesCreated, 1);
 
     if (!texture)
     {
@@ -1024,10 +1480,125 @@ UIFont *Game::LoadFont(const std::string &fileName)
     }
 }
 
+nlohmann::json Game::LoadJson(const std::string &jsonPath)
+{
+    nlohmann::json data;
+    if (mScenePreloader && mScenePreloader->TakeJson(jsonPath, data))
+    {
+        return data;
+    }
+
+    std::ifstream file(jsonPath);
+    return nlohmann::json::parse(file);
+}
+
+Tileset *Game::LoadTileset(const std::string &tilesetName)
+{
+    auto iter = mTilesets.find(tilesetName);
+    if (iter != mTilesets.end())
+    {
+        return iter->second;
+    }
+
+    const std::string baseTilesetsPath = "../assets/Levels/Tilesets/";
+
+    // most tilesets are saved with their own name, avoid scanning the folder for those
+    std::string tilesetPath = baseTilesetsPath + tilesetName + ".json";
+    if (!std::filesystem::exists(tilesetPath))
+    {
+        tilesetPath = FindTilesetPath(tilesetName);
+    }
+
+    if (tilesetPath.empty())
+    {
+        SDL_Log("Failed to find tileset: %s", tilesetName.c_str());
+        return nullptr;
+    }
+
+    Tileset *tileset = new Tileset(this, tilesetPath);
+    mTilesets.emplace(tilesetName, tileset);
+
+    return tileset;
+}
+
+SpriteSheet *Game::LoadSpriteSheet(const std::string &texturePath, const std::string &dataPath)
+{
+    if (mRecordedManifest)
+    {
+        mRecordedManifest->AddSpriteSheet(texturePath, dataPath);
+    }
+
+    std::string key = texturePath + "|" + dataPath;
+
+    auto iter = mSpriteSheets.find(key);
+    if (iter != mSpriteSheets.end())
+    {
+        return iter->second;
+    }
+
+    SpriteSheet *spriteSheet = new SpriteSheet(this, texturePath, dataPath);
+    mSpriteSheets.emplace(key, spriteSheet);
+
+    return spriteSheet;
+}
+
+SpriteSheet *Game::AddSpriteSheet(const std::string &texturePath, const std::string &dataPath,
+                                  SDL_Surface *surface, std::vector<SDL_Rect> frames)
+{
+    std::string key = texturePath + "|" + dataPath;
+
+    auto iter = mSpriteSheets.find(key);
+    if (iter != mSpriteSheets.end())
+    {
+        SDL_FreeSurface(surface);
+        return iter->second;
+    }
+
+    SpriteSheet *spriteSheet = new SpriteSheet(CreateTexture(surface), std::move(frames));
+    mSpriteSheets.emplace(key, spriteSheet);
+
+    return spriteSheet;
+}
+
+std::string Game::FindTilesetPath(const std::string &tilesetName)
+{
+    const std::string baseTilesetsPath = "../assets/Levels/Tilesets/";
+
+    // only the "name" field is read here, textures are loaded by LoadTileset when needed
+    if (mTilesetPaths.empty())
+    {
+        for (const auto &entry : std::filesystem::directory_iterator(baseTilesetsPath))
+        {
+            if (entry.path().extension() != ".json")
+                continue;
+
+            std::ifstream file(entry.path());
+            nlohmann::json data = nlohmann::json::parse(file);
+
+            if (!data.contains("name"))
+                continue;
+
+            mTilesetPaths.emplace(data["name"].get<std::string>(), entry.path().string());
+        }
+    }
+
+    auto iter = mTilesetPaths.find(tilesetName);
+    if (iter == mTilesetPaths.end())
+    {
+        return "";
+    }
+
+    return iter->second;
+}
+
 void Game::Shutdown()
 {
     UnloadScene();
 
+    // Before the caches it fills and the workers it uses
+    delete mAssetWarmup;
+    mAssetWarmup = nullptr;
+
     for (auto font : mFonts)
     {
         font.second->Unload();
@@ -1035,6 +1606,38 @@ void Game::Shutdown()
     }
     mFonts.clear();
 
+    for (auto tileset : mTilesets)
+    {
+        delete tileset.second;
+    }
+    mTilesets.clear();
+    mTilesetPaths.clear();
+
+    for (auto spriteSheet : mSpriteSheets)
+    {
+        delete spriteSheet.second;
+    }
+    mSpriteSheets.clear();
+
+    delete mScenePreloader;
+    mScenePreloader = nullptr;
+
+    delete mJobSystem;
+    mJobSystem = nullptr;
+
+    // After the scene, the rigid bodies give their slots back as they are deleted
+    delete mPhysicsWorld;
+    mPhysicsWorld = nullptr;
+
+    delete mInputRecorder;
+    mInputRecorder = nullptr;
+
+    delete mStressTest;
+    mStressTest = nullptr;
+
+    Profiler::Shutdown();
+    EngineStats::StopCsv();
+
     delete mAudio;
     mAudio = nullptr;
 
@@ -1464,13 +2067,11 @@ void Game::CheckMetalCrateLevel()
 
 Vector2 Game::getNormalizedControlerPad()
 {
-    SDL_GameController *controller = GetController();
-
     float padX = 0.0f;
     float padY = 0.0f;
 
-    int rawX = SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_LEFTX);
-    int rawY = SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_LEFTY);
+    int rawX = GetControllerAxis(SDL_CONTROLLER_AXIS_LEFTX);
+    int rawY = GetControllerAxis(SDL_CONTROLLER_AXIS_LEFTY);
 
     const int DEADZONE = 2000;
 
@@ -1509,5 +2110,23 @@ void Game::SetCheckpoint(const Vector2& position)
         return;
     }
 
+    // Torches set it every frame Zoe touches them, only a new one is snapshotted
+    Checkpoint *checkpoint = mZoe->GetCurrentCheckpoint();
+    if (checkpoint == nullptr || checkpoint->GetPosition().x != position.x || checkpoint->GetPosition().y != position.y)
+    {
+        mSceneSnapshotRequested = true;
+    }
+
     mZoe->SetCheckpoint(position);
+}
+
+bool Game::RestoreSceneSnapshot()
+{
+    if (mSceneSnapshot == nullptr)
+    {
+        return false;
+    }
+
+    mSceneSnapshotRestoreRequested = true;
+    return true;
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <unordered_map>
 #include <chrono>
 #include "AudioSystem.h"
+#include "InputRecorder.h"
 #include "../libs/Math.h"
 #include "../libs/Json.h"
 #include "../ui/UICursor.h"
@@ -20,6 +21,7 @@
 #include "./Cutscene.h"
 #include "Config.h"
 #include "Checkpoint.h"
+#include "StressTest.h"
 
 const float MAX_TIME_QUASAR_ENCOUNTER_TIP = 20.f;
 const int SPAWN_PORTAL_LEVEL_2_OBJ_ID = 9999;
@@ -49,6 +51,7 @@ public:
     static const int LEVEL_WIDTH = 60;
     static const int LEVEL_HEIGHT = 60;
     static const int TILE_SIZE = 32;
+    static const int TRIGGER_CELL_SIZE = TILE_SIZE * 4;
     static const int TRANSITION_TIME_BETWEEM_SCENES = 2;
     static const bool APPLY_GRAVITY_SCENE_DEFAULT = true;
     const std::string FONT_PATH_INTER = "../assets/Fonts/Inter.ttf";
@@ -64,7 +67,8 @@ public:
         Tests,
         DeathScreen,
         EndDemo,
-        BedroomFinal
+        BedroomFinal,
+        StressTest
     };
 
     enum class CameraCenter
@@ -104,9 +108,29 @@ public:
     void GenerateOutput();
     void Quit() { mIsRunning = false; }
 
+    // Input recording and replay, must be set before Initialize
+    void SetInputRecording(const std::string &path) { mRecordingPath = path; }
+    void SetInputReplay(const std::string &path, bool render) { mReplayPath = path; mRenderEnabled = render; }
+
+    // Adds what each scene touches to its manifest under assets/Manifests, must be set before Initialize
+    void SetManifestRecording(bool record) { mRecordManifests = record; }
+
+    // Starts in the stress test scene instead of the main menu and quits once it is measured,
+    // must be set before Initialize
+    void SetStressTest(const StressTest::Settings &settings, bool render)
+    {
+        mStressTest = new StressTest(this, settings);
+        mRenderEnabled = render;
+    }
+
     void SetCheckpoint(const Vector2 &position);
     Checkpoint* GetCurrentCheckpoint() const;
 
+    // Puts the scene back as it was at the last checkpoint at the end of the frame.
+    // False when there is no snapshot to restore
+    bool RestoreSceneSnapshot();
+    bool HasSceneSnapshot() const { return mSceneSnapshot != nullptr; }
+
     float GetDtLastFrame() { return mDeltatime; }
 
     // Actor functions
@@ -123,12 +147,14 @@ public:
     void LoadFirstLevel();
     void LoadSecondLevel();
     void LoadTestsLevel();
+    void LoadStressTestLevel();
     void LoadDeathScreen();
     void LoadEndDemoScene();
     void LoadBedroomFinal();
 
     std::vector<Actor *> GetNearbyActors(const Vector2 &position, const int range = 1);
-    std::vector<class AABBColliderComponent *> GetNearbyColliders(const Vector2 &position, const int range = 2);
+    std::vector<class AABBColliderComponent *> GetNearbyColliders(const Vector2 &position, const int range = 2,
+                                                                  ColliderLayerMask layers = ALL_COLLIDER_LAYERS);
 
     void Reinsert(Actor *actor);
 
@@ -156,6 +182,15 @@ public:
     // Loading functions
     class UIFont *LoadFont(const std::string &fileName);
     SDL_Texture *LoadTexture(const std::string &texturePath);
+    nlohmann::json LoadJson(const std::string &jsonPath);
+    class Tileset *LoadTileset(const std::string &tilesetName);
+    class SpriteSheet *LoadSpriteSheet(const std::string &texturePath, const std::string &dataPath);
+
+    // Frees the surface, creating the texture on the main thread is all that is left of loading.
+    // Keeps the cached sheet if there already is one
+    class SpriteSheet *AddSpriteSheet(const std::string &texturePath, const std::string &dataPath,
+                                      SDL_Surface *surface, std::vector<SDL_Rect> frames);
+    SDL_Texture *CreateTexture(SDL_Surface *surface);
 
     void SetGameScene(GameScene scene, float sceneLeftTime = .0f);
     void SetApplyGravityScene(bool applyGravity) {
@@ -221,11 +256,26 @@ public:
     int GetMapHeight();
 
     class SpatialHashing *GetSpatialHashing() { return mSpatialHashing; }
-
-    SDL_GameController* GetController() const { return mController; }
+    class TriggerIndex *GetTriggerIndex() { return mTriggerIndex; }
+    class JobSystem *GetJobSystem() { return mJobSystem; }
+    class PhysicsWorld *GetPhysicsWorld() { return mPhysicsWorld; }
+
+    // Input of the current frame, read from SDL or from a replay. Nothing else
+    // should poll the keyboard or the controller, or replays will desync
+    const Uint8 *GetKeyboardState() const { return mInput.keys; }
+    bool HasController() const { return mInput.hasController; }
+    bool GetControllerButton(SDL_GameControllerButton button) const
+    {
+        return button >= 0 && (mInput.buttons & (1u << button)) != 0;
+    }
+    Sint16 GetControllerAxis(SDL_GameControllerAxis axis) const
+    {
+        return axis >= 0 && axis < SDL_CONTROLLER_AXIS_MAX ? mInput.axes[axis] : 0;
+    }
 
     void AddMustAlwaysUpdateActor(class Actor* actor) {
         mMustAlwaysUpdateActors.push_back(actor);
+        mActiveActorsDirty = true;
     }
 
     void AddEnemy(class Enemy *enemy);
@@ -266,6 +316,9 @@ public:
     const SpatialHashing* GetConstSpatialHashing() const { return mSpatialHashing; }
 
 private:
+    // Sets the game up without a window for the microbenchmarks (bench/)
+    friend class BenchWorld;
+
     Actor* mPortal;
     Config *mConfig;
 
@@ -290,22 +343,79 @@ private:
     // Scene Manager
     void UpdateSceneManager(float deltaTime);
     void ChangeScene();
+    void PreloadScene(GameScene scene);
     void SetMap(const std::string &path);
 
     bool mDebugMode;
+    bool mShowProfiler;
     SDL_GameController* mController;
 
+    // Input of the current frame, recorded to or replayed from a file
+    void ReadInput(std::vector<SDL_Event> &events);
+    void EndFrame();
+    InputFrame mInput;
+    InputRecorder *mInputRecorder;
+    std::string mRecordingPath;
+    std::string mReplayPath;
+    bool mRenderEnabled;
+    Uint64 mFrameStartCounter;
+    Uint64 mOutputStartCounter;
+
+    // Scaling measurement, runs uncapped at a fixed delta time while set
+    class StressTest *mStressTest;
+
     SceneManagerState mSceneManagerState;
     float mSceneManagerTimer;
+
+    // Decodes the next scene's files while the transition is running
+    class ScenePreloader *mScenePreloader;
+
+    // Per-scene asset manifests. The textures a manifest lists stay decoded until the scene is
+    // unloaded, actors spawned mid-gameplay create theirs from these surfaces
+    static std::string GetManifestPath(GameScene scene);
+    void SaveRecordedManifest();
+    bool mRecordManifests;
+    class AssetManifest *mRecordedManifest; // assets the current scene touched, while recording
+    std::vector<std::string> mManifestTextures;
+    std::unordered_map<std::string, SDL_Surface *> mSceneSurfaces;
+
+    // Worker threads shared by the engine, e.g. the enemies' sense phase
+    class JobSystem *mJobSystem;
+
+    // Rigid body state, integrated once per frame for the active set
+    class PhysicsWorld *mPhysicsWorld;
     bool mApplyGravityScene;
 
     // Spatial Hashing for collision detection
     class SpatialHashing *mSpatialHashing;
 
+    // Map object rectangles, queried with Zoe's box once per frame
+    class TriggerIndex *mTriggerIndex;
+
+    // Sprite sheets and sounds decoded at startup, deleted once all are registered
+    class AssetWarmup *mAssetWarmup;
+
+    // Scene state at the last checkpoint. Taking and restoring it wait for the end of
+    // UpdateActors, when no actor is in the middle of its update
+    friend class SceneSnapshot;
+    class SceneSnapshot *mSceneSnapshot;
+    bool mSceneSnapshotRequested;
+    bool mSceneSnapshotRestoreRequested;
+    void UpdateSceneSnapshot();
+
     // All the UI elements
     std::vector<class UIScreen *> mUIStack;
     std::unordered_map<std::string, class UIFont *> mFonts;
 
+    // Tilesets survive scene changes, they are only freed on shutdown
+    std::unordered_map<std::string, class Tileset *> mTilesets;
+    std::unordered_map<std::string, std::string> mTilesetPaths; // tileset name -> json path, filled on demand
+    std::string FindTilesetPath(const std::string &tilesetName);
+
+    // Sprite sheets and their animation clips, by texture and data path. Like tilesets,
+    // they are only freed on shutdown
+    std::unordered_map<std::string, class SpriteSheet *> mSpriteSheets;
+
     // SDL stuff
     SDL_Window *mWindow;
     SDL_Renderer *mRenderer;
@@ -317,7 +427,8 @@ private:
 
     // Track elapsed time since game start
     Uint32 mTicksCount;
-    Uint32 mLastUnTooglePauseTick;
+    float mGameTime; // sum of the frame delta times, same in a replay
+    float mLastUnTooglePauseTime;
 
     // Track actors state
     bool mIsRunning;
@@ -341,7 +452,6 @@ private:
     class Mother *mMother;
     std::vector<class Enemy *> mEnemies;
     class HUD *mHUD;
-    SoundHandle mMusicHandle;
 
     SDL_Texture *mBackgroundTexture;
     Vector2 mBackgroundSize;
@@ -360,10 +470,31 @@ private:
     bool mMaintainCameraInMap;
     float mDeltatime;
 
-    void DrawDebugInfo(std::vector<class Actor *> &actorsOnCamera);
+    void DrawDebugInfo(const std::vector<class Actor *> &actorsOnCamera);
 
     std::vector<class Actor*> mMustAlwaysUpdateActors; //use with caution, can highly impact performance
 
+    // Actors that process input, update and draw this frame, from a single camera query.
+    // Rebuilt once per frame, when actors are added or removed, or when the camera leaves
+    // the query margin. mCameraActors is the render set, mActiveActors adds the
+    // must-always-update actors to it
+    void RefreshActiveActors();
+    void UpdateCoarseActors(float deltaTime);
+    std::vector<class Actor*> mCameraActors;
+    std::vector<class Actor*> mActiveActors;
+
+    // Simulation level of detail: actors in a band around the active set get coarse updates
+    // (physics, timers) every mCoarseStep seconds, at most mMaxCoarseUpdates of them per
+    // frame. Beyond the band actors are dormant. Set in config.json, SIMULATION_LOD
+    std::vector<class Actor*> mCoarseActors;
+    float mCoarseMargin;
+    float mCoarseStep;
+    int mMaxCoarseUpdates;
+    size_t mCoarseCursor; // where the next frame's budget starts, so every actor gets a turn
+    unsigned int mActiveEpoch;
+    Vector2 mActiveActorsCameraPos;
+    bool mActiveActorsDirty;
+
     Vector2 GetBoxCenter(const Vector2& pos, float boxW, float boxH);
 
     bool isEnding;
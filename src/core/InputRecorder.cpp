@@ -0,0 +1,254 @@
+#include "InputRecorder.h"
+#include <algorithm>
+#include <cstring>
+
+static const char RECORDING_MAGIC[4] = {'A', 'R', 'E', 'C'};
+static const Uint32 RECORDING_VERSION = 1;
+
+InputRecorder::InputRecorder()
+    : mMode(Mode::Off), mSeed(0), mFrameIndex(0), mDesyncFrame(0), mTotalFrameMs(0.f), mWorstFrameMs(0.f)
+{
+}
+
+InputRecorder::~InputRecorder()
+{
+    Stop();
+}
+
+bool InputRecorder::StartRecording(const std::string &path, unsigned int seed)
+{
+    Stop();
+
+    mFile.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!mFile.is_open())
+    {
+        SDL_Log("[InputRecorder] Failed to open %s", path.c_str());
+        return false;
+    }
+
+    mMode = Mode::Recording;
+    mPath = path;
+    mSeed = seed;
+    mFrameIndex = 0;
+
+    mFile.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    Write(RECORDING_VERSION);
+    Write(static_cast<Uint32>(mSeed));
+
+    SDL_Log("[InputRecorder] Recording input to %s (seed %u)", path.c_str(), mSeed);
+    return true;
+}
+
+bool InputRecorder::StartReplay(const std::string &path)
+{
+    Stop();
+
+    mFile.open(path, std::ios::in | std::ios::binary);
+    if (!mFile.is_open())
+    {
+        SDL_Log("[InputRecorder] Failed to open %s", path.c_str());
+        return false;
+    }
+
+    char magic[4];
+    Uint32 version = 0;
+    Uint32 seed = 0;
+    mFile.read(magic, sizeof(magic));
+    if (!mFile || std::memcmp(magic, RECORDING_MAGIC, sizeof(magic)) != 0 ||
+        !Read(version) || version != RECORDING_VERSION || !Read(seed))
+    {
+        SDL_Log("[InputRecorder] %s is not a recording of this version", path.c_str());
+        mFile.close();
+        return false;
+    }
+
+    mMode = Mode::Replaying;
+    mPath = path;
+    mSeed = seed;
+    mFrameIndex = 0;
+    mDesyncFrame = 0;
+    mTotalFrameMs = 0.f;
+    mWorstFrameMs = 0.f;
+
+    SDL_Log("[InputRecorder] Replaying %s (seed %u)", path.c_str(), mSeed);
+    return true;
+}
+
+void InputRecorder::Stop()
+{
+    if (mMode == Mode::Recording)
+    {
+        SDL_Log("[InputRecorder] Recorded %u frames to %s", mFrameIndex, mPath.c_str());
+    }
+    else if (mMode == Mode::Replaying && mFrameIndex > 0)
+    {
+        SDL_Log("[InputRecorder] Replayed %u frames: %.1f ms total, %.3f ms average, %.3f ms worst",
+                mFrameIndex, mTotalFrameMs, mTotalFrameMs / mFrameIndex, mWorstFrameMs);
+
+        if (mDesyncFrame > 0)
+        {
+            SDL_Log("[InputRecorder] The replay diverged from the recording at frame %u", mDesyncFrame);
+        }
+    }
+
+    if (mFile.is_open())
+    {
+        mFile.close();
+    }
+    mMode = Mode::Off;
+}
+
+void InputRecorder::WriteFrame(const InputFrame &frame)
+{
+    if (mMode != Mode::Recording)
+        return;
+
+    Write(frame.deltaTime);
+
+    Write(static_cast<Uint8>(frame.hasController));
+    if (frame.hasController)
+    {
+        Write(frame.buttons);
+        for (Sint16 axis : frame.axes)
+        {
+            Write(axis);
+        }
+    }
+
+    // Only the keys held down, usually none or a couple
+    Uint16 numKeys = 0;
+    for (int i = 0; i < SDL_NUM_SCANCODES; i++)
+    {
+        if (frame.keys[i])
+            numKeys++;
+    }
+
+    Write(numKeys);
+    for (int i = 0; i < SDL_NUM_SCANCODES; i++)
+    {
+        if (frame.keys[i])
+            Write(static_cast<Uint16>(i));
+    }
+
+    Uint16 numEvents = 0;
+    for (const auto &event : frame.events)
+    {
+        if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP ||
+            event.type == SDL_CONTROLLERBUTTONDOWN || event.type == SDL_CONTROLLERBUTTONUP)
+            numEvents++;
+    }
+
+    Write(numEvents);
+    for (const auto &event : frame.events)
+    {
+        if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP)
+        {
+            Write(static_cast<Uint32>(event.type));
+            Write(static_cast<Sint32>(event.key.keysym.sym));
+            Write(static_cast<Uint16>(event.key.keysym.scancode));
+            Write(static_cast<Uint8>(event.key.repeat));
+        }
+        else if (event.type == SDL_CONTROLLERBUTTONDOWN || event.type == SDL_CONTROLLERBUTTONUP)
+        {
+            Write(static_cast<Uint32>(event.type));
+            Write(static_cast<Sint32>(event.cbutton.button));
+            Write(static_cast<Uint16>(0));
+            Write(static_cast<Uint8>(0));
+        }
+    }
+
+    Write(frame.checksum.x);
+    Write(frame.checksum.y);
+
+    mFrameIndex++;
+}
+
+bool InputRecorder::ReadFrame(InputFrame &frame)
+{
+    if (mMode != Mode::Replaying)
+        return false;
+
+    Uint8 hasController = 0;
+    if (!Read(frame.deltaTime) || !Read(hasController))
+        return false;
+
+    frame.hasController = hasController != 0;
+    frame.buttons = 0;
+    std::fill(std::begin(frame.axes), std::end(frame.axes), 0);
+    if (frame.hasController)
+    {
+        Read(frame.buttons);
+        for (Sint16 &axis : frame.axes)
+        {
+            Read(axis);
+        }
+    }
+
+    std::fill(std::begin(frame.keys), std::end(frame.keys), 0);
+    Uint16 numKeys = 0;
+    Read(numKeys);
+    for (int i = 0; i < numKeys; i++)
+    {
+        Uint16 scancode = 0;
+        Read(scancode);
+        if (scancode < SDL_NUM_SCANCODES)
+            frame.keys[scancode] = 1;
+    }
+
+    frame.events.clear();
+    Uint16 numEvents = 0;
+    Read(numEvents);
+    for (int i = 0; i < numEvents; i++)
+    {
+        Uint32 type = 0;
+        Sint32 code = 0;
+        Uint16 scancode = 0;
+        Uint8 repeat = 0;
+        Read(type);
+        Read(code);
+        Read(scancode);
+        Read(repeat);
+
+        SDL_Event event;
+        std::memset(&event, 0, sizeof(event));
+        event.type = type;
+        if (type == SDL_KEYDOWN || type == SDL_KEYUP)
+        {
+            event.key.state = type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+            event.key.repeat = repeat;
+            event.key.keysym.sym = code;
+            event.key.keysym.scancode = static_cast<SDL_Scancode>(scancode);
+        }
+        else
+        {
+            event.cbutton.state = type == SDL_CONTROLLERBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+            event.cbutton.button = static_cast<Uint8>(code);
+        }
+        frame.events.push_back(event);
+    }
+
+    if (!Read(frame.checksum.x) || !Read(frame.checksum.y))
+        return false;
+
+    mFrameIndex++;
+    return true;
+}
+
+void InputRecorder::VerifyChecksum(const InputFrame &frame, const Vector2 &checksum)
+{
+    if (mMode != Mode::Replaying || mDesyncFrame > 0)
+        return;
+
+    if (frame.checksum.x != checksum.x || frame.checksum.y != checksum.y)
+    {
+        mDesyncFrame = mFrameIndex;
+        SDL_Log("[InputRecorder] Desync at frame %u: Zoe at (%.2f, %.2f), recorded (%.2f, %.2f)",
+                mFrameIndex, checksum.x, checksum.y, frame.checksum.x, frame.checksum.y);
+    }
+}
+
+void InputRecorder::AddFrameTime(float milliseconds)
+{
+    mTotalFrameMs += milliseconds;
+    mWorstFrameMs = std::max(mWorstFrameMs, milliseconds);
+}
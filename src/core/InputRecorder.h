@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SDL.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../libs/Math.h"
+
+// Everything the game reads from the keyboard and the controller during one frame
+struct InputFrame
+{
+    float deltaTime = 0.f;
+    std::vector<SDL_Event> events;
+    Uint8 keys[SDL_NUM_SCANCODES] = {};
+    bool hasController = false;
+    Uint32 buttons = 0;                     // bit per SDL_GameControllerButton
+    Sint16 axes[SDL_CONTROLLER_AXIS_MAX] = {};
+    Vector2 checksum;                       // Zoe's position before the frame's update, to detect desyncs
+};
+
+// Writes the input of every frame and the RNG seed to a file, and reads them back
+// so a session can be replayed at the recorded delta times. Only key and controller
+// button events are stored, the file is in native byte order.
+class InputRecorder
+{
+public:
+    enum class Mode
+    {
+        Off,
+        Recording,
+        Replaying
+    };
+
+    InputRecorder();
+    ~InputRecorder();
+
+    bool StartRecording(const std::string &path, unsigned int seed);
+    bool StartReplay(const std::string &path);
+    void Stop();
+
+    Mode GetMode() const { return mMode; }
+    unsigned int GetSeed() const { return mSeed; }
+    unsigned int GetFrameIndex() const { return mFrameIndex; }
+
+    void WriteFrame(const InputFrame &frame);
+
+    // Returns false when the recording is over
+    bool ReadFrame(InputFrame &frame);
+
+    // Compares the replayed state with the recorded one, logs the first frame that differs
+    void VerifyChecksum(const InputFrame &frame, const Vector2 &checksum);
+
+    // Replay timings, logged by Stop
+    void AddFrameTime(float milliseconds);
+
+private:
+    template <typename T>
+    void Write(const T &value) { mFile.write(reinterpret_cast<const char *>(&value), sizeof(T)); }
+
+    template <typename T>
+    bool Read(T &value) { return static_cast<bool>(mFile.read(reinterpret_cast<char *>(&value), sizeof(T))); }
+
+    Mode mMode;
+    std::fstream mFile;
+    std::string mPath;
+    unsigned int mSeed;
+    unsigned int mFrameIndex;
+    unsigned int mDesyncFrame; // 0 while the replay matches
+
+    float mTotalFrameMs;
+    float mWorstFrameMs;
+};
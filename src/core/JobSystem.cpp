@@ -0,0 +1,273 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <iterator>
+
+// Queue of the calling thread, only workers have their own
+static thread_local const JobSystem *sCurrentSystem = nullptr;
+static thread_local int sQueueIndex = 0;
+
+JobSystem::JobSystem(int maxWorkers)
+    : mQueuedJobs(0), mQuit(false)
+{
+    int numWorkers = 0;
+#ifndef __EMSCRIPTEN__
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    numWorkers = std::max(0, std::min(maxWorkers, cores - 1));
+#endif
+
+    mQueues = std::vector<Queue>(numWorkers + 1);
+
+    for (int i = 0; i < numWorkers; i++)
+    {
+        mWorkers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mQuit = true;
+    }
+    mSleepCondition.notify_all();
+
+    for (auto &worker : mWorkers)
+    {
+        worker.join();
+    }
+}
+
+void JobSystem::Run(std::function<void()> function, Counter *counter, Counter *dependency)
+{
+    if (counter)
+    {
+        counter->mPending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job job;
+    job.function = std::move(function);
+    job.counter = counter;
+
+    if (dependency)
+    {
+        // Finish queues it when the dependency is done
+        std::lock_guard<std::mutex> lock(dependency->mMutex);
+        if (!dependency->IsDone())
+        {
+            dependency->mWaitingJobs.push_back(std::move(job));
+            return;
+        }
+    }
+
+    Push(std::move(job));
+}
+
+void JobSystem::RunBackground(std::function<void()> function, Counter *counter)
+{
+    if (counter)
+    {
+        counter->mPending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job job;
+    job.function = std::move(function);
+    job.counter = counter;
+    Push(std::move(job), true);
+}
+
+void JobSystem::Wait(const Counter &counter)
+{
+    while (!counter.IsDone())
+    {
+        // Without workers nobody else runs the jobs the counter's ones depend on
+        if (!TryRunJob(&counter, true) && !(mWorkers.empty() && TryRunJob(nullptr, false)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // The job that finished the counter may still hold its lock
+    std::lock_guard<std::mutex> lock(counter.mMutex);
+}
+
+void JobSystem::ParallelFor(int count, const std::function<void(int)> &job, int grain)
+{
+    if (count <= 0)
+        return;
+
+    grain = std::max(1, grain);
+    int numChunks = (count + grain - 1) / grain;
+    int numJobs = std::min(numChunks, GetNumWorkers() + 1);
+
+    if (numJobs <= 1)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            job(i);
+        }
+        return;
+    }
+
+    // One job per thread, each takes chunks until there are none left
+    std::atomic<int> nextIndex(0);
+    auto runChunks = [&]()
+    {
+        while (true)
+        {
+            int begin = nextIndex.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= count)
+                return;
+
+            int end = std::min(begin + grain, count);
+            for (int i = begin; i < end; i++)
+            {
+                job(i);
+            }
+        }
+    };
+
+    Counter counter;
+    for (int i = 1; i < numJobs; i++)
+    {
+        Run(runChunks, &counter);
+    }
+
+    runChunks();
+    Wait(counter);
+}
+
+void JobSystem::WorkerLoop(int queueIndex)
+{
+    sCurrentSystem = this;
+    sQueueIndex = queueIndex;
+
+    while (true)
+    {
+        if (TryRunJob(nullptr, true))
+            continue;
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mSleepCondition.wait(lock, [this] { return mQuit || mQueuedJobs.load(std::memory_order_relaxed) > 0; });
+
+        if (mQuit)
+            return;
+    }
+}
+
+void JobSystem::Push(Job job, bool background)
+{
+    Queue &queue = background ? mBackgroundQueue : mQueues[GetQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    // Counted under the sleep mutex so a worker going to sleep can't miss it
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mQueuedJobs.fetch_add(1, std::memory_order_relaxed);
+    }
+    mSleepCondition.notify_one();
+}
+
+bool JobSystem::TryRunJob(const Counter *counter, bool takeBackground)
+{
+    int numQueues = static_cast<int>(mQueues.size());
+    int ownIndex = GetQueueIndex();
+
+    Job job;
+
+    // Newest job of our own queue first, it is the most likely to be in cache,
+    // then the oldest job of the others
+    bool found = TakeJob(mQueues[ownIndex], counter, true, job);
+    for (int i = 1; i < numQueues && !found; i++)
+    {
+        found = TakeJob(mQueues[(ownIndex + i) % numQueues], counter, false, job);
+    }
+
+    if (!found && takeBackground)
+    {
+        found = TakeJob(mBackgroundQueue, counter, false, job);
+    }
+
+    if (!found)
+        return false;
+
+    mQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+    job.function();
+    Finish(job.counter);
+    return true;
+}
+
+bool JobSystem::TakeJob(Queue &queue, const Counter *counter, bool newest, Job &job)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+
+    if (!counter)
+    {
+        if (newest)
+        {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        }
+        else
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+        return true;
+    }
+
+    // Waiters look through the queue for their counter's jobs, queues are short
+    auto matches = [counter](const Job &queued) { return queued.counter == counter; };
+    auto it = queue.jobs.end();
+    if (newest)
+    {
+        auto rit = std::find_if(queue.jobs.rbegin(), queue.jobs.rend(), matches);
+        if (rit != queue.jobs.rend())
+        {
+            it = std::prev(rit.base());
+        }
+    }
+    else
+    {
+        it = std::find_if(queue.jobs.begin(), queue.jobs.end(), matches);
+    }
+
+    if (it == queue.jobs.end())
+        return false;
+
+    job = std::move(*it);
+    queue.jobs.erase(it);
+    return true;
+}
+
+void JobSystem::Finish(Counter *counter)
+{
+    if (!counter)
+        return;
+
+    // The last job of the counter takes whatever was waiting for it. The counter
+    // isn't touched once the lock is released, a waiter may destroy it right away
+    std::vector<Job> waitingJobs;
+    {
+        std::lock_guard<std::mutex> lock(counter->mMutex);
+        if (counter->mPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            waitingJobs.swap(counter->mWaitingJobs);
+        }
+    }
+
+    for (auto &job : waitingJobs)
+    {
+        Push(std::move(job));
+    }
+}
+
+int JobSystem::GetQueueIndex() const
+{
+    return sCurrentSystem == this ? sQueueIndex : 0;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing job system. Every thread has its own queue: a thread runs the newest
+// job of its queue first and, when it runs dry, steals the oldest job of another queue.
+// Threads that aren't workers (the main thread) share queue 0. A thread that Waits runs the
+// jobs of the counter it waits for, never unrelated ones that could take longer. Background
+// jobs have a queue of their own that workers only turn to when the others are empty.
+// The web build has no workers, jobs run when they are waited on.
+class JobSystem
+{
+public:
+    class Counter;
+
+private:
+    struct Job
+    {
+        std::function<void()> function;
+        Counter *counter = nullptr;
+    };
+
+public:
+    // Counts unfinished jobs. Jobs can wait for a counter to reach zero before starting,
+    // it must outlive every job that uses it
+    class Counter
+    {
+    public:
+        bool IsDone() const { return mPending.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<int> mPending{0};
+        mutable std::mutex mMutex;
+        std::vector<Job> mWaitingJobs; // jobs that depend on this counter
+    };
+
+    // maxWorkers caps the threads, the system never uses more than the cores minus the caller
+    explicit JobSystem(int maxWorkers = 7);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    // Queues a job. counter (optional) counts it until it finishes, the job only
+    // starts once dependency (optional) is done
+    void Run(std::function<void()> function, Counter *counter = nullptr, Counter *dependency = nullptr);
+
+    // Queues a long job that no frame waits for (file decoding). Workers run it when they
+    // have nothing else to do, a thread only runs it while waiting on its counter
+    void RunBackground(std::function<void()> function, Counter *counter = nullptr);
+
+    // Runs the counter's queued jobs until it is done
+    void Wait(const Counter &counter);
+
+    // Fork/join loop: calls job(i) for every i in [0, count), indices are handed out
+    // in chunks of grain, returns once all of them are done
+    void ParallelFor(int count, const std::function<void(int)> &job, int grain = 1);
+
+    int GetNumWorkers() const { return static_cast<int>(mWorkers.size()); }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void WorkerLoop(int queueIndex);
+    void Push(Job job, bool background = false);
+    // counter (optional) restricts it to the jobs that counter counts
+    bool TryRunJob(const Counter *counter, bool takeBackground);
+    bool TakeJob(Queue &queue, const Counter *counter, bool newest, Job &job);
+    void Finish(Counter *counter);
+    int GetQueueIndex() const;
+
+    std::vector<std::thread> mWorkers;
+    std::vector<Queue> mQueues; // 0 is shared by the non-worker threads, then one per worker
+    Queue mBackgroundQueue;
+
+    // Sleeping workers are woken when jobs are queued
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepCondition;
+    std::atomic<int> mQueuedJobs;
+    bool mQuit;
+};
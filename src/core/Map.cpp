@@ -1,47 +1,6 @@
 #include "./Map.h"
 #include "../actors/TV.h"
 
-std::map<std::string, Tileset> Map::LoadAllAvailableTilesets(const std::string &baseTilesetsPath)
-{
-	std::map<std::string, Tileset> allAvailableTilesets;
-
-	// populate with all tilesets in the base path - this can get costy if there are many tilesets
-	for (const auto &entry : std::filesystem::directory_iterator(baseTilesetsPath))
-	{
-		if (entry.path().extension() != ".json")
-		{
-			SDL_Log("Skipping non-json file: %s", entry.path().string().c_str());
-			continue;
-		}
-
-		std::string tilesetPath = entry.path().string();
-		Tileset t(mGame, tilesetPath);
-
-		if (t.GetName().empty())
-		{
-			SDL_Log("Skipping tileset with empty name: %s", tilesetPath.c_str());
-			continue;
-		}
-
-		if (allAvailableTilesets.find(t.GetName()) != allAvailableTilesets.end())
-		{
-			SDL_Log("Warning: Duplicate tileset name found: %s. Overwriting previous entry.", t.GetName().c_str());
-		}
-
-		// this line is a major issue
-		// allAvailableTilesets[t.GetName()] = t;
-		allAvailableTilesets.insert_or_assign(t.GetName(), std::move(t));
-	}
-
-	// peformance warning if too many tilesets
-	if (allAvailableTilesets.size() > 15)
-	{
-		SDL_Log("Warning: More than 15 tilesets found (%zu). This may impact performance.", allAvailableTilesets.size());
-	}
-
-	return allAvailableTilesets;
-}
-
 void Map::LoadTilesLayer(std::vector<std::pair<std::string, int>> &nameToFirstGID, const json &layerData, int layerIdx)
 {
 	int tileIdx = -1;
@@ -72,9 +31,9 @@ void Map::LoadTilesLayer(std::vector<std::pair<std::string, int>> &nameToFirstGI
 			throw std::runtime_error("Tile extraction: Tileset not found in map tilesets: " + tilesetName);
 		}
 
-		Tileset currentTileset = search->second;
+		const Tileset *currentTileset = search->second;
 
-		if (currentTileset.GetName() == "MetalCrate")
+		if (currentTileset->GetName() == "MetalCrate")
 		{
 			new MetalCrate(
 				mGame,
@@ -86,7 +45,7 @@ void Map::LoadTilesLayer(std::vector<std::pair<std::string, int>> &nameToFirstGI
 			continue;
 		}
 
-		if (currentTileset.GetName() == "Torch")
+		if (currentTileset->GetName() == "Torch")
 		{
 			new Torch(
 				mGame,
@@ -98,7 +57,7 @@ void Map::LoadTilesLayer(std::vector<std::pair<std::string, int>> &nameToFirstGI
 			continue;
 		}
 
-		if (currentTileset.GetName() == "Crate")
+		if (currentTileset->GetName() == "Crate")
 		{
 			new Crate(
 				mGame,
@@ -112,7 +71,7 @@ void Map::LoadTilesLayer(std::vector<std::pair<std::string, int>> &nameToFirstGI
 
 		int localID = gid - firstGID;
 
-		if (currentTileset.GetName() == "bedroom" && localID == 139)
+		if (currentTileset->GetName() == "bedroom" && localID == 139)
 		{
 			Item::CreateBookItem(mGame, Vector2(
 				(tileIdx % mWidthInTiles) * 32, 
@@ -122,7 +81,7 @@ void Map::LoadTilesLayer(std::vector<std::pair<std::string, int>> &nameToFirstGI
 			continue;
 		}
 
-		if (currentTileset.GetName() == "bedroom" && localID == 100)
+		if (currentTileset->GetName() == "bedroom" && localID == 100)
 		{
 			Item::CreateFridgeItem(mGame, Vector2(
 				(tileIdx % mWidthInTiles) * 32, 
@@ -132,7 +91,7 @@ void Map::LoadTilesLayer(std::vector<std::pair<std::string, int>> &nameToFirstGI
 			continue;
 		}
 
-		if (currentTileset.GetName() == "bedroom" && localID == 142)
+		if (currentTileset->GetName() == "bedroom" && localID == 142)
 		{
 			new TV(
 				mGame, 
@@ -145,7 +104,7 @@ void Map::LoadTilesLayer(std::vector<std::pair<std::string, int>> &nameToFirstGI
 			continue;
 		}
 
-		if (currentTileset.GetName() == "bedroom" && localID == 138)
+		if (currentTileset->GetName() == "bedroom" && localID == 138)
 		{
 			Item::CreatePictureItem(mGame, Vector2(
 				(tileIdx % mWidthInTiles) * 32, 
@@ -155,14 +114,14 @@ void Map::LoadTilesLayer(std::vector<std::pair<std::string, int>> &nameToFirstGI
 			continue;
 		}
 
-		SDL_Texture *texture = currentTileset.GetTexture();
-		Vector2 tileDims = currentTileset.GetTileDims();
+		SDL_Texture *texture = currentTileset->GetTexture();
+		Vector2 tileDims = currentTileset->GetTileDims();
 		Vector2 worldPosition(
 			tileDims.x * (tileIdx % mWidthInTiles),
 			tileDims.y * std::floor(tileIdx * 1.0f / mWidthInTiles));
-		Vector2 tilesetPosition = currentTileset.GetTilesetTexturePosition(localID);
-		Vector2 bbOffset = currentTileset.GetBBOffset(localID);
-		Vector2 bbSize = currentTileset.GetBBSize(localID);
+		Vector2 tilesetPosition = currentTileset->GetTilesetTexturePosition(localID);
+		Vector2 bbOffset = currentTileset->GetBBOffset(localID);
+		Vector2 bbSize = currentTileset->GetBBSize(localID);
 
 		mTiles.push_back(
 			std::move(
@@ -268,11 +227,11 @@ void Map::LoadPlayerColliderObjects(const json &layerData, int layerIdx)
 	}
 }
 
-std::vector<std::pair<std::string, int>> Map::LoadTilsetsUsedInMap(const json &data, const std::string &baseTilesetsPath, std::map<std::string, Tileset> &allAvailableTilesets)
+std::vector<std::pair<std::string, int>> Map::LoadTilsetsUsedInMap(const json &data)
 {
 	std::vector<std::pair<std::string, int>> nameToFirstGID;
 
-	// Load tilesets used in this map
+	// Load only the tilesets referenced by this map, through the game's tileset cache
 	for (const auto &tilesetData : data["tilesets"])
 	{
 		std::string tilesetName = tilesetData["source"];
@@ -286,20 +245,12 @@ std::vector<std::pair<std::string, int>> Map::LoadTilsetsUsedInMap(const json &d
 		}
 		tilesetName = tilesetName.substr(0, tilesetName.find_last_of('.'));
 
-		// Tileset t = allAvailableTilesets[tilesetName]; - this line is a major issue
-		auto it = allAvailableTilesets.find(tilesetName);
-		if (it == allAvailableTilesets.end())
+		Tileset *t = mGame->LoadTileset(tilesetName);
+		if (!t)
 		{
-			SDL_Log("Warning: Tileset %s not found in available tilesets. Skipping.", tilesetName.c_str());
+			SDL_Log("Warning: Tileset %s not found in available tilesets.", tilesetName.c_str());
 			throw std::runtime_error("Tileset not found: " + tilesetName);
 		}
-		Tileset t = it->second;
-
-		if (t.GetName().empty())
-		{
-			SDL_Log("Warning: Tileset %s not found in available tilesets. Skipping.", tilesetName.c_str());
-			continue;
-		}
 
 		SDL_Log("Loaded tileset: %s with firstGID: %d", tilesetName.c_str(), firstGID);
 
@@ -311,15 +262,14 @@ std::vector<std::pair<std::string, int>> Map::LoadTilsetsUsedInMap(const json &d
 }
 
 Map::Map(Game *game, std::string jsonPath)
+	: Map(game, game->LoadJson("../assets/Levels/Maps/" + jsonPath))
 {
-	const std::string basePath = "../assets/Levels/Maps/";
-	const std::string baseTilesetsPath = "../assets/Levels/Tilesets/";
-
-	jsonPath = basePath + jsonPath;
-	std::ifstream file(jsonPath);
-	json data = json::parse(file);
+}
 
+Map::Map(Game *game, const json &data)
+{
 	mGame = game;
+
 	mHeightInTiles = data["height"];
 	mWidthInTiles = data["width"];
 	int tileWidth = data["tilewidth"];
@@ -327,12 +277,8 @@ Map::Map(Game *game, std::string jsonPath)
 	mWidth = mWidthInTiles * tileWidth;
 	mHeight = mHeightInTiles * tileHeight;
 
-	mTilesets = std::map<std::string, Tileset>();
-	std::map<std::string, Tileset> allAvailableTilesets = LoadAllAvailableTilesets(baseTilesetsPath);
-	std::vector<std::pair<std::string, int>> nameToFirstGID = LoadTilsetsUsedInMap(
-		data,
-		baseTilesetsPath,
-		allAvailableTilesets);
+	mTilesets = std::map<std::string, Tileset *>();
+	std::vector<std::pair<std::string, int>> nameToFirstGID = LoadTilsetsUsedInMap(data);
 
 	mTiles = std::vector<class Tile *>();
 
@@ -367,6 +313,8 @@ Map::Map(Game *game, std::string jsonPath)
 Map::~Map()
 {
 	mTiles.clear();
+
+	// tilesets are kept alive by the game's cache, so the next scene can reuse them
 	mTilesets.clear();
 }
 
@@ -26,6 +26,8 @@ class Map
 {
 public:
     Map(class Game* game, std::string jsonPath);
+    // Map data built in memory, in the same Tiled format
+    Map(class Game* game, const json &data);
     ~Map();
 
     void Print();
@@ -39,10 +41,9 @@ private:
     int mWidth, mHeight;
     std::vector<class Tile*> mTiles;
     std::vector<class MapObject*> mMapObjects;
-    std::map<std::string, class Tileset> mTilesets;
+    std::map<std::string, class Tileset*> mTilesets; // owned by the game's tileset cache
 
-    std::map<std::string, class Tileset> LoadAllAvailableTilesets(const std::string& baseTilesetsPath);
-    std::vector<std::pair<std::string, int>> LoadTilsetsUsedInMap(const json &data, const std::string &baseTilesetsPath, std::map<std::string, Tileset> &allAvailableTilesets);
+    std::vector<std::pair<std::string, int>> LoadTilsetsUsedInMap(const json &data);
     void LoadObjectsLayer(const json& layerData, int layerIdx);
     void LoadEnemyColliderObjects(const json &layerData, int layerIdx);
     void LoadPlayerColliderObjects(const json &layerData, int layerIdx);
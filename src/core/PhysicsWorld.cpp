@@ -0,0 +1,241 @@
+#include "PhysicsWorld.h"
+#include "Game.h"
+#include "Profiler.h"
+#include "../actors/Actor.h"
+#include "../components/RigidBodyComponent.h"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PHYSICS_SIMD 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define PHYSICS_SIMD 1
+#else
+#define PHYSICS_SIMD 0
+#endif
+
+const float MAX_SPEED_X = 750.0f;
+const float MAX_SPEED_Y = 750.0f;
+const float SNAP_TO_ZERO_SPEED = 0.01f;
+
+#if PHYSICS_SIMD
+// The few 4-wide operations the integration needs
+#if defined(__SSE2__) || defined(_M_X64)
+typedef __m128 Float4;
+static inline Float4 Load(const float *values) { return _mm_loadu_ps(values); }
+static inline void Store(float *values, Float4 v) { _mm_storeu_ps(values, v); }
+static inline Float4 Splat(float value) { return _mm_set1_ps(value); }
+static inline Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+static inline Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+static inline Float4 Clamp(Float4 v, Float4 low, Float4 high) { return _mm_min_ps(_mm_max_ps(v, low), high); }
+static inline Float4 Abs(Float4 v) { return _mm_andnot_ps(_mm_set1_ps(-0.f), v); }
+static inline Float4 LessEqual(Float4 a, Float4 b) { return _mm_cmple_ps(a, b); }
+static inline Float4 Greater(Float4 a, Float4 b) { return _mm_cmpgt_ps(a, b); }
+static inline Float4 Select(Float4 mask, Float4 a, Float4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+#else
+typedef v128_t Float4;
+static inline Float4 Load(const float *values) { return wasm_v128_load(values); }
+static inline void Store(float *values, Float4 v) { wasm_v128_store(values, v); }
+static inline Float4 Splat(float value) { return wasm_f32x4_splat(value); }
+static inline Float4 Add(Float4 a, Float4 b) { return wasm_f32x4_add(a, b); }
+static inline Float4 Mul(Float4 a, Float4 b) { return wasm_f32x4_mul(a, b); }
+static inline Float4 Clamp(Float4 v, Float4 low, Float4 high) { return wasm_f32x4_pmin(high, wasm_f32x4_pmax(low, v)); }
+static inline Float4 Abs(Float4 v) { return wasm_f32x4_abs(v); }
+static inline Float4 LessEqual(Float4 a, Float4 b) { return wasm_f32x4_le(a, b); }
+static inline Float4 Greater(Float4 a, Float4 b) { return wasm_f32x4_gt(a, b); }
+static inline Float4 Select(Float4 mask, Float4 a, Float4 b) { return wasm_v128_bitselect(a, b, mask); }
+#endif
+#endif
+
+PhysicsWorld::PhysicsWorld(Game *game)
+    : mGame(game), mFrame(0)
+{
+}
+
+int PhysicsWorld::AddBody(RigidBodyComponent *body, float mass, float friction, bool applyGravity)
+{
+    int index;
+    if (!mFreeBodies.empty())
+    {
+        index = mFreeBodies.back();
+        mFreeBodies.pop_back();
+    }
+    else
+    {
+        index = static_cast<int>(mBodies.size());
+        size_t size = mBodies.size() + 1;
+
+        mBodies.resize(size);
+        mIntegratedFrame.resize(size);
+        mVelocityX.resize(size);
+        mVelocityY.resize(size);
+        mAccelerationX.resize(size);
+        mAccelerationY.resize(size);
+        mMass.resize(size);
+        mInverseMass.resize(size);
+        mGravityScale.resize(size);
+        mFrictionCoefficient.resize(size);
+        mApplyGravity.resize(size);
+        mApplyFriction.resize(size);
+        mIsOnGround.resize(size);
+        mAwake.resize(size);
+        mStepGravity.resize(size);
+        mStepFrictionX.resize(size);
+        mStepFrictionY.resize(size);
+    }
+
+    mBodies[index] = body;
+    mIntegratedFrame[index] = mFrame - 1;
+    mVelocityX[index] = 0.f;
+    mVelocityY[index] = 0.f;
+    mAccelerationX[index] = 0.f;
+    mAccelerationY[index] = 0.f;
+    mMass[index] = mass;
+    mInverseMass[index] = 1.f / mass;
+    mGravityScale[index] = 1.f;
+    mFrictionCoefficient[index] = friction;
+    mApplyGravity[index] = applyGravity;
+    mApplyFriction[index] = true;
+    mIsOnGround[index] = false;
+    PrepareBody(index, false);
+
+    return index;
+}
+
+void PhysicsWorld::RemoveBody(int body)
+{
+    mBodies[body] = nullptr;
+    PrepareBody(body, false);
+    mFreeBodies.push_back(body);
+}
+
+void PhysicsWorld::Integrate(float deltaTime, unsigned int activeEpoch)
+{
+    PROFILE_ZONE("IntegrateBodies");
+
+    // Bodies integrated by an earlier frame must integrate again, even if this one is skipped
+    mFrame++;
+
+    if (mGame->GetPhysicsFrozen())
+        return;
+
+    int numBodies = static_cast<int>(mBodies.size());
+    for (int i = 0; i < numBodies; i++)
+    {
+        RigidBodyComponent *body = mBodies[i];
+        bool awake = body && body->IsEnabled() &&
+                     body->GetOwner()->GetState() == ActorState::Active &&
+                     body->GetOwner()->GetActiveEpoch() == activeEpoch;
+        PrepareBody(i, awake);
+    }
+
+    IntegrateRange(0, numBodies, deltaTime);
+
+    for (int i = 0; i < numBodies; i++)
+    {
+        if (mAwake[i] > 0.f)
+        {
+            mIntegratedFrame[i] = mFrame;
+        }
+    }
+}
+
+void PhysicsWorld::IntegrateBody(int body, float deltaTime)
+{
+    PrepareBody(body, true);
+    IntegrateRange(body, body + 1, deltaTime);
+    PrepareBody(body, false);
+}
+
+void PhysicsWorld::PrepareBody(int body, bool awake)
+{
+    mAwake[body] = awake ? 1.f : 0.f;
+    mStepGravity[body] = 0.f;
+    mStepFrictionX[body] = 0.f;
+    mStepFrictionY[body] = 0.f;
+
+    if (!awake)
+        return;
+
+    bool sceneAppliesGravity = mGame->GetApplyGravityScene();
+    bool applyGravity = mApplyGravity[body] && sceneAppliesGravity;
+
+    // Forces become accelerations: gravity, then friction against the velocity
+    if (applyGravity)
+    {
+        mStepGravity[body] = GRAVITY * mGravityScale[body] * mInverseMass[body];
+    }
+
+    if (mApplyFriction[body] && mIsOnGround[body])
+    {
+        float friction = mFrictionCoefficient[body];
+        if (mBodies[body]->GetOwner()->GetIsSlidingOnSnow())
+        {
+            friction *= 0.35f; // Reduce friction when sliding on snow
+        }
+
+        // With gravity friction only slows the horizontal movement
+        mStepFrictionX[body] = -friction * mInverseMass[body];
+        mStepFrictionY[body] = applyGravity ? 0.f : -friction * mInverseMass[body];
+    }
+}
+
+void PhysicsWorld::IntegrateRange(int begin, int end, float deltaTime)
+{
+    int i = begin;
+
+#if PHYSICS_SIMD
+    const Float4 zero = Splat(0.f);
+    const Float4 half = Splat(0.5f);
+    const Float4 dt = Splat(deltaTime);
+    const Float4 maxX = Splat(MAX_SPEED_X);
+    const Float4 maxY = Splat(MAX_SPEED_Y);
+    const Float4 minX = Splat(-MAX_SPEED_X);
+    const Float4 minY = Splat(-MAX_SPEED_Y);
+    const Float4 snap = Splat(SNAP_TO_ZERO_SPEED);
+
+    for (; i + 4 <= end; i += 4)
+    {
+        Float4 awake = Greater(Load(&mAwake[i]), half);
+        Float4 velocityX = Load(&mVelocityX[i]);
+        Float4 velocityY = Load(&mVelocityY[i]);
+        Float4 accelerationX = Load(&mAccelerationX[i]);
+        Float4 accelerationY = Load(&mAccelerationY[i]);
+
+        accelerationX = Add(accelerationX, Mul(Load(&mStepFrictionX[i]), velocityX));
+        accelerationY = Add(Add(accelerationY, Load(&mStepGravity[i])), Mul(Load(&mStepFrictionY[i]), velocityY));
+
+        // Euler integration
+        Float4 newVelocityX = Clamp(Add(velocityX, Mul(accelerationX, dt)), minX, maxX);
+        Float4 newVelocityY = Clamp(Add(velocityY, Mul(accelerationY, dt)), minY, maxY);
+
+        newVelocityX = Select(LessEqual(Abs(newVelocityX), snap), zero, newVelocityX);
+        newVelocityY = Select(LessEqual(Abs(newVelocityY), snap), zero, newVelocityY);
+
+        // Sleeping bodies keep everything, awake ones consume their forces
+        Store(&mVelocityX[i], Select(awake, newVelocityX, velocityX));
+        Store(&mVelocityY[i], Select(awake, newVelocityY, velocityY));
+        Store(&mAccelerationX[i], Select(awake, zero, Load(&mAccelerationX[i])));
+        Store(&mAccelerationY[i], Select(awake, zero, Load(&mAccelerationY[i])));
+    }
+#endif
+
+    // The same steps one body at a time, for the rest
+    for (; i < end; i++)
+    {
+        if (mAwake[i] <= 0.5f)
+            continue;
+
+        float accelerationX = mAccelerationX[i] + mStepFrictionX[i] * mVelocityX[i];
+        float accelerationY = (mAccelerationY[i] + mStepGravity[i]) + mStepFrictionY[i] * mVelocityY[i];
+
+        float velocityX = Math::Clamp<float>(mVelocityX[i] + accelerationX * deltaTime, -MAX_SPEED_X, MAX_SPEED_X);
+        float velocityY = Math::Clamp<float>(mVelocityY[i] + accelerationY * deltaTime, -MAX_SPEED_Y, MAX_SPEED_Y);
+
+        mVelocityX[i] = Math::Abs(velocityX) <= SNAP_TO_ZERO_SPEED ? 0.f : velocityX;
+        mVelocityY[i] = Math::Abs(velocityY) <= SNAP_TO_ZERO_SPEED ? 0.f : velocityY;
+        mAccelerationX[i] = 0.f;
+        mAccelerationY[i] = 0.f;
+    }
+}
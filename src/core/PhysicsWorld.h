@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <SDL.h>
+
+// Rigid body state stored as structure of arrays. Once per frame the velocities of the
+// bodies of every actor that is updated (gravity, friction, Euler step, clamping) are
+// integrated together in one SIMD pass, before the actors run. RigidBodyComponent is a
+// view of its slot: it applies forces and, in its Update, only moves and collides
+class PhysicsWorld
+{
+public:
+    explicit PhysicsWorld(class Game *game);
+
+    PhysicsWorld(const PhysicsWorld &) = delete;
+    PhysicsWorld &operator=(const PhysicsWorld &) = delete;
+
+    // Slots are reused once their body is removed
+    int AddBody(class RigidBodyComponent *body, float mass, float friction, bool applyGravity);
+    void RemoveBody(int body);
+
+    // Integrates the bodies whose actor is stamped with activeEpoch, Game's active set
+    void Integrate(float deltaTime, unsigned int activeEpoch);
+
+    // One body, for those the batch didn't cover: spawned this frame or coarse updated
+    void IntegrateBody(int body, float deltaTime);
+
+    bool WasIntegrated(int body) const { return mIntegratedFrame[body] == mFrame; }
+    int GetNumBodies() const { return static_cast<int>(mBodies.size()) - static_cast<int>(mFreeBodies.size()); }
+
+private:
+    friend class RigidBodyComponent;
+
+    // Fills the per-frame step arrays of one body, a sleeping body keeps its state
+    void PrepareBody(int body, bool awake);
+    void IntegrateRange(int begin, int end, float deltaTime);
+
+    class Game *mGame;
+    unsigned int mFrame; // counts Integrate calls
+
+    std::vector<class RigidBodyComponent *> mBodies; // null in free slots
+    std::vector<int> mFreeBodies;
+    std::vector<unsigned int> mIntegratedFrame;
+
+    // Body state
+    std::vector<float> mVelocityX;
+    std::vector<float> mVelocityY;
+    std::vector<float> mAccelerationX;
+    std::vector<float> mAccelerationY;
+    std::vector<float> mMass;
+    std::vector<float> mInverseMass;
+    std::vector<float> mGravityScale;
+    std::vector<float> mFrictionCoefficient;
+    std::vector<Uint8> mApplyGravity;
+    std::vector<Uint8> mApplyFriction;
+    std::vector<Uint8> mIsOnGround;
+
+    // Per step, from the state and the scene: 1 for the bodies integrated, the gravity
+    // acceleration and the friction factors (multiplied by the velocity)
+    std::vector<float> mAwake;
+    std::vector<float> mStepGravity;
+    std::vector<float> mStepFrictionX;
+    std::vector<float> mStepFrictionY;
+};
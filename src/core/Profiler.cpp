@@ -0,0 +1,226 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+#include "../ui/UIFont.h"
+
+Uint64 Profiler::sLastFrameStart = 0;
+Uint64 Profiler::sFrameStart = 0;
+std::mutex Profiler::sBuffersMutex;
+std::vector<Profiler::ThreadBuffer *> Profiler::sAllBuffers;
+std::vector<Profiler::ThreadBuffer *> Profiler::sFreeBuffers;
+Profiler::ThreadBuffer *Profiler::sMainBuffer = nullptr;
+
+// The overlay covers two frame budgets, so a frame over budget is easy to spot
+const float OVERLAY_TIME_MS = 1000.f / 30.f;
+const float FRAME_BUDGET_MS = 1000.f / 60.f;
+const int OVERLAY_ROW_HEIGHT = 10;
+
+// Label textures of the overlay, zone names are literals so the pointer is the key
+static std::unordered_map<const char *, SDL_Texture *> sLabels;
+
+Profiler::ThreadBuffer &Profiler::GetThreadBuffer()
+{
+    struct Owner
+    {
+        ThreadBuffer *buffer = nullptr;
+
+        ~Owner()
+        {
+            if (!buffer)
+                return;
+
+            std::lock_guard<std::mutex> lock(sBuffersMutex);
+            sFreeBuffers.push_back(buffer);
+        }
+    };
+
+    thread_local Owner owner;
+
+    if (!owner.buffer)
+    {
+        std::lock_guard<std::mutex> lock(sBuffersMutex);
+        if (!sFreeBuffers.empty())
+        {
+            owner.buffer = sFreeBuffers.back();
+            sFreeBuffers.pop_back();
+            owner.buffer->depth = 0;
+        }
+        else
+        {
+            owner.buffer = new ThreadBuffer();
+            owner.buffer->threadIndex = static_cast<int>(sAllBuffers.size());
+            sAllBuffers.push_back(owner.buffer);
+        }
+    }
+
+    return *owner.buffer;
+}
+
+void Profiler::BeginFrame()
+{
+    sMainBuffer = &GetThreadBuffer();
+    sLastFrameStart = sFrameStart;
+    sFrameStart = SDL_GetPerformanceCounter();
+}
+
+void Profiler::BeginZone()
+{
+    ThreadBuffer &buffer = GetThreadBuffer();
+    if (buffer.depth < 64)
+    {
+        buffer.starts[buffer.depth] = SDL_GetPerformanceCounter();
+    }
+    buffer.depth++;
+}
+
+void Profiler::EndZone(const char *name)
+{
+    ThreadBuffer &buffer = GetThreadBuffer();
+    buffer.depth--;
+    if (buffer.depth >= 64)
+        return;
+
+    // Only this thread writes to the buffer, publishing the count is enough for readers
+    unsigned int count = buffer.count.load(std::memory_order_relaxed);
+    Zone &zone = buffer.zones[count % RING_SIZE];
+    zone.name = name;
+    zone.start = buffer.starts[buffer.depth];
+    zone.end = SDL_GetPerformanceCounter();
+    zone.depth = buffer.depth;
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+void Profiler::DrawOverlay(SDL_Renderer *renderer, UIFont *font, int width, int height)
+{
+    if (!sMainBuffer || sLastFrameStart == 0)
+        return;
+
+    const ThreadBuffer &buffer = *sMainBuffer;
+    const float msPerTick = 1000.f / static_cast<float>(SDL_GetPerformanceFrequency());
+    const float pixelsPerMs = width / OVERLAY_TIME_MS;
+
+    // Zones are written when they end, so walk back until the previous frame
+    std::vector<const Zone *> zones;
+    int maxDepth = 0;
+    unsigned int count = buffer.count.load(std::memory_order_acquire);
+    unsigned int first = count > RING_SIZE ? count - RING_SIZE : 0;
+    for (unsigned int i = count; i > first; i--)
+    {
+        const Zone &zone = buffer.zones[(i - 1) % RING_SIZE];
+        if (zone.end < sLastFrameStart)
+            break;
+        if (zone.start < sLastFrameStart || zone.end > sFrameStart)
+            continue;
+
+        zones.push_back(&zone);
+        maxDepth = std::max(maxDepth, zone.depth);
+    }
+
+    int top = height - (maxDepth + 1) * OVERLAY_ROW_HEIGHT - 4;
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_Rect background = {0, top - 2, width, height - top + 2};
+    SDL_RenderFillRect(renderer, &background);
+
+    for (const Zone *zone : zones)
+    {
+        float startMs = (zone->start - sLastFrameStart) * msPerTick;
+        float durationMs = (zone->end - zone->start) * msPerTick;
+
+        SDL_Rect rect = {
+            static_cast<int>(startMs * pixelsPerMs),
+            top + zone->depth * OVERLAY_ROW_HEIGHT,
+            std::max(1, static_cast<int>(durationMs * pixelsPerMs)),
+            OVERLAY_ROW_HEIGHT - 1};
+
+        // Same zone, same color from frame to frame
+        size_t hash = std::hash<const char *>()(zone->name);
+        SDL_SetRenderDrawColor(renderer,
+            static_cast<Uint8>(80 + hash % 150),
+            static_cast<Uint8>(80 + (hash / 150) % 150),
+            static_cast<Uint8>(80 + (hash / 22500) % 150),
+            255);
+        SDL_RenderFillRect(renderer, &rect);
+
+        if (!font)
+            continue;
+
+        auto label = sLabels.find(zone->name);
+        if (label == sLabels.end())
+        {
+            label = sLabels.emplace(zone->name, font->RenderText(zone->name, Color::Black, 8)).first;
+        }
+
+        int labelWidth = 0, labelHeight = 0;
+        if (!label->second || SDL_QueryTexture(label->second, nullptr, nullptr, &labelWidth, &labelHeight) != 0)
+            continue;
+
+        if (labelWidth + 2 > rect.w)
+            continue;
+
+        SDL_Rect labelRect = {rect.x + 1, rect.y, labelWidth, std::min(labelHeight, OVERLAY_ROW_HEIGHT - 1)};
+        SDL_RenderCopy(renderer, label->second, nullptr, &labelRect);
+    }
+
+    // Frame budget
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+    int budgetX = static_cast<int>(FRAME_BUDGET_MS * pixelsPerMs);
+    SDL_RenderDrawLine(renderer, budgetX, top - 2, budgetX, height);
+}
+
+bool Profiler::DumpChromeTrace(const std::string &path)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        SDL_Log("[Profiler] Failed to open %s", path.c_str());
+        return false;
+    }
+
+    const double usPerTick = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+    file << "{\"traceEvents\":[";
+
+    bool firstEvent = true;
+    std::lock_guard<std::mutex> lock(sBuffersMutex);
+    for (const ThreadBuffer *pointer : sAllBuffers)
+    {
+        const ThreadBuffer &buffer = *pointer;
+
+        // Other threads may overwrite their oldest zones while this runs, that is fine for a trace
+        unsigned int count = buffer.count.load(std::memory_order_acquire);
+        unsigned int first = count > RING_SIZE ? count - RING_SIZE : 0;
+        for (unsigned int i = first; i < count; i++)
+        {
+            const Zone &zone = buffer.zones[i % RING_SIZE];
+
+            if (!firstEvent)
+                file << ",";
+            firstEvent = false;
+
+            file << "\n{\"name\":\"" << zone.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer.threadIndex
+                 << ",\"ts\":" << static_cast<Uint64>(zone.start * usPerTick)
+                 << ",\"dur\":" << static_cast<Uint64>((zone.end - zone.start) * usPerTick) << "}";
+        }
+    }
+
+    file << "\n]}\n";
+
+    SDL_Log("[Profiler] Trace written to %s", path.c_str());
+    return true;
+}
+
+void Profiler::Shutdown()
+{
+    for (auto &label : sLabels)
+    {
+        if (label.second)
+        {
+            SDL_DestroyTexture(label.second);
+        }
+    }
+    sLabels.clear();
+}
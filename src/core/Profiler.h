@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SDL.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped zones, e.g. PROFILE_ZONE("UpdateActors"), record their begin/end time in a
+// ring buffer owned by the calling thread. The last frame can be drawn as a flame
+// graph and the buffers can be dumped as a Chrome trace (chrome://tracing, Perfetto).
+// Zone names must be string literals, only the pointer is stored.
+class Profiler
+{
+public:
+    struct Zone
+    {
+        const char *name;
+        Uint64 start;
+        Uint64 end;
+        int depth;
+    };
+
+    // Must be called by the main thread at the start of every frame
+    static void BeginFrame();
+
+    static void BeginZone();
+    static void EndZone(const char *name);
+
+    // Draws the zones recorded by the main thread during the last frame
+    static void DrawOverlay(SDL_Renderer *renderer, class UIFont *font, int width, int height);
+
+    // Writes every zone still in the ring buffers, returns false if the file can't be written
+    static bool DumpChromeTrace(const std::string &path);
+
+    // Frees the overlay labels, must happen before the renderer is destroyed
+    static void Shutdown();
+
+private:
+    static const unsigned int RING_SIZE = 1 << 16;
+
+    struct ThreadBuffer
+    {
+        Zone zones[RING_SIZE];
+        Uint64 starts[64];              // start times of the open zones, by depth
+        int depth = 0;
+        int threadIndex = 0;
+        std::atomic<unsigned int> count{0}; // zones ever written, the ring index is count % RING_SIZE
+    };
+
+    static ThreadBuffer &GetThreadBuffer();
+
+    // Buffers are recycled when their thread exits (the scene preloader spawns a
+    // thread per scene), their zones stay readable until another thread takes them
+    static std::mutex sBuffersMutex;
+    static std::vector<ThreadBuffer *> sAllBuffers;
+    static std::vector<ThreadBuffer *> sFreeBuffers;
+    static ThreadBuffer *sMainBuffer;
+
+    static Uint64 sLastFrameStart;
+    static Uint64 sFrameStart;
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char *name) : mName(name) { Profiler::BeginZone(); }
+    ~ProfileScope() { Profiler::EndZone(mName); }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    const char *mName;
+};
+
+#ifdef ASTRAL_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name)
+#endif
@@ -0,0 +1,262 @@
+#include "ScenePreloader.h"
+#include "Profiler.h"
+#include "SpriteSheet.h"
+#include <SDL_image.h>
+#include <SDL_mixer.h>
+#include <filesystem>
+#include <fstream>
+
+ScenePreloader::ScenePreloader()
+    : mCancel(false)
+{
+}
+
+ScenePreloader::~ScenePreloader()
+{
+    mCancel = true;
+    Wait();
+    Clear();
+}
+
+void ScenePreloader::Start(const Request &request)
+{
+    mCancel = true;
+    Wait();
+    Clear();
+    mCancel = false;
+
+    mSkipTilesets = request.skipTilesets;
+
+    if (!request.mapName.empty())
+    {
+        mJobs.push_back({JobType::Map, "../assets/Levels/Maps/" + request.mapName});
+    }
+
+    for (const auto &imagePath : request.imagePaths)
+    {
+        mJobs.push_back({JobType::Image, imagePath});
+    }
+
+    for (const auto &spriteSheet : request.spriteSheets)
+    {
+        mJobs.push_back({JobType::SpriteSheet, spriteSheet.first, spriteSheet.second});
+    }
+
+    for (const auto &soundName : request.soundNames)
+    {
+        mJobs.push_back({JobType::Sound, soundName});
+    }
+
+#ifndef __EMSCRIPTEN__
+    mWorker = std::thread(&ScenePreloader::Run, this);
+#endif
+}
+
+void ScenePreloader::Update()
+{
+#ifdef __EMSCRIPTEN__
+    if (mJobs.empty())
+        return;
+
+    Job job = mJobs.front();
+    mJobs.pop_front();
+    RunJob(job);
+#endif
+}
+
+void ScenePreloader::Wait()
+{
+    if (mWorker.joinable())
+    {
+        mWorker.join();
+    }
+
+    // Web build, or a request that was never handed to a worker
+    Run();
+}
+
+void ScenePreloader::Clear()
+{
+    mJobs.clear();
+    mSkipTilesets.clear();
+    mJsons.clear();
+
+    for (auto &surface : mSurfaces)
+    {
+        SDL_FreeSurface(surface.second);
+    }
+    mSurfaces.clear();
+
+    for (auto &sound : mSounds)
+    {
+        Mix_FreeChunk(sound.second);
+    }
+    mSounds.clear();
+
+    for (auto &spriteSheet : mSpriteSheets)
+    {
+        SDL_FreeSurface(spriteSheet.surface);
+    }
+    mSpriteSheets.clear();
+}
+
+bool ScenePreloader::TakeJson(const std::string &path, nlohmann::json &data)
+{
+    if (mWorker.joinable())
+        return false;
+
+    auto iter = mJsons.find(path);
+    if (iter == mJsons.end())
+    {
+        return false;
+    }
+
+    data = std::move(iter->second);
+    mJsons.erase(iter);
+    return true;
+}
+
+SDL_Surface *ScenePreloader::TakeSurface(const std::string &path)
+{
+    if (mWorker.joinable())
+        return nullptr;
+
+    auto iter = mSurfaces.find(path);
+    if (iter == mSurfaces.end())
+    {
+        return nullptr;
+    }
+
+    SDL_Surface *surface = iter->second;
+    mSurfaces.erase(iter);
+    return surface;
+}
+
+std::vector<std::pair<std::string, Mix_Chunk *>> ScenePreloader::TakeSounds()
+{
+    std::vector<std::pair<std::string, Mix_Chunk *>> sounds;
+    if (mWorker.joinable())
+        return sounds;
+
+    sounds.swap(mSounds);
+    return sounds;
+}
+
+std::vector<ScenePreloader::DecodedSpriteSheet> ScenePreloader::TakeSpriteSheets()
+{
+    std::vector<DecodedSpriteSheet> spriteSheets;
+    if (mWorker.joinable())
+        return spriteSheets;
+
+    spriteSheets.swap(mSpriteSheets);
+    return spriteSheets;
+}
+
+void ScenePreloader::Run()
+{
+    PROFILE_ZONE("ScenePreloader");
+
+    while (!mJobs.empty() && !mCancel)
+    {
+        Job job = mJobs.front();
+        mJobs.pop_front();
+        RunJob(job);
+    }
+}
+
+void ScenePreloader::RunJob(const Job &job)
+{
+    if (job.type == JobType::Map || job.type == JobType::Tileset)
+    {
+        std::ifstream file(job.path);
+        if (!file.is_open())
+        {
+            SDL_Log("[ScenePreloader] Failed to open %s", job.path.c_str());
+            return;
+        }
+
+        nlohmann::json data = nlohmann::json::parse(file, nullptr, false);
+        if (data.is_discarded())
+        {
+            SDL_Log("[ScenePreloader] Failed to parse %s", job.path.c_str());
+            return;
+        }
+
+        if (job.type == JobType::Map && data.contains("tilesets"))
+        {
+            // Same name resolution as Map::LoadTilsetsUsedInMap
+            for (const auto &tilesetData : data["tilesets"])
+            {
+                std::string tilesetName = tilesetData["source"];
+                size_t lastSlash = tilesetName.find_last_of("/\\");
+                if (lastSlash != std::string::npos)
+                {
+                    tilesetName = tilesetName.substr(lastSlash + 1);
+                }
+                tilesetName = tilesetName.substr(0, tilesetName.find_last_of('.'));
+
+                if (mSkipTilesets.count(tilesetName))
+                    continue;
+
+                // Tilesets saved under another file name are left to the main thread
+                std::string tilesetPath = "../assets/Levels/Tilesets/" + tilesetName + ".json";
+                if (std::filesystem::exists(tilesetPath))
+                {
+                    mJobs.push_back({JobType::Tileset, tilesetPath});
+                }
+            }
+        }
+
+        if (job.type == JobType::Tileset && data.contains("name"))
+        {
+            // Same path as Tileset::LoadTexture
+            mJobs.push_back({JobType::Image, "../assets/Levels/Tilesets/Textures/" + data["name"].get<std::string>() + ".png"});
+        }
+
+        mJsons[job.path] = std::move(data);
+    }
+    else if (job.type == JobType::Image)
+    {
+        if (mSurfaces.count(job.path))
+            return;
+
+        SDL_Surface *surface = IMG_Load(job.path.c_str());
+        if (!surface)
+        {
+            SDL_Log("[ScenePreloader] Failed to load image %s: %s", job.path.c_str(), IMG_GetError());
+            return;
+        }
+
+        mSurfaces.emplace(job.path, surface);
+    }
+    else if (job.type == JobType::SpriteSheet)
+    {
+        DecodedSpriteSheet spriteSheet{job.path, job.dataPath, nullptr, {}};
+        if (!SpriteSheet::LoadFrames(job.dataPath, spriteSheet.frames))
+        {
+            SDL_Log("[ScenePreloader] Failed to load sprite sheet data %s", job.dataPath.c_str());
+            return;
+        }
+
+        spriteSheet.surface = IMG_Load(job.path.c_str());
+        if (!spriteSheet.surface)
+        {
+            SDL_Log("[ScenePreloader] Failed to load image %s: %s", job.path.c_str(), IMG_GetError());
+            return;
+        }
+
+        mSpriteSheets.push_back(std::move(spriteSheet));
+    }
+    else if (job.type == JobType::Sound)
+    {
+        std::string fileName = "../assets/Sounds/" + job.path;
+        Mix_Chunk *chunk = Mix_LoadWAV(fileName.c_str());
+        if (!chunk)
+        {
+            SDL_Log("[ScenePreloader] Failed to load sound file %s", fileName.c_str());
+            return;
+        }
+
+        mSounds.emplace_back(job.path, chunk);
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <SDL.h>
+#include <atomic>
+#include <deque>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../libs/Json.h"
+
+// Decodes the files of the next scene while the scene transition is running.
+// Only CPU work is done here (json parsing, image and sound decoding), textures
+// and actors are still created on the main thread when the scene is loaded.
+class ScenePreloader
+{
+public:
+    struct Request
+    {
+        std::string mapName;                            // file under assets/Levels/Maps, empty if there is no map
+        std::vector<std::string> imagePaths;            // full paths, as passed to Game::LoadTexture
+        std::vector<std::pair<std::string, std::string>> spriteSheets; // texture and data paths
+        std::vector<std::string> soundNames;            // relative to assets/Sounds, as passed to PlaySound
+        std::unordered_set<std::string> skipTilesets;   // tilesets already in the game's cache
+    };
+
+    struct DecodedSpriteSheet
+    {
+        std::string texturePath;
+        std::string dataPath;
+        SDL_Surface *surface;
+        std::vector<SDL_Rect> frames;
+    };
+
+    ScenePreloader();
+    ~ScenePreloader();
+
+    // Starts decoding the request, anything left from a previous request is discarded
+    void Start(const Request &request);
+
+    // Without threads (web build) the files are decoded here, one per frame
+    void Update();
+
+    // Blocks until every file of the request is decoded
+    void Wait();
+
+    // Frees whatever was decoded but not taken by the scene
+    void Clear();
+
+    // The Take functions hand over ownership of the decoded data, they return nothing until Wait was called
+    bool TakeJson(const std::string &path, nlohmann::json &data);
+    SDL_Surface *TakeSurface(const std::string &path);
+    std::vector<std::pair<std::string, struct Mix_Chunk *>> TakeSounds();
+    std::vector<DecodedSpriteSheet> TakeSpriteSheets();
+
+private:
+    enum class JobType
+    {
+        Map,
+        Tileset,
+        Image,
+        SpriteSheet,
+        Sound
+    };
+
+    struct Job
+    {
+        JobType type;
+        std::string path;
+        std::string dataPath; // sprite sheets only
+    };
+
+    void Run();
+    void RunJob(const Job &job);
+
+    std::deque<Job> mJobs;
+    std::unordered_set<std::string> mSkipTilesets;
+
+    // The worker owns everything below until Wait returns
+    std::unordered_map<std::string, nlohmann::json> mJsons;
+    std::unordered_map<std::string, SDL_Surface *> mSurfaces;
+    std::vector<std::pair<std::string, struct Mix_Chunk *>> mSounds;
+    std::vector<DecodedSpriteSheet> mSpriteSheets;
+
+    std::thread mWorker;
+    std::atomic<bool> mCancel;
+};
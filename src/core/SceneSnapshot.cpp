@@ -0,0 +1,185 @@
+#include "SceneSnapshot.h"
+#include "Game.h"
+#include "Profiler.h"
+#include "SpatialHashing.h"
+#include "../actors/Enemy.h"
+#include "../components/RigidBodyComponent.h"
+#include "../components/draw/DrawComponent.h"
+#include "../components/draw/DrawAnimatedComponent.h"
+
+SceneSnapshot::SceneSnapshot(Game *game)
+    : mGame(game), mZoe(game->mZoe), mStar(game->mStar), mPortal(game->mPortal), mZathura(game->mZathura),
+      mEnemies(game->mEnemies), mMustAlwaysUpdateActors(game->mMustAlwaysUpdateActors),
+      mApplyGravityScene(game->mApplyGravityScene), mHasSpawnedPortalLevel2(game->mHasSpawnedPortalLevel2),
+      mQuasarEncounterTimeCounter(game->mQuasarEncounterTimeCounter),
+      mMetalCratePortionTimeCounter(game->mMetalCratePortionTimeCounter)
+{
+    PROFILE_ZONE("CaptureSceneSnapshot");
+
+    std::vector<Actor *> actors;
+    mGame->GetSpatialHashing()->GetActors(actors);
+
+    mActors.reserve(actors.size());
+    mMembers.reserve(actors.size());
+
+    for (Actor *actor : actors)
+    {
+        if (actor->GetState() == ActorState::Destroy)
+            continue;
+
+        ActorSnapshot snapshot;
+        snapshot.actor = actor;
+        snapshot.state = actor->mState;
+        snapshot.behaviorState = actor->mBehaviorState;
+        snapshot.previousBehaviorState = actor->mPreviousBehaviorState;
+        snapshot.position = actor->mPosition;
+        snapshot.scale = actor->mScale;
+        snapshot.rotation = actor->mRotation;
+        snapshot.freezingCount = actor->mFreezingCount;
+        snapshot.isOnGround = actor->mIsOnGround;
+        snapshot.isSlidingOnSnow = actor->mIsSlidingOnSnow;
+        snapshot.isInvincible = actor->mInvincible;
+        snapshot.lives = actor->mLifes;
+
+        snapshot.components.reserve(actor->mComponents.size());
+        for (Component *component : actor->mComponents)
+        {
+            ComponentState state{component, component->IsEnabled(), true, -1, Vector2::Zero, {}};
+
+            if (auto draw = dynamic_cast<DrawComponent *>(component))
+            {
+                state.isVisible = draw->IsVisible();
+            }
+            if (auto animated = dynamic_cast<DrawAnimatedComponent *>(component))
+            {
+                state.animation = animated->GetAnimation();
+            }
+            if (auto rigidBody = dynamic_cast<RigidBodyComponent *>(component))
+            {
+                state.velocity = rigidBody->GetVelocity();
+            }
+            if (auto timers = dynamic_cast<TimerComponent *>(component))
+            {
+                timers->SaveTimers(state.timers);
+            }
+
+            snapshot.components.push_back(std::move(state));
+        }
+
+        mMembers.insert(actor);
+        mActors.push_back(std::move(snapshot));
+    }
+}
+
+SceneSnapshot::~SceneSnapshot()
+{
+    for (Actor *actor : mRetired)
+    {
+        delete actor;
+    }
+    mRetired.clear();
+}
+
+bool SceneSnapshot::Retire(Actor *actor)
+{
+    if (mMembers.find(actor) == mMembers.end())
+        return false;
+
+    // Out of every query as if it was deleted
+    mGame->RemoveActor(actor);
+    if (auto enemy = dynamic_cast<Enemy *>(actor))
+    {
+        mGame->RemoveEnemy(enemy);
+    }
+
+    mRetired.push_back(actor);
+    return true;
+}
+
+void SceneSnapshot::Restore()
+{
+    PROFILE_ZONE("RestoreSceneSnapshot");
+
+    // Everything created since the snapshot goes, after the others had a chance to drop it
+    std::vector<Actor *> actors;
+    mGame->GetSpatialHashing()->GetActors(actors);
+
+    std::vector<Actor *> created;
+    for (Actor *actor : actors)
+    {
+        if (mMembers.find(actor) == mMembers.end())
+        {
+            actor->SetState(ActorState::Destroy);
+            created.push_back(actor);
+        }
+    }
+
+    for (ActorSnapshot &snapshot : mActors)
+    {
+        Actor *actor = snapshot.actor;
+        actor->mState = snapshot.state;
+        actor->mBehaviorState = snapshot.behaviorState;
+        actor->mPreviousBehaviorState = snapshot.previousBehaviorState;
+        actor->mScale = snapshot.scale;
+        actor->mRotation = snapshot.rotation;
+        actor->mFreezingCount = snapshot.freezingCount;
+        actor->mIsOnGround = snapshot.isOnGround;
+        actor->mIsSlidingOnSnow = snapshot.isSlidingOnSnow;
+        actor->mInvincible = snapshot.isInvincible;
+        actor->mLifes = snapshot.lives;
+
+        // Puts retired actors back in the spatial hashing too
+        actor->SetPosition(snapshot.position);
+
+        for (ComponentState &state : snapshot.components)
+        {
+            Component *component = state.component;
+            component->SetEnabled(state.isEnabled);
+
+            if (auto draw = dynamic_cast<DrawComponent *>(component))
+            {
+                draw->SetIsVisible(state.isVisible);
+            }
+            if (auto animated = dynamic_cast<DrawAnimatedComponent *>(component))
+            {
+                if (state.animation >= 0)
+                {
+                    animated->SetAnimation(state.animation);
+                }
+            }
+            if (auto rigidBody = dynamic_cast<RigidBodyComponent *>(component))
+            {
+                rigidBody->SetVelocity(state.velocity);
+                rigidBody->ResetAcceleration();
+            }
+            if (auto timers = dynamic_cast<TimerComponent *>(component))
+            {
+                timers->RestoreTimers(state.timers);
+            }
+        }
+    }
+    mRetired.clear();
+
+    mGame->mZoe = mZoe;
+    mGame->mStar = mStar;
+    mGame->mPortal = mPortal;
+    mGame->mZathura = mZathura;
+    mGame->mEnemies = mEnemies;
+    mGame->mMustAlwaysUpdateActors = mMustAlwaysUpdateActors;
+    mGame->mApplyGravityScene = mApplyGravityScene;
+    mGame->mHasSpawnedPortalLevel2 = mHasSpawnedPortalLevel2;
+    mGame->mQuasarEncounterTimeCounter = mQuasarEncounterTimeCounter;
+    mGame->mMetalCratePortionTimeCounter = mMetalCratePortionTimeCounter;
+
+    for (ActorSnapshot &snapshot : mActors)
+    {
+        snapshot.actor->OnSnapshotRestored();
+    }
+
+    for (Actor *actor : created)
+    {
+        delete actor;
+    }
+
+    mGame->mActiveActorsDirty = true;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <unordered_set>
+#include <vector>
+#include "../actors/Actor.h"
+#include "../components/TimerComponent.h"
+#include "SpriteSheet.h"
+
+// Dynamic state of a loaded scene: every actor's transform, lives, behaviour, components and
+// timers, plus the game's actor registrations and the scene progress that decides what gets
+// spawned (Level 2's portal, the tips). Taken when Zoe reaches a checkpoint, so a
+// respawn puts the scene back in place instead of reloading the map and its assets.
+// Actors of the snapshot destroyed afterwards are retired here rather than deleted, the
+// ones created afterwards are deleted on Restore
+class SceneSnapshot
+{
+public:
+    explicit SceneSnapshot(class Game *game);
+    ~SceneSnapshot();
+
+    SceneSnapshot(const SceneSnapshot &) = delete;
+    SceneSnapshot &operator=(const SceneSnapshot &) = delete;
+
+    // False for actors created after the snapshot, those are deleted as usual
+    bool Retire(Actor *actor);
+
+    // Only between frames, nothing may be iterating actors or timers
+    void Restore();
+
+    int GetNumActors() const { return static_cast<int>(mActors.size()); }
+
+private:
+    struct ComponentState
+    {
+        class Component *component;
+        bool isEnabled;
+        bool isVisible;
+        AnimationId animation;
+        Vector2 velocity;
+        std::vector<Timer> timers;
+    };
+
+    struct ActorSnapshot
+    {
+        Actor *actor;
+        ActorState state;
+        BehaviorState behaviorState;
+        BehaviorState previousBehaviorState;
+        Vector2 position;
+        float scale;
+        float rotation;
+        float freezingCount;
+        bool isOnGround;
+        bool isSlidingOnSnow;
+        bool isInvincible;
+        int lives;
+        std::vector<ComponentState> components;
+    };
+
+    class Game *mGame;
+
+    std::vector<ActorSnapshot> mActors;
+    std::unordered_set<Actor *> mMembers;
+    std::vector<Actor *> mRetired;
+
+    class Zoe *mZoe;
+    class Star *mStar;
+    Actor *mPortal;
+    class Zathura *mZathura;
+    std::vector<class Enemy *> mEnemies;
+    std::vector<Actor *> mMustAlwaysUpdateActors;
+    bool mApplyGravityScene;
+
+    // Flags and counters of Game that gate runtime spawns, a restore must be able to redo them
+    bool mHasSpawnedPortalLevel2;
+    float mQuasarEncounterTimeCounter;
+    float mMetalCratePortionTimeCounter;
+};
@@ -12,6 +12,9 @@
 #include "Game.h"
 #include "HUD.h"
 #include "SpatialHashing.h"
+#include "ScenePreloader.h"
+#include "AssetWarmup.h"
+#include "AssetManifest.h"
 #include "../libs/Json.h"
 #include "../libs/Random.h"
 #include "../actors/Actor.h"
@@ -29,6 +32,129 @@
 #include "../actors/Mother.h"
 #include "../actors/MetalCrate.h"
 
+// Files decoded in background during the transition, keep in sync with the Load functions below
+// (themes are streamed by the AudioSystem, so they are not listed here)
+void Game::PreloadScene(GameScene scene)
+{
+    ScenePreloader::Request request;
+    std::vector<std::string> soundNames;
+
+    if (scene == GameScene::Bedroom)
+    {
+        request.mapName = "bedroom.json";
+    }
+    else if (scene == GameScene::BedroomPortal)
+    {
+        request.mapName = "bedroomPortal.json";
+        soundNames = {"portalSuck.wav"};
+    }
+    else if (scene == GameScene::Level1)
+    {
+        request.mapName = "level1.json";
+        request.imagePaths = {"../assets/Levels/Backgrounds/galaxy.png"};
+    }
+    else if (scene == GameScene::Level2)
+    {
+        request.mapName = "level2.json";
+        request.imagePaths = {"../assets/Levels/Backgrounds/nebula.png"};
+        soundNames = {"portalSuck.wav"};
+    }
+    else if (scene == GameScene::Tests)
+    {
+        request.mapName = "tests.json";
+        request.imagePaths = {"../assets/Levels/Backgrounds/nebula.png"};
+    }
+    else if (scene == GameScene::BedroomFinal)
+    {
+        request.mapName = "bedroomFinal.json";
+    }
+    else if (scene == GameScene::StressTest)
+    {
+        request.imagePaths = {"../assets/Levels/Backgrounds/nebula.png"};
+    }
+
+    // Everything else the scene touched when its manifest was recorded, mid-gameplay spawns included
+    mManifestTextures.clear();
+    AssetManifest manifest;
+    if (manifest.Load(GetManifestPath(scene)))
+    {
+        for (const auto &texturePath : manifest.GetTextures())
+        {
+            mManifestTextures.push_back(texturePath);
+            if (std::find(request.imagePaths.begin(), request.imagePaths.end(), texturePath) == request.imagePaths.end())
+                request.imagePaths.push_back(texturePath);
+        }
+
+        for (const auto &spriteSheet : manifest.GetSpriteSheets())
+        {
+            if (mSpriteSheets.find(spriteSheet.first + "|" + spriteSheet.second) == mSpriteSheets.end())
+                request.spriteSheets.push_back(spriteSheet);
+        }
+
+        soundNames.insert(soundNames.end(), manifest.GetSounds().begin(), manifest.GetSounds().end());
+    }
+
+    for (const auto &soundName : soundNames)
+    {
+        if (!mAudio->IsSoundCached(soundName) &&
+            std::find(request.soundNames.begin(), request.soundNames.end(), soundName) == request.soundNames.end())
+            request.soundNames.push_back(soundName);
+    }
+
+    for (const auto &tileset : mTilesets)
+    {
+        request.skipTilesets.insert(tileset.first);
+    }
+
+    mScenePreloader->Start(request);
+}
+
+std::string Game::GetManifestPath(GameScene scene)
+{
+    // In GameScene order
+    static const char *sceneNames[] = {
+        "mainMenu", "bedroom", "bedroomPortal", "level1", "level2", "tests", "deathScreen", "endDemo", "bedroomFinal",
+        "stressTest"};
+
+    return std::string("../assets/Manifests/") + sceneNames[static_cast<int>(scene)] + ".json";
+}
+
+void Game::SaveRecordedManifest()
+{
+    if (!mRecordedManifest)
+        return;
+
+    // Runs that went through other parts of the scene add to the same file
+    std::string path = GetManifestPath(mGameScene);
+    AssetManifest manifest;
+    manifest.Load(path);
+    manifest.Merge(*mRecordedManifest);
+
+    // Sprite sheet textures come with their sheet, and tileset textures with the map's tilesets
+    for (const auto &spriteSheet : manifest.GetSpriteSheets())
+    {
+        manifest.RemoveTexture(spriteSheet.first);
+    }
+    std::vector<std::string> tilesetTextures;
+    for (const auto &texturePath : manifest.GetTextures())
+    {
+        if (texturePath.rfind("../assets/Levels/Tilesets/", 0) == 0)
+            tilesetTextures.push_back(texturePath);
+    }
+    for (const auto &texturePath : tilesetTextures)
+    {
+        manifest.RemoveTexture(texturePath);
+    }
+
+    if (!manifest.IsEmpty() && manifest.Save(path))
+    {
+        SDL_Log("[AssetManifest] Saved %s", path.c_str());
+    }
+
+    delete mRecordedManifest;
+    mRecordedManifest = nullptr;
+}
+
 void Game::LoadMainMenu()
 {
     UIScreen *mainMenu = new UIScreen(this, FONT_PATH_SMB);
@@ -70,7 +196,24 @@ void Game::LoadMainMenu()
         Vector2(33.0f, 33.0f),
         Color::White);
 
-    mMusicHandle = mAudio->PlaySound("mainMenuTheme.ogg", true);
+    if (mAssetWarmup)
+    {
+        UIText *loadingText = mainMenu->AddText(
+            "Loading 0%",
+            Vector2(mWindowWidth / 2.0f - 40.f, mWindowHeight * .6f + playButtonSize.y + 10.f),
+            Vector2(80.f, 10.f),
+            10,
+            1024,
+            Color::White);
+
+        mAssetWarmup->SetProgressCallback([loadingText](float progress)
+        {
+            loadingText->SetText("Loading " + std::to_string(static_cast<int>(progress * 100.f)) + "%");
+            loadingText->SetEnabled(progress < 1.f);
+        });
+    }
+
+    mAudio->PlayMusic("mainMenuTheme.ogg");
 }
 
 void Game::LoadBedroom()
@@ -111,7 +254,7 @@ void Game::LoadBedroom()
 
     mZoe->SetAbilitiesLocked(true);
 
-    mMusicHandle = mAudio->PlaySound("bedroomTheme.ogg", true);
+    mAudio->PlayMusic("bedroomTheme.ogg");
 
     if (mPreviousScene == GameScene::BedroomPortal) {
         mZoe->SetCenter(Vector2(420.f, 87.f));
@@ -189,7 +332,7 @@ void Game::LoadBedroomPortal()
                 true);
     
     mZoe->SetAbilitiesLocked(true);
-    mMusicHandle = mAudio->PlaySound("bedroomTheme.ogg", true);
+    mAudio->PlayMusic("bedroomTheme.ogg");
 }
 
 void Game::LoadFirstLevel()
@@ -521,7 +664,7 @@ void Game::LoadFirstLevel()
                 },
                 true);
 
-    mMusicHandle = mAudio->PlaySound("level1Theme.ogg", true);
+    mAudio->PlayMusic("level1Theme.ogg");
 
     steps.clear();
     dialogue = {
@@ -559,7 +702,7 @@ void Game::LoadSecondLevel()
         Vector2(mWindowWidth, mWindowHeight),
         false);
 
-    mMusicHandle = mAudio->PlaySound("level2Theme.ogg", true);
+    mAudio->PlayMusic("level2Theme.ogg");
 
     std::vector<std::unique_ptr<Step>> steps;
     std::vector<std::string> dialogue;
@@ -1071,7 +1214,22 @@ void Game::LoadTestsLevel()
         Vector2(mWindowWidth, mWindowHeight),
         false);
 
-    mMusicHandle = mAudio->PlaySound("level1Theme.ogg", true);
+    mAudio->PlayMusic("level1Theme.ogg");
+}
+
+void Game::LoadStressTestLevel()
+{
+    mHUD = new HUD(this, Game::FONT_PATH_INTER);
+
+    SetApplyGravityScene(true);
+
+    mMap = new Map(this, mStressTest->GenerateMap());
+
+    SetBackgroundImage(
+        "../assets/Levels/Backgrounds/nebula.png",
+        Vector2(0.0f, 0.0f),
+        Vector2(mWindowWidth, mWindowHeight),
+        false);
 }
 
 void Game::LoadDeathScreen()
@@ -1114,7 +1272,7 @@ void Game::LoadDeathScreen()
         Vector2(33.0f, 33.0f),
         Color::White);
 
-    mMusicHandle = mAudio->PlaySound("deathTheme.ogg", true);
+    mAudio->PlayMusic("deathTheme.ogg");
 }
 
 void Game::LoadEndDemoScene()
@@ -1189,7 +1347,7 @@ void Game::LoadEndDemoScene()
 
     StartCutscene("credits");
 
-    mMusicHandle = mAudio->PlaySound("endDemoTheme.ogg", true);
+    mAudio->PlayMusic("endDemoTheme.ogg");
 }
 
 void Game::LoadBedroomFinal()
@@ -1278,5 +1436,5 @@ void Game::LoadBedroomFinal()
                     this->SetGameScene(GameScene::EndDemo);
                 });
 
-    mMusicHandle = mAudio->PlaySound("bedroomTheme.ogg", true);
+    mAudio->PlayMusic("bedroomTheme.ogg");
 }
\ No newline at end of file
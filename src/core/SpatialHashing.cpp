@@ -4,6 +4,7 @@
 //
 
 #include "SpatialHashing.h"
+#include "EngineStats.h"
 #include <SDL.h>
 #include "../actors/Tile.h"
 #include "../libs/Math.h"
@@ -20,6 +21,8 @@ SpatialHashing::SpatialHashing(int cellSize, int width, int height)
     int rows = (height + cellSize - 1) / cellSize;
 
     mGrid.resize(rows, std::vector<std::vector<Actor *>>(cols));
+    mCellColliders.resize(rows, std::vector<std::vector<AABBColliderComponent *>>(cols));
+    mCellLayers.resize(rows, std::vector<ColliderLayerMask>(cols, 0));
     mCellTypes.resize(rows, std::vector<CellType>(cols, CellType::Empty));
 }
 
@@ -40,11 +43,18 @@ SpatialHashing::~SpatialHashing()
     }
 
     mGrid.clear();
+    mCellColliders.clear();
+    mCellLayers.clear();
     mPositions.clear();
     mCellIndices.clear();
 }
 
 void SpatialHashing::Insert(Actor *actor)
+{
+    InsertWithCollider(actor, actor->GetComponent<AABBColliderComponent>());
+}
+
+void SpatialHashing::InsertWithCollider(Actor *actor, AABBColliderComponent *collider)
 {
     // Compute positions for each vertex of the collider
     Vector2 position = actor->GetCenter();
@@ -60,6 +70,11 @@ void SpatialHashing::Insert(Actor *actor)
 
     // Insert collider into the grid cell
     mGrid[row][col].push_back(actor);
+    mCellColliders[row][col].push_back(collider);
+    if (collider)
+    {
+        mCellLayers[row][col] |= LayerMask(collider->GetLayer());
+    }
     mPositions[actor] = position;
     mCellIndices[actor] = std::make_pair(row, col);
 
@@ -91,7 +106,16 @@ void SpatialHashing::Remove(Actor *actor)
 
     // Remove the collider from the grid cell
     auto &cell = mGrid[row][col];
-    cell.erase(std::remove(cell.begin(), cell.end(), actor), cell.end());
+    auto &colliders = mCellColliders[row][col];
+    for (size_t i = cell.size(); i-- > 0;)
+    {
+        if (cell[i] == actor)
+        {
+            cell.erase(cell.begin() + i);
+            colliders.erase(colliders.begin() + i);
+        }
+    }
+    UpdateCellLayers(row, col);
 
     // Remove from positions and indices maps
     mPositions.erase(actor);
@@ -122,10 +146,67 @@ void SpatialHashing::Remove(Actor *actor)
     }
 }
 
+void SpatialHashing::GetActors(std::vector<Actor *> &actors) const
+{
+    actors.reserve(actors.size() + mCellIndices.size());
+    for (const auto &entry : mCellIndices)
+    {
+        actors.push_back(entry.first);
+    }
+}
+
 void SpatialHashing::Reinsert(Actor *actor)
 {
+    auto it = mCellIndices.find(actor);
+    if (it == mCellIndices.end())
+    {
+        Insert(actor);
+        return;
+    }
+
+    int row = it->second.first;
+    int col = it->second.second;
+
+    // The collider moves along, no need to look it up again
+    const auto &cell = mGrid[row][col];
+    size_t index = std::find(cell.begin(), cell.end(), actor) - cell.begin();
+    AABBColliderComponent *collider = mCellColliders[row][col][index];
+
     Remove(actor);
-    Insert(actor);
+    InsertWithCollider(actor, collider);
+}
+
+void SpatialHashing::UpdateCollider(Actor *actor)
+{
+    auto it = mCellIndices.find(actor);
+    if (it == mCellIndices.end())
+        return;
+
+    int row = it->second.first;
+    int col = it->second.second;
+
+    const auto &cell = mGrid[row][col];
+    for (size_t i = 0; i < cell.size(); i++)
+    {
+        if (cell[i] == actor)
+        {
+            mCellColliders[row][col][i] = actor->GetComponent<AABBColliderComponent>();
+        }
+    }
+    UpdateCellLayers(row, col);
+}
+
+void SpatialHashing::UpdateCellLayers(int row, int col)
+{
+    ColliderLayerMask layers = 0;
+    for (AABBColliderComponent *collider : mCellColliders[row][col])
+    {
+        if (collider)
+        {
+            layers |= LayerMask(collider->GetLayer());
+        }
+    }
+    mCellLayers[row][col] = layers;
 }
 
 std::vector<Actor *> SpatialHashing::Query(const Vector2 &position, const int range) const
@@ -156,23 +237,53 @@ std::vector<Actor *> SpatialHashing::Query(const Vector2 &position, const int ra
         }
     }
 
+    ENGINE_STAT(Stat::SpatialQueries, 1);
+    ENGINE_STAT(Stat::SpatialCandidates, static_cast<int>(results.size()));
+
     return results;
 }
 
-std::vector<AABBColliderComponent *> SpatialHashing::QueryColliders(const Vector2 &position, const int range) const
+std::vector<AABBColliderComponent *> SpatialHashing::QueryColliders(const Vector2 &position, const int range,
+                                                                    ColliderLayerMask layers) const
 {
     std::vector<AABBColliderComponent *> results;
 
-    std::vector<Actor *> actors = Query(position, range);
-    for (Actor *actor : actors)
+    int col = static_cast<int>(position.x / mCellSize);
+    int row = static_cast<int>(position.y / mCellSize);
+
+    // Ensure indices are within bounds
+    if (col < 0 || col >= mGrid[0].size() || row < 0 || row >= mGrid.size())
     {
-        auto collider = actor->GetComponent<AABBColliderComponent>();
-        if (collider)
+        return results; // Out of bounds
+    }
+
+    for (int r = row - range; r <= row + range; ++r)
+    {
+        for (int c = col - range; c <= col + range; ++c)
         {
-            results.push_back(collider);
+            if (r < 0 || r >= mGrid.size() || c < 0 || c >= mGrid[0].size())
+            {
+                continue; // Skip out of bounds cells
+            }
+
+            if ((mCellLayers[r][c] & layers) == 0)
+            {
+                continue; // Nothing on the wanted layers
+            }
+
+            for (AABBColliderComponent *collider : mCellColliders[r][c])
+            {
+                if (collider && (LayerMask(collider->GetLayer()) & layers))
+                {
+                    results.push_back(collider);
+                }
+            }
         }
     }
 
+    ENGINE_STAT(Stat::SpatialQueries, 1);
+    ENGINE_STAT(Stat::SpatialCandidates, static_cast<int>(results.size()));
+
     return results;
 }
 
@@ -181,35 +292,53 @@ std::vector<Actor *> SpatialHashing::QueryOnCamera(const Vector2 &cameraPosition
                                                    const float screenHeight,
                                                    const float extraRadius) const
 {
-    std::vector<Actor *> results;
+    std::vector<Actor *> results, ring;
+    QueryOnCamera(cameraPosition, screenWidth, screenHeight, extraRadius, extraRadius, results, ring);
+    return results;
+}
+
+void SpatialHashing::QueryOnCamera(const Vector2 &cameraPosition,
+                                   const float screenWidth,
+                                   const float screenHeight,
+                                   const float innerRadius,
+                                   const float outerRadius,
+                                   std::vector<Actor *> &inner,
+                                   std::vector<Actor *> &outer) const
+{
+    inner.clear();
+    outer.clear();
 
-    // Get the camera vertices
-    Vector2 topLeft = Vector2(cameraPosition.x - extraRadius, cameraPosition.y - extraRadius);
-    Vector2 bottomRight = Vector2(cameraPosition.x + screenWidth + extraRadius, cameraPosition.y + screenHeight + extraRadius);
+    // Grid cells covered by the camera grown by a radius, clamped to the grid
+    auto cameraCells = [&](float radius, int &startCol, int &startRow, int &endCol, int &endRow)
+    {
+        Vector2 topLeft = Vector2(cameraPosition.x - radius, cameraPosition.y - radius);
+        Vector2 bottomRight = Vector2(cameraPosition.x + screenWidth + radius, cameraPosition.y + screenHeight + radius);
 
-    // Calculate the grid cells that the camera covers
-    int startCol = static_cast<int>(topLeft.x / mCellSize);
-    int startRow = static_cast<int>(topLeft.y / mCellSize);
-    int endCol = static_cast<int>(bottomRight.x / mCellSize);
-    int endRow = static_cast<int>(bottomRight.y / mCellSize);
+        startCol = std::max(0, static_cast<int>(topLeft.x / mCellSize));
+        startRow = std::max(0, static_cast<int>(topLeft.y / mCellSize));
+        endCol = std::min(static_cast<int>(mGrid[0].size()) - 1, static_cast<int>(bottomRight.x / mCellSize));
+        endRow = std::min(static_cast<int>(mGrid.size()) - 1, static_cast<int>(bottomRight.y / mCellSize));
+    };
 
-    // Ensure indices are within bounds
-    startCol = std::max(0, startCol);
-    startRow = std::max(0, startRow);
-    endCol = std::min(static_cast<int>(mGrid[0].size()) - 1, endCol);
-    endRow = std::min(static_cast<int>(mGrid.size()) - 1, endRow);
+    int innerStartCol, innerStartRow, innerEndCol, innerEndRow;
+    int startCol, startRow, endCol, endRow;
+    cameraCells(innerRadius, innerStartCol, innerStartRow, innerEndCol, innerEndRow);
+    cameraCells(std::max(innerRadius, outerRadius), startCol, startRow, endCol, endRow);
 
-    // Check the cells within the camera bounds
+    // Check the cells within the outer bounds
     for (int r = startRow; r <= endRow; ++r)
     {
         for (int c = startCol; c <= endCol; ++c)
         {
             const auto &cell = mGrid[r][c];
+            bool isInner = r >= innerStartRow && r <= innerEndRow && c >= innerStartCol && c <= innerEndCol;
+            auto &results = isInner ? inner : outer;
             results.insert(results.end(), cell.begin(), cell.end());
         }
     }
 
-    return results;
+    ENGINE_STAT(Stat::SpatialQueries, 1);
+    ENGINE_STAT(Stat::SpatialCandidates, static_cast<int>(inner.size() + outer.size()));
 }
 
 std::vector<Cell> SpatialHashing::findPath(
@@ -16,6 +16,7 @@
 #include "../libs/Math.h"
 #include "../actors/Actor.h"
 #include "../actors/Tile.h"
+#include "../components/collider/AABBColliderComponent.h"
 
 struct Cell {
     int row, col;
@@ -50,13 +51,29 @@ public:
     void Remove(Actor *actor);
     void Reinsert(Actor *actor);
 
-    std::vector<AABBColliderComponent *> QueryColliders(const Vector2& position, const int range = 1) const;
+    // Actors are inserted by their constructor, before their collider exists. The collider
+    // calls this once created so the cell files it under its layer
+    void UpdateCollider(Actor *actor);
+
+    // Colliders in the surrounding cells whose layer is in the mask. Cells without any of
+    // those layers are skipped without looking at their occupants
+    std::vector<AABBColliderComponent *> QueryColliders(const Vector2& position, const int range = 1,
+                                                        ColliderLayerMask layers = ALL_COLLIDER_LAYERS) const;
 
     std::vector<Actor*> Query(const Vector2& position, const int range = 1) const;
     std::vector<Actor*> QueryOnCamera(const Vector2& cameraPosition,
                                       const float screenWidth,
                                       const float screenHeight,
                                       const float extraRadius = 0.0f) const;
+    // Actors in the cells covered by the camera plus innerRadius go to inner, the ones in
+    // the ring out to outerRadius to outer. Buffers are cleared first so callers can reuse them
+    void QueryOnCamera(const Vector2& cameraPosition,
+                       const float screenWidth,
+                       const float screenHeight,
+                       const float innerRadius,
+                       const float outerRadius,
+                       std::vector<Actor*>& inner,
+                       std::vector<Actor*>& outer) const;
 
     std::vector<SDL_Rect> GetPath(
         Actor *targetActor, const Vector2& end, bool canFly = false
@@ -71,6 +88,9 @@ public:
 
     Tile* GetTileAtPos(const Vector2& position) const;
 
+    // Every inserted actor, in no particular order
+    void GetActors(std::vector<Actor*>& actors) const;
+
 private:
     int mCellSize;
     int mWidth;
@@ -78,9 +98,14 @@ private:
 
     std::vector<std::vector<CellType>> mCellTypes; // 2D grid of cell types
     std::vector<std::vector<std::vector<Actor*> >> mGrid; // 2D grid of colliders
+    std::vector<std::vector<std::vector<AABBColliderComponent*> >> mCellColliders; // same order as mGrid, null without one
+    std::vector<std::vector<ColliderLayerMask>> mCellLayers; // layers of the colliders in each cell
     std::unordered_map<Actor*, Vector2> mPositions; // Maps collider to its position
     std::unordered_map<Actor*, std::pair<int, int>> mCellIndices; // Maps collider to its grid cell indices
 
+    void InsertWithCollider(Actor *actor, AABBColliderComponent *collider);
+    void UpdateCellLayers(int row, int col);
+
     std::vector<Cell> findPath(
         const std::vector<std::vector<CellType>>& grid, 
         Cell start, Cell end,
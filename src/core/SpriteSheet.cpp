@@ -0,0 +1,167 @@
+#include "SpriteSheet.h"
+#include "Game.h"
+#include "../libs/Json.h"
+#include <algorithm>
+#include <fstream>
+
+// Function statics, so ids can be interned during static initialization
+static std::unordered_map<std::string, AnimationId> &GetAnimationIds()
+{
+    static std::unordered_map<std::string, AnimationId> ids;
+    return ids;
+}
+
+static std::vector<std::string> &GetAnimationNames()
+{
+    static std::vector<std::string> names;
+    return names;
+}
+
+AnimationId InternAnimation(const std::string &name)
+{
+    auto &ids = GetAnimationIds();
+    auto iter = ids.find(name);
+    if (iter != ids.end())
+    {
+        return iter->second;
+    }
+
+    auto &names = GetAnimationNames();
+    AnimationId id = static_cast<AnimationId>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+const std::string &GetAnimationName(AnimationId id)
+{
+    static const std::string none;
+
+    const auto &names = GetAnimationNames();
+    if (id < 0 || id >= static_cast<int>(names.size()))
+    {
+        return none;
+    }
+    return names[id];
+}
+
+AnimationClipTable::AnimationClipTable(const std::vector<AnimationDefinition> &definitions)
+{
+    size_t numFrames = 0;
+    AnimationId maxId = -1;
+    for (const auto &definition : definitions)
+    {
+        numFrames += definition.frames.size();
+        maxId = std::max(maxId, definition.id);
+    }
+
+    // The pool is filled before the clips point into it
+    mFrames.reserve(numFrames);
+    for (const auto &definition : definitions)
+    {
+        mFrames.insert(mFrames.end(), definition.frames.begin(), definition.frames.end());
+    }
+
+    mClipOfId.assign(maxId + 1, -1);
+    mClips.reserve(definitions.size());
+
+    const int *frames = mFrames.data();
+    for (const auto &definition : definitions)
+    {
+        mClipOfId[definition.id] = static_cast<int>(mClips.size());
+        mClips.push_back({definition.id, frames, static_cast<int>(definition.frames.size()), definition.isLoop});
+        frames += definition.frames.size();
+    }
+}
+
+void AnimationClipTable::GetDefinitions(std::vector<AnimationDefinition> &definitions) const
+{
+    for (const auto &clip : mClips)
+    {
+        definitions.push_back({clip.id, std::vector<int>(clip.frames, clip.frames + clip.numFrames), clip.isLoop});
+    }
+}
+
+static void ParseFrames(const nlohmann::json &data, std::vector<SDL_Rect> &frames)
+{
+    if (!data.contains("frames"))
+        return;
+
+    frames.reserve(data["frames"].size());
+    for (const auto &frame : data["frames"])
+    {
+        frames.push_back({
+            frame["frame"]["x"].get<int>(),
+            frame["frame"]["y"].get<int>(),
+            frame["frame"]["w"].get<int>(),
+            frame["frame"]["h"].get<int>()});
+    }
+}
+
+SpriteSheet::SpriteSheet(Game *game, const std::string &texturePath, const std::string &dataPath)
+    : mTexture(nullptr)
+{
+    mTexture = game->LoadTexture(texturePath);
+    ParseFrames(game->LoadJson(dataPath), mFrames);
+}
+
+SpriteSheet::SpriteSheet(SDL_Texture *texture, std::vector<SDL_Rect> frames)
+    : mTexture(texture), mFrames(std::move(frames))
+{
+}
+
+bool SpriteSheet::LoadFrames(const std::string &dataPath, std::vector<SDL_Rect> &frames)
+{
+    std::ifstream file(dataPath);
+    if (!file.is_open())
+        return false;
+
+    nlohmann::json data = nlohmann::json::parse(file, nullptr, false);
+    if (data.is_discarded() || !data.contains("frames"))
+        return false;
+
+    ParseFrames(data, frames);
+    return true;
+}
+
+SpriteSheet::~SpriteSheet()
+{
+    for (auto &table : mClipTables)
+    {
+        delete table.second;
+    }
+    mClipTables.clear();
+
+    if (mTexture)
+    {
+        SDL_DestroyTexture(mTexture);
+        mTexture = nullptr;
+    }
+}
+
+const AnimationClipTable *SpriteSheet::GetClipTable(const std::vector<AnimationDefinition> &definitions)
+{
+    // Names are interned, so the key is made of the ids, frames and loop flags
+    std::string key;
+    for (const auto &definition : definitions)
+    {
+        key += std::to_string(definition.id);
+        key += definition.isLoop ? ':' : '!';
+        for (int frame : definition.frames)
+        {
+            key += std::to_string(frame);
+            key += ',';
+        }
+        key += ';';
+    }
+
+    auto iter = mClipTables.find(key);
+    if (iter != mClipTables.end())
+    {
+        return iter->second;
+    }
+
+    AnimationClipTable *table = new AnimationClipTable(definitions);
+    mClipTables.emplace(key, table);
+    return table;
+}
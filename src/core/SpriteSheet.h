@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <SDL.h>
+
+// Animation names are interned once into small integers, components compare and look up
+// clips by id instead of hashing strings every frame
+typedef int AnimationId;
+AnimationId InternAnimation(const std::string &name);
+const std::string &GetAnimationName(AnimationId id);
+
+struct AnimationClip
+{
+    AnimationId id;
+    const int *frames; // into the table's frame pool
+    int numFrames;
+    bool isLoop;
+};
+
+struct AnimationDefinition
+{
+    AnimationId id;
+    std::vector<int> frames;
+    bool isLoop;
+};
+
+// Clips compiled into contiguous arrays indexed by id. Tables are immutable once built,
+// so components keep pointers to them and to their clips
+class AnimationClipTable
+{
+public:
+    explicit AnimationClipTable(const std::vector<AnimationDefinition> &definitions);
+
+    AnimationClipTable(const AnimationClipTable &) = delete;
+    AnimationClipTable &operator=(const AnimationClipTable &) = delete;
+
+    const AnimationClip *Find(AnimationId id) const
+    {
+        if (id < 0 || id >= static_cast<int>(mClipOfId.size()) || mClipOfId[id] < 0)
+            return nullptr;
+        return &mClips[mClipOfId[id]];
+    }
+
+    void GetDefinitions(std::vector<AnimationDefinition> &definitions) const;
+
+private:
+    std::vector<int> mFrames;
+    std::vector<AnimationClip> mClips;
+    std::vector<int> mClipOfId; // -1 for ids without a clip
+};
+
+// Texture, frame rectangles and compiled clip tables of one sprite sheet. Loaded once by
+// Game and shared by every DrawAnimatedComponent drawing it
+class SpriteSheet
+{
+public:
+    SpriteSheet(class Game *game, const std::string &texturePath, const std::string &dataPath);
+    // Takes ownership of the texture
+    SpriteSheet(SDL_Texture *texture, std::vector<SDL_Rect> frames);
+    ~SpriteSheet();
+
+    // Frame rectangles of a sheet's json (aseprite format). Reads the file itself, so it can
+    // run on a worker thread
+    static bool LoadFrames(const std::string &dataPath, std::vector<SDL_Rect> &frames);
+
+    // Sprite sheets own their texture, so they must not be copied around.
+    SpriteSheet(const SpriteSheet &) = delete;
+    SpriteSheet &operator=(const SpriteSheet &) = delete;
+
+    SDL_Texture *GetTexture() const { return mTexture; }
+    const std::vector<SDL_Rect> &GetFrames() const { return mFrames; }
+
+    // Components that define the same clips on this sheet share one table
+    const AnimationClipTable *GetClipTable(const std::vector<AnimationDefinition> &definitions);
+
+private:
+    SDL_Texture *mTexture;
+    std::vector<SDL_Rect> mFrames;
+    std::unordered_map<std::string, AnimationClipTable *> mClipTables; // by definitions
+};
@@ -210,15 +210,13 @@ void DialogueStep::Initialize()
 void SpawnJoystickButtonStep::OnProcessInput(const std::vector<SDL_Event>& events) {
     if (GetIsComplete() || !mAnimation) return;
 
-    SDL_GameController* controller = mGame->GetController();
-
-    if (mButton == Button::RT && SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_TRIGGERRIGHT) > 0) {
+    if (mButton == Button::RT && mGame->GetControllerAxis(SDL_CONTROLLER_AXIS_TRIGGERRIGHT) > 0) {
         mGame->GetHUD()->RemoveAnimation(mAnimation);
         SetComplete();  
         return;
     }
 
-    if (mButton != Button::LT && SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_TRIGGERLEFT) > 0) {
+    if (mButton != Button::LT && mGame->GetControllerAxis(SDL_CONTROLLER_AXIS_TRIGGERLEFT) > 0) {
         mGame->GetHUD()->RemoveAnimation(mAnimation);
         SetComplete();  
         return;
@@ -0,0 +1,349 @@
+#include "StressTest.h"
+#include "Game.h"
+#include "SpatialHashing.h"
+#include "../actors/Zoe.h"
+#include "../actors/enemies/Sith.h"
+#include "../actors/enemies/Zod.h"
+#include "../actors/traps/Spikes.h"
+#include "../actors/traps/Spear.h"
+#include "../actors/traps/Shuriken.h"
+#include "../actors/traps/ProjectileEmitter.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+// Nebula-Terrain tiles, as the tests map uses them (gid = local id + 1)
+static const int TILE_CEILING = 36;
+static const int TILE_FLOOR = 2;
+static const int TILE_LEFT_WALL = 20;
+static const int TILE_RIGHT_WALL = 18;
+static const int TILE_TOP_CORNER = 28;
+static const int TILE_BOTTOM_LEFT_CORNER = 78;
+static const int TILE_BOTTOM_RIGHT_CORNER = 79;
+
+// Rows of platforms every few tiles, so walkers have room and flyers have obstacles
+static const int PLATFORM_SPACING = 4;
+
+const Stat StressTest::REPORTED_STATS[NUM_REPORTED_STATS] = {
+    Stat::ActorsUpdated,
+    Stat::ActorsCoarseUpdated,
+    Stat::SpatialQueries,
+    Stat::AABBTests,
+    Stat::CollisionCallbacks,
+    Stat::DrawCalls,
+};
+
+static float Percentile(std::vector<float> values, float fraction)
+{
+    if (values.empty())
+        return 0.f;
+
+    std::sort(values.begin(), values.end());
+    return values[static_cast<size_t>(fraction * (values.size() - 1))];
+}
+
+static float Mean(const std::vector<float> &values)
+{
+    if (values.empty())
+        return 0.f;
+
+    float sum = 0.f;
+    for (float value : values)
+    {
+        sum += value;
+    }
+    return sum / values.size();
+}
+
+StressTest::StressTest(Game *game, const Settings &settings)
+    : mGame(game), mSettings(settings), mWidthInTiles(Game::LEVEL_WIDTH), mHeightInTiles(Game::LEVEL_HEIGHT),
+      mSpawnRadius(0), mWarmupFrames(0), mMeasuredFrames(1), mEmitterCooldown(1.f), mZoeLives(1),
+      mStep(-1), mFrameInStep(0), mNumEnemies(0), mNumTraps(0), mNumEmitters(0), mStatSums(), mReport(nullptr)
+{
+}
+
+StressTest::~StressTest()
+{
+    if (mReport)
+    {
+        std::fclose(mReport);
+    }
+}
+
+void StressTest::Initialize()
+{
+    Config *config = mGame->GetConfig();
+
+    auto fromConfig = [config](int value, const std::string &key) {
+        return value >= 0 ? value : config->Get<int>("STRESS_TEST." + key);
+    };
+
+    mSettings.enemies = fromConfig(mSettings.enemies, "ENEMIES");
+    mSettings.traps = fromConfig(mSettings.traps, "TRAPS");
+    mSettings.emitters = fromConfig(mSettings.emitters, "EMITTERS");
+    mSettings.steps = std::max(1, fromConfig(mSettings.steps, "STEPS"));
+
+    // Big enough for the camera and a row of platforms
+    mWidthInTiles = std::max(24, config->Get<int>("STRESS_TEST.MAP_WIDTH"));
+    mHeightInTiles = std::max(16, config->Get<int>("STRESS_TEST.MAP_HEIGHT"));
+    mSpawnRadius = config->Get<int>("STRESS_TEST.SPAWN_RADIUS_TILES");
+    mWarmupFrames = std::max(0, config->Get<int>("STRESS_TEST.WARMUP_FRAMES"));
+    mMeasuredFrames = std::max(1, config->Get<int>("STRESS_TEST.MEASURED_FRAMES"));
+    mEmitterCooldown = config->Get<float>("STRESS_TEST.EMITTER_COOLDOWN");
+    mZoeLives = config->Get<int>("ZOE.LIFE_POINTS");
+    mRng.seed(config->Get<int>("STRESS_TEST.SEED"));
+
+    if (!mSettings.reportPath.empty())
+    {
+        mReport = std::fopen(mSettings.reportPath.c_str(), "w");
+        if (!mReport)
+        {
+            SDL_Log("Failed to open stress test report %s", mSettings.reportPath.c_str());
+            throw std::runtime_error("Failed to open stress test report: " + mSettings.reportPath);
+        }
+
+        std::fprintf(mReport, "step,enemies,traps,emitters,actors,frames,frame_ms_mean,frame_ms_p50,"
+                              "frame_ms_p95,frame_ms_max,update_ms_mean,output_ms_mean");
+        for (Stat stat : REPORTED_STATS)
+        {
+            std::fprintf(mReport, ",%s", EngineStats::GetName(stat));
+        }
+        std::fprintf(mReport, "\n");
+    }
+
+    SDL_Log("Stress test: %d enemies, %d traps, %d emitters in %d steps on a %dx%d map",
+            mSettings.enemies, mSettings.traps, mSettings.emitters, mSettings.steps, mWidthInTiles, mHeightInTiles);
+}
+
+nlohmann::json StressTest::GenerateMap()
+{
+    const int width = mWidthInTiles;
+    const int height = mHeightInTiles;
+    std::vector<int> tiles(width * height, 0);
+    auto at = [&tiles, width](int row, int col) -> int & { return tiles[row * width + col]; };
+
+    for (int col = 1; col < width - 1; col++)
+    {
+        at(0, col) = TILE_CEILING;
+        at(height - 1, col) = TILE_FLOOR;
+    }
+    for (int row = 1; row < height - 1; row++)
+    {
+        at(row, 0) = TILE_LEFT_WALL;
+        at(row, width - 1) = TILE_RIGHT_WALL;
+    }
+    at(0, 0) = TILE_TOP_CORNER;
+    at(0, width - 1) = TILE_TOP_CORNER;
+    at(height - 1, 0) = TILE_BOTTOM_LEFT_CORNER;
+    at(height - 1, width - 1) = TILE_BOTTOM_RIGHT_CORNER;
+
+    std::uniform_int_distribution<int> gapLength(2, 6);
+    std::uniform_int_distribution<int> platformLength(3, 8);
+    for (int row = height - 1 - PLATFORM_SPACING; row >= PLATFORM_SPACING; row -= PLATFORM_SPACING)
+    {
+        int col = 2 + gapLength(mRng);
+        while (col < width - 2)
+        {
+            int end = std::min(col + platformLength(mRng), width - 2);
+            for (; col < end; col++)
+            {
+                at(row, col) = TILE_FLOOR;
+            }
+            col += gapLength(mRng);
+        }
+    }
+
+    // Zoe starts on the floor, in the middle
+    const int zoeRow = height - 2;
+    const int zoeCol = width / 2;
+    const float tileSize = static_cast<float>(Game::TILE_SIZE);
+
+    mGroundCells.clear();
+    mAirCells.clear();
+    for (int row = 1; row < height - 1; row++)
+    {
+        for (int col = 1; col < width - 1; col++)
+        {
+            if (at(row, col) != 0 || (mSpawnRadius > 0 && std::abs(col - zoeCol) > mSpawnRadius))
+                continue;
+
+            Vector2 center((col + .5f) * tileSize, (row + .5f) * tileSize);
+            if (at(row + 1, col) != 0)
+                mGroundCells.push_back(center);
+            else if (at(row - 1, col) == 0)
+                mAirCells.push_back(center);
+        }
+    }
+
+    nlohmann::json zoeSpawn = {
+        {"id", 1},
+        {"x", zoeCol * Game::TILE_SIZE},
+        {"y", zoeRow * Game::TILE_SIZE},
+        {"width", Game::TILE_SIZE},
+        {"height", Game::TILE_SIZE},
+        {"properties", nlohmann::json::array({
+            {{"name", "entity_code"}, {"type", "int"}, {"value", static_cast<int>(MapObject::EntityCode::Zoe)}},
+            {{"name", "event"}, {"type", "string"}, {"value", "atStart"}},
+            {{"name", "function_name"}, {"type", "string"}, {"value", "spawn_entity"}},
+        })},
+    };
+
+    // Tile layers are drawn by their index, the first two stay empty
+    nlohmann::json data = {
+        {"width", width},
+        {"height", height},
+        {"tilewidth", Game::TILE_SIZE},
+        {"tileheight", Game::TILE_SIZE},
+        {"tilesets", nlohmann::json::array({{{"firstgid", 1}, {"source", "Nebula-Terrain.tsx"}}})},
+        {"layers", nlohmann::json::array({
+            {{"name", "ground"}, {"data", nlohmann::json::array()}},
+            {{"name", "detailsDown"}, {"data", nlohmann::json::array()}},
+            {{"name", "player"}, {"data", tiles}},
+            {{"name", "objects"}, {"objects", nlohmann::json::array({zoeSpawn})}},
+        })},
+    };
+
+    // The scene starts empty, the first step is the baseline
+    mStep = 0;
+    mFrameInStep = 0;
+    mNumEnemies = mNumTraps = mNumEmitters = 0;
+
+    return data;
+}
+
+Vector2 StressTest::PickCell(const std::vector<Vector2> &cells)
+{
+    std::uniform_int_distribution<size_t> index(0, cells.size() - 1);
+    return cells[index(mRng)];
+}
+
+void StressTest::SpawnStep(int step)
+{
+    const int enemies = mSettings.enemies * step / mSettings.steps;
+    const int traps = mSettings.traps * step / mSettings.steps;
+    const int emitters = mSettings.emitters * step / mSettings.steps;
+
+    if (!mGroundCells.empty())
+    {
+        for (; mNumEnemies < enemies; mNumEnemies++)
+        {
+            if (mNumEnemies % 2 == 0)
+                new Sith(mGame, PickCell(mGroundCells));
+            else
+                new Zod(mGame, PickCell(mGroundCells));
+        }
+
+        for (; mNumTraps < traps; mNumTraps++)
+        {
+            Vector2 cell = PickCell(mGroundCells);
+            if (mNumTraps % 3 == 0)
+                new Spikes(mGame, cell);
+            else if (mNumTraps % 3 == 1)
+                new Spear(mGame, cell);
+            else
+                new Shuriken(mGame, cell);
+        }
+    }
+
+    if (!mAirCells.empty())
+    {
+        for (; mNumEmitters < emitters; mNumEmitters++)
+        {
+            new ProjectileEmitter(mGame, PickCell(mAirCells), mEmitterCooldown);
+        }
+    }
+}
+
+void StressTest::EndFrame(float updateMs, float outputMs)
+{
+    if (mStep < 0)
+        return;
+
+    // Zoe dying would end the scene, and the measurement with it
+    if (mGame->GetGameScene() != Game::GameScene::StressTest)
+    {
+        SDL_Log("Stress test: the scene ended at step %d", mStep);
+        Finish();
+        return;
+    }
+
+    if (Zoe *zoe = mGame->GetZoe())
+    {
+        zoe->SetLifes(mZoeLives);
+    }
+
+    mFrameInStep++;
+    if (mFrameInStep <= mWarmupFrames)
+        return;
+
+    mUpdateMs.push_back(updateMs);
+    mOutputMs.push_back(outputMs);
+    for (int i = 0; i < NUM_REPORTED_STATS; i++)
+    {
+        mStatSums[i] += EngineStats::Get(REPORTED_STATS[i]);
+    }
+
+    if (mFrameInStep < mWarmupFrames + mMeasuredFrames)
+        return;
+
+    ReportStep();
+
+    if (mStep == mSettings.steps)
+    {
+        Finish();
+        return;
+    }
+
+    mStep++;
+    mFrameInStep = 0;
+    SpawnStep(mStep);
+}
+
+void StressTest::ReportStep()
+{
+    std::vector<float> frameMs(mUpdateMs.size());
+    for (size_t i = 0; i < frameMs.size(); i++)
+    {
+        frameMs[i] = mUpdateMs[i] + mOutputMs[i];
+    }
+
+    // Everything alive, projectiles and tiles included
+    std::vector<Actor *> actors;
+    mGame->GetSpatialHashing()->GetActors(actors);
+
+    const int frames = static_cast<int>(frameMs.size());
+    SDL_Log("Stress step %d: %d enemies, %d traps, %d emitters, %zu actors: %.2f ms mean, %.2f p95 "
+            "(update %.2f, output %.2f)",
+            mStep, mNumEnemies, mNumTraps, mNumEmitters, actors.size(), Mean(frameMs), Percentile(frameMs, .95f),
+            Mean(mUpdateMs), Mean(mOutputMs));
+
+    if (mReport)
+    {
+        std::fprintf(mReport, "%d,%d,%d,%d,%zu,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f", mStep, mNumEnemies, mNumTraps,
+                     mNumEmitters, actors.size(), frames, Mean(frameMs), Percentile(frameMs, .5f),
+                     Percentile(frameMs, .95f), Percentile(frameMs, 1.f), Mean(mUpdateMs), Mean(mOutputMs));
+        for (long long sum : mStatSums)
+        {
+            std::fprintf(mReport, ",%.1f", static_cast<double>(sum) / frames);
+        }
+        std::fprintf(mReport, "\n");
+        std::fflush(mReport);
+    }
+
+    mUpdateMs.clear();
+    mOutputMs.clear();
+    std::fill(std::begin(mStatSums), std::end(mStatSums), 0);
+}
+
+void StressTest::Finish()
+{
+    if (mReport)
+    {
+        std::fclose(mReport);
+        mReport = nullptr;
+        SDL_Log("Stress test report written to %s", mSettings.reportPath.c_str());
+    }
+
+    mStep = -1;
+    mGame->Quit();
+}
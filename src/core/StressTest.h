@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "EngineStats.h"
+#include "../libs/Json.h"
+#include "../libs/Math.h"
+
+// Scaling measurement for the StressTest scene: a generated tile map that fills up with enemies,
+// traps and projectile emitters in steps. Each step spawns its share of the population, lets a
+// few frames settle and records the next ones, one report row per step. Plotting frame time
+// against the counts shows where the update (AI, collision) or the drawing stops scaling.
+// Frames run uncapped with a fixed delta time; the engine counters need ASTRAL_PROFILER
+class StressTest
+{
+public:
+    // Negative values come from the STRESS_TEST section of the config
+    struct Settings
+    {
+        int enemies = -1;
+        int traps = -1;
+        int emitters = -1;
+        int steps = -1;
+        std::string reportPath; // CSV file, the rows are only logged when empty
+    };
+
+    StressTest(class Game *game, const Settings &settings);
+    ~StressTest();
+
+    StressTest(const StressTest &) = delete;
+    StressTest &operator=(const StressTest &) = delete;
+
+    // Reads the config, once the game has loaded it
+    void Initialize();
+
+    int GetWidthInTiles() const { return mWidthInTiles; }
+    int GetHeightInTiles() const { return mHeightInTiles; }
+
+    // Tiled map data for the scene: walls, rows of platforms and Zoe's spawn. Starts the first step
+    nlohmann::json GenerateMap();
+
+    // Called at the end of every frame with the time spent in the update and in the drawing
+    void EndFrame(float updateMs, float outputMs);
+
+private:
+    static const int NUM_REPORTED_STATS = 6;
+    static const Stat REPORTED_STATS[NUM_REPORTED_STATS];
+
+    void SpawnStep(int step);
+    Vector2 PickCell(const std::vector<Vector2> &cells);
+    void ReportStep();
+    void Finish();
+
+    class Game *mGame;
+    Settings mSettings;
+    int mWidthInTiles, mHeightInTiles;
+    int mSpawnRadius;
+    int mWarmupFrames, mMeasuredFrames;
+    float mEmitterCooldown;
+    int mZoeLives;
+    std::mt19937 mRng;
+
+    // Centers of empty cells, right above a solid tile or in the air, near Zoe's spawn
+    std::vector<Vector2> mGroundCells;
+    std::vector<Vector2> mAirCells;
+
+    int mStep; // -1 until the map is generated
+    int mFrameInStep;
+    int mNumEnemies, mNumTraps, mNumEmitters;
+
+    std::vector<float> mUpdateMs, mOutputMs;
+    long long mStatSums[NUM_REPORTED_STATS];
+
+    FILE *mReport;
+};
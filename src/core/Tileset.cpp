@@ -2,10 +2,9 @@
 #include <fstream>
 
 Tileset::Tileset(Game *game, std::string jsonPath)
-    : mGame(game)
+    : mGame(game), mTexture(nullptr)
 {
-    std::ifstream file(jsonPath);
-    json data = json::parse(file);
+    json data = mGame->LoadJson(jsonPath);
 
     mTileHeight = data["tileheight"];
     mTileWidth = data["tilewidth"];
@@ -66,6 +65,9 @@ Tileset::~Tileset()
     {
         return;
     }
+
+    SDL_DestroyTexture(mTexture);
+    mTexture = nullptr;
 }
 
 void Tileset::Print()
@@ -94,7 +96,7 @@ void Tileset::LoadTexture()
     mTexture = texture;
 }
 
-Vector2 Tileset::GetTilesetTexturePosition(int localGID)
+Vector2 Tileset::GetTilesetTexturePosition(int localGID) const
 {
     int tilesPerRow = mImageWidth / mTileWidth;
     int x = (localGID % tilesPerRow) * mTileWidth;
@@ -103,7 +105,7 @@ Vector2 Tileset::GetTilesetTexturePosition(int localGID)
     return Vector2(x, y);
 }
 
-Vector2 Tileset::GetBBOffset(int localID)
+Vector2 Tileset::GetBBOffset(int localID) const
 {
     const auto &extInfo = mTileExtraInfo.find(localID);
 
@@ -117,7 +119,7 @@ Vector2 Tileset::GetBBOffset(int localID)
     return Vector2(0.0f, 0.0f);
 }
 
-Vector2 Tileset::GetBBSize(int localID)
+Vector2 Tileset::GetBBSize(int localID) const
 {
     const auto &extInfo = mTileExtraInfo.find(localID);
 
@@ -27,14 +27,18 @@ public:
     Tileset(class Game* game, std::string jsonPath);
     ~Tileset();
 
+    // Tilesets own their texture, so they must not be copied around.
+    Tileset(const Tileset&) = delete;
+    Tileset& operator=(const Tileset&) = delete;
+
     void Print();
     std::string GetName() const { return mName; }
     SDL_Texture* GetTexture() const { return mTexture; }
 
     Vector2 GetTileDims() const { return Vector2(mTileWidth, mTileHeight); }
-    Vector2 GetTilesetTexturePosition(int localGID);
-    Vector2 GetBBOffset(int localID);
-    Vector2 GetBBSize(int localID);
+    Vector2 GetTilesetTexturePosition(int localGID) const;
+    Vector2 GetBBOffset(int localID) const;
+    Vector2 GetBBSize(int localID) const;
 
 private:
     int mImageWidth, mImageHeight;
@@ -0,0 +1,163 @@
+#include "TriggerIndex.h"
+#include "Profiler.h"
+#include "../actors/MapObject.h"
+#include "../components/collider/AABBColliderComponent.h"
+#include <algorithm>
+#include <cmath>
+
+TriggerIndex::TriggerIndex(int cellSize, int width, int height)
+    : mCellSize(cellSize), mStamp(0)
+{
+    mCols = std::max(1, (width + cellSize - 1) / cellSize);
+    mRows = std::max(1, (height + cellSize - 1) / cellSize);
+    mCells.resize(mCols * mRows);
+}
+
+void TriggerIndex::GetCellRange(const Vector2 &min, const Vector2 &max, int &col0, int &row0, int &col1, int &row1) const
+{
+    // Rectangles out of the grid are kept in its border cells
+    col0 = Math::Clamp(static_cast<int>(std::floor(min.x / mCellSize)), 0, mCols - 1);
+    row0 = Math::Clamp(static_cast<int>(std::floor(min.y / mCellSize)), 0, mRows - 1);
+    col1 = Math::Clamp(static_cast<int>(std::floor(max.x / mCellSize)), 0, mCols - 1);
+    row1 = Math::Clamp(static_cast<int>(std::floor(max.y / mCellSize)), 0, mRows - 1);
+}
+
+int TriggerIndex::Add(MapObject *object, const Vector2 &min, const Vector2 &max, bool alwaysEvaluated)
+{
+    int trigger;
+    if (!mFreeTriggers.empty())
+    {
+        trigger = mFreeTriggers.back();
+        mFreeTriggers.pop_back();
+    }
+    else
+    {
+        trigger = static_cast<int>(mTriggers.size());
+        mTriggers.emplace_back();
+    }
+
+    mTriggers[trigger] = {object, min, max, alwaysEvaluated, false, 0};
+
+    int col0, row0, col1, row1;
+    GetCellRange(min, max, col0, row0, col1, row1);
+    for (int row = row0; row <= row1; row++)
+    {
+        for (int col = col0; col <= col1; col++)
+        {
+            mCells[row * mCols + col].push_back(trigger);
+        }
+    }
+
+    if (alwaysEvaluated)
+    {
+        mAlwaysEvaluated.push_back(trigger);
+    }
+
+    return trigger;
+}
+
+void TriggerIndex::Remove(int trigger)
+{
+    auto erase = [trigger](std::vector<int> &triggers)
+    {
+        triggers.erase(std::remove(triggers.begin(), triggers.end(), trigger), triggers.end());
+    };
+
+    Trigger &removed = mTriggers[trigger];
+
+    int col0, row0, col1, row1;
+    GetCellRange(removed.min, removed.max, col0, row0, col1, row1);
+    for (int row = row0; row <= row1; row++)
+    {
+        for (int col = col0; col <= col1; col++)
+        {
+            erase(mCells[row * mCols + col]);
+        }
+    }
+
+    erase(mAlwaysEvaluated);
+    erase(mInside);
+    erase(mWasInside);
+
+    removed.object = nullptr;
+    mFreeTriggers.push_back(trigger);
+}
+
+void TriggerIndex::Update(const AABBColliderComponent *player)
+{
+    PROFILE_ZONE("UpdateTriggers");
+
+    mStamp++;
+    mWasInside.swap(mInside);
+    mInside.clear();
+
+    Vector2 playerMin;
+    Vector2 playerMax;
+    if (player && player->IsEnabled())
+    {
+        playerMin = player->GetMin();
+        playerMax = player->GetMax();
+
+        int col0, row0, col1, row1;
+        GetCellRange(playerMin, playerMax, col0, row0, col1, row1);
+        for (int row = row0; row <= row1; row++)
+        {
+            for (int col = col0; col <= col1; col++)
+            {
+                for (int trigger : mCells[row * mCols + col])
+                {
+                    Trigger &candidate = mTriggers[trigger];
+                    if (candidate.stamp == mStamp)
+                        continue;
+
+                    // Same test as AABBColliderComponent::Intersect
+                    if (playerMin.x < candidate.max.x && playerMax.x > candidate.min.x &&
+                        playerMin.y < candidate.max.y && playerMax.y > candidate.min.y)
+                    {
+                        candidate.stamp = mStamp;
+                        mInside.push_back(trigger);
+                    }
+                }
+            }
+        }
+    }
+
+    // Triggers fired below may add others, so they are indexed again after each call.
+    // Those added now are evaluated from the next Update
+    size_t numWasInside = mWasInside.size();
+    for (size_t i = 0; i < numWasInside && i < mWasInside.size(); i++)
+    {
+        int trigger = mWasInside[i];
+        if (mTriggers[trigger].stamp == mStamp)
+            continue;
+
+        mTriggers[trigger].stamp = mStamp;
+        mTriggers[trigger].isPlayerInside = false;
+        mTriggers[trigger].object->Evaluate(false, true, false);
+    }
+
+    size_t numInside = mInside.size();
+    for (size_t i = 0; i < numInside && i < mInside.size(); i++)
+    {
+        int trigger = mInside[i];
+        Trigger &inside = mTriggers[trigger];
+
+        bool wasInside = inside.isPlayerInside;
+        bool isContained = playerMin.x >= inside.min.x && playerMax.x <= inside.max.x &&
+                           playerMin.y >= inside.min.y && playerMax.y <= inside.max.y;
+
+        inside.isPlayerInside = true;
+        inside.object->Evaluate(true, wasInside, isContained);
+    }
+
+    size_t numAlwaysEvaluated = mAlwaysEvaluated.size();
+    for (size_t i = 0; i < numAlwaysEvaluated && i < mAlwaysEvaluated.size(); i++)
+    {
+        int trigger = mAlwaysEvaluated[i];
+        if (mTriggers[trigger].stamp == mStamp)
+            continue;
+
+        mTriggers[trigger].stamp = mStamp;
+        mTriggers[trigger].object->Evaluate(false, false, false);
+    }
+}
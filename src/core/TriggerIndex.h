@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include "../libs/Math.h"
+
+// Static grid of the map's trigger rectangles (MapObjects). Once per frame Update queries it
+// with the player's box and lets only the triggers that can fire evaluate their event: the
+// ones the player is in or just left, plus those that don't depend on overlapping at all
+class TriggerIndex
+{
+public:
+    TriggerIndex(int cellSize, int width, int height);
+
+    TriggerIndex(const TriggerIndex &) = delete;
+    TriggerIndex &operator=(const TriggerIndex &) = delete;
+
+    // alwaysEvaluated triggers are evaluated every frame, wherever the player is
+    int Add(class MapObject *object, const Vector2 &min, const Vector2 &max, bool alwaysEvaluated);
+    void Remove(int trigger);
+
+    // Without a player nothing overlaps, so the triggers the player was in see it leave
+    void Update(const class AABBColliderComponent *player);
+
+    int GetNumTriggers() const { return static_cast<int>(mTriggers.size() - mFreeTriggers.size()); }
+
+private:
+    struct Trigger
+    {
+        class MapObject *object; // null in free slots
+        Vector2 min;
+        Vector2 max;
+        bool alwaysEvaluated;
+        bool isPlayerInside;
+        unsigned int stamp; // last Update that found the player inside or evaluated it
+    };
+
+    void GetCellRange(const Vector2 &min, const Vector2 &max, int &col0, int &row0, int &col1, int &row1) const;
+
+    int mCellSize;
+    int mCols;
+    int mRows;
+    std::vector<std::vector<int>> mCells; // row major, triggers overlapping each cell
+
+    std::vector<Trigger> mTriggers;
+    std::vector<int> mFreeTriggers;
+    std::vector<int> mAlwaysEvaluated;
+
+    unsigned int mStamp;
+    std::vector<int> mInside; // triggers the player is in, since the last Update
+    std::vector<int> mWasInside;
+};
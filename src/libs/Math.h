@@ -115,23 +115,29 @@ namespace Math
 		return fmod(numer, denom);
 	}
 
-	inline float RandRange(float min, float max)
+	// Static para não recriar o engine a cada chamada, shared by RandRange and RandRangeInt
+	inline std::mt19937 &RandGenerator()
+	{
+		static std::mt19937 gen(std::random_device{}());
+		return gen;
+	}
+
+	// Input replays reseed it so a session plays out the same way
+	inline void SeedRand(unsigned int seed)
 	{
-		// Static para não recriar o engine a cada chamada
-		static std::random_device rd;
-		static std::mt19937 gen(rd());
+		RandGenerator().seed(seed);
+	}
 
+	inline float RandRange(float min, float max)
+	{
 		std::uniform_real_distribution<float> distrib(min, max);
-		return distrib(gen);
+		return distrib(RandGenerator());
 	}
 
 	inline int RandRangeInt(int min, int max)
 	{
-		static std::random_device rd;
-		static std::mt19937 gen(rd());
-
 		std::uniform_int_distribution<int> distrib(min, max);
-		return distrib(gen);
+		return distrib(RandGenerator());
 	}
 }
 
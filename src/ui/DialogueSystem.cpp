@@ -4,50 +4,31 @@
 #include "../actors/Zoe.h"
 
 DialogueSystem::DialogueSystem(Game::GamePlayState currentGameState)
-    : mGame(nullptr), mFont(nullptr), mSmallFont(nullptr), mCurrentLine(0), mTextTexture(nullptr),
-      mIsActive(false), mContinuePressed(false), mPromptTexture(nullptr), mPreviousGameState(currentGameState),
-      mSpeakerName(""), mSpeakerTexture(nullptr), mSpeakerOffset(-5.0f, -10.0f), mTextOffset(0.0f, 0.0f),
+    : mGame(nullptr), mAtlas(nullptr), mSmallAtlas(nullptr), mCurrentLine(0),
+      mIsActive(false), mContinuePressed(false), mPreviousGameState(currentGameState),
+      mSpeakerName(""), mSpeakerOffset(-5.0f, -10.0f), mTextOffset(0.0f, 0.0f),
       mLineTimer(0.0f), mLineDuration(15.0f), mStepDialogueSound(SoundHandle::Invalid)
 {
 }
 
 DialogueSystem::~DialogueSystem()
 {
-    if (mFont)
-    {
-        TTF_CloseFont(mFont);
-    }
-    if (mSmallFont)
-    {
-        TTF_CloseFont(mSmallFont);
-    }
-    if (mTextTexture)
-    {
-        SDL_DestroyTexture(mTextTexture);
-    }
-    if (mPromptTexture)
-    {
-        SDL_DestroyTexture(mPromptTexture);
-    }
-    if (mSpeakerTexture)
-    {
-        SDL_DestroyTexture(mSpeakerTexture);
-    }
 }
 
 void DialogueSystem::Initialize(Game* game)
 {
     mGame = game;
-    mFont = TTF_OpenFont("../assets/Fonts/SMB.ttf", 24);
-    if (!mFont)
+
+    // Glyph caches shared with the rest of the UI, a new line only lays out quads
+    UIFont* font = mGame->LoadFont(mGame->FONT_PATH_SMB);
+    if (font)
     {
-        SDL_Log("Falha ao carregar a fonte para DialogueSystem: %s", TTF_GetError());
+        mAtlas = font->GetAtlas(24);
+        mSmallAtlas = font->GetAtlas(16);
     }
-
-    mSmallFont = TTF_OpenFont("../assets/Fonts/SMB.ttf", 16);
-    if (!mSmallFont)
+    if (!mAtlas || !mSmallAtlas)
     {
-        SDL_Log("Falha ao carregar a fonte pequena para DialogueSystem: %s", TTF_GetError());
+        SDL_Log("Falha ao carregar a fonte para DialogueSystem");
     }
 
     int windowWidth = mGame->GetRealWindowWidth();
@@ -56,21 +37,15 @@ void DialogueSystem::Initialize(Game* game)
     int mHeight = static_cast<int>(windowWidth * 1/6);
     mBoxRect = {windowWidth / 2 - mWidth / 2, windowHeight - mHeight - 10, mWidth, mHeight};
 
-    if (mSmallFont)
+    if (mSmallAtlas)
     {
-        SDL_Color grey = {180, 180, 180, 255};
-        SDL_Surface* surface = TTF_RenderText_Blended(mSmallFont, "Pressione B", grey);
-        if (surface)
-        {
-            mPromptTexture = SDL_CreateTextureFromSurface(mGame->GetRenderer(), surface);
-            mPromptRect.w = surface->w;
-            mPromptRect.h = surface->h;
-            SDL_FreeSurface(surface);
-        }
+        mSmallAtlas->Layout("Pressione B", 0, mPromptLayout);
+        mPromptRect.w = mPromptLayout.width;
+        mPromptRect.h = mPromptLayout.height;
     }
 
-    // Create initial speaker texture (empty)
-    CreateSpeakerTexture();
+    // Lay out the initial speaker (empty)
+    LayoutSpeaker();
 }
 
 void DialogueSystem::StartDialogue(const std::vector<std::string>& lines, std::function<void()> onComplete)
@@ -86,7 +61,7 @@ void DialogueSystem::StartDialogue(const std::vector<std::string>& lines, std::f
 
     mGame->SetGamePlayState(Game::GamePlayState::Dialogue);
 
-    CreateTextTexture();
+    LayoutText();
     mPromptRect.x = mBoxRect.x + mBoxRect.w - mPromptRect.w - 20;
     mPromptRect.y = mBoxRect.y + mBoxRect.h - mPromptRect.h - 15;
     
@@ -116,11 +91,8 @@ void DialogueSystem::HandleInput(const uint8_t* keyState)
 {
     if (!mIsActive) return;
 
-    SDL_GameController *controller = mGame->GetController();
-    const bool hasController = controller && SDL_GameControllerGetAttached(controller);
-
     if (keyState[SDL_SCANCODE_RETURN] || keyState[SDL_SCANCODE_KP_ENTER] ||
-        (hasController && SDL_GameControllerGetButton(controller, SDL_CONTROLLER_BUTTON_B)))
+        mGame->GetControllerButton(SDL_CONTROLLER_BUTTON_B))
     {
         if (!mContinuePressed)
         {
@@ -164,7 +136,8 @@ void DialogueSystem::Draw(SDL_Renderer* renderer)
     }
 
     // Draw speaker box only if speaker name is not empty
-    if (mSpeakerTexture && !mSpeakerName.empty())
+    SDL_Color white = {255, 255, 255, 255};
+    if (mAtlas && !mSpeakerName.empty())
     {
         // Draw background for speaker
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
@@ -175,60 +148,41 @@ void DialogueSystem::Draw(SDL_Renderer* renderer)
         SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
         SDL_RenderDrawRect(renderer, &speakerBgRect);
         
-        SDL_RenderCopy(renderer, mSpeakerTexture, nullptr, &mSpeakerRect);
+        mAtlas->Draw(mSpeakerLayout, mSpeakerRect, white);
     }
 
-    if (mTextTexture)
+    if (mAtlas)
     {
-        SDL_RenderCopy(renderer, mTextTexture, nullptr, &mTextRect);
+        mAtlas->Draw(mTextLayout, mTextRect, white);
     }
     
     // Move prompt above the dialogue box
-    if (mPromptTexture)
+    if (mSmallAtlas)
     {
-        SDL_RenderCopy(renderer, mPromptTexture, nullptr, &mPromptRect);
+        mSmallAtlas->Draw(mPromptLayout, mPromptRect, SDL_Color{180, 180, 180, 255});
     }
 }
 
-void DialogueSystem::CreateTextTexture()
+void DialogueSystem::LayoutText()
 {
-    if (mTextTexture)
-    {
-        SDL_DestroyTexture(mTextTexture);
-    }
+    if (!mAtlas)
+        return;
 
-    SDL_Color white = {255, 255, 255, 255};
-    SDL_Surface* surface = TTF_RenderText_Blended_Wrapped(mFont, mLines[mCurrentLine].c_str(), white, mBoxRect.w - 40);
-    if (surface)
-    {
-        mTextTexture = SDL_CreateTextureFromSurface(mGame->GetRenderer(), surface);
-        mTextRect = {mBoxRect.x + 20 + static_cast<int>(mTextOffset.x), 
-                     mBoxRect.y + 20 + static_cast<int>(mTextOffset.y), 
-                     surface->w, surface->h};
-        SDL_FreeSurface(surface);
-    }
+    mAtlas->Layout(mLines[mCurrentLine], mBoxRect.w - 40, mTextLayout);
+    mTextRect = {mBoxRect.x + 20 + static_cast<int>(mTextOffset.x), 
+                 mBoxRect.y + 20 + static_cast<int>(mTextOffset.y), 
+                 mTextLayout.width, mTextLayout.height};
 }
 
-void DialogueSystem::CreateSpeakerTexture()
+void DialogueSystem::LayoutSpeaker()
 {
-    if (mSpeakerTexture)
-    {
-        SDL_DestroyTexture(mSpeakerTexture);
-        mSpeakerTexture = nullptr;
-    }
-
-    // Only create texture if speaker name is not empty
-    if (!mSpeakerName.empty())
+    // Only lay out the speaker if the name is not empty
+    mSpeakerLayout.quads.clear();
+    if (mAtlas && !mSpeakerName.empty())
     {
-        SDL_Color white = {255, 255, 255, 255};
-        SDL_Surface* surface = TTF_RenderText_Blended(mFont, mSpeakerName.c_str(), white);
-        if (surface)
-        {
-            mSpeakerTexture = SDL_CreateTextureFromSurface(mGame->GetRenderer(), surface);
-            mSpeakerRect.w = surface->w;
-            mSpeakerRect.h = surface->h;
-            SDL_FreeSurface(surface);
-        }
+        mAtlas->Layout(mSpeakerName, 0, mSpeakerLayout);
+        mSpeakerRect.w = mSpeakerLayout.width;
+        mSpeakerRect.h = mSpeakerLayout.height;
     }
 }
 
@@ -237,7 +191,7 @@ void DialogueSystem::SetSpeakerName(const std::string& name)
     if (mSpeakerName != name)
     {
         mSpeakerName = name;
-        CreateSpeakerTexture();
+        LayoutSpeaker();
         
         // Reposition the speaker box if the dialogue is active and name is not empty
         if (!mIsActive || mSpeakerName.empty())
@@ -286,6 +240,6 @@ void DialogueSystem::AdvanceDialogue()
     }
     else
     {
-        CreateTextTexture();
+        LayoutText();
     }
 }
@@ -2,10 +2,10 @@
 #include <vector>
 #include <string>
 #include <functional>
-#include <SDL_ttf.h>
 #include "../core/Game.h"
 #include "../libs/Math.h"
 #include "../core/AudioSystem.h"
+#include "GlyphAtlas.h"
 
 class Game;
 struct SDL_Renderer;
@@ -27,29 +27,29 @@ public:
     float GetLineDuration() const { return mLineDuration; }
 
 private:
-    void CreateTextTexture();
-    void CreateSpeakerTexture();
+    void LayoutText();
+    void LayoutSpeaker();
     void SetSpeakerName(const std::string& name);
     void SetSpeakerOffset(const Vector2& offset) { mSpeakerOffset = offset; }
     void SetTextOffset(const Vector2& offset) { mTextOffset = offset; }
     void AdvanceDialogue();
     
     Game* mGame;
-    TTF_Font* mFont;
-    TTF_Font* mSmallFont;
+    GlyphAtlas* mAtlas;
+    GlyphAtlas* mSmallAtlas;
 
     std::vector<std::string> mLines;
     size_t mCurrentLine;
     std::function<void()> mOnComplete;
 
-    SDL_Texture* mTextTexture;
+    GlyphAtlas::TextLayout mTextLayout;
     SDL_Rect mBoxRect;
     SDL_Rect mTextRect;
 
-    SDL_Texture* mPromptTexture;
+    GlyphAtlas::TextLayout mPromptLayout;
     SDL_Rect mPromptRect;
 
-    SDL_Texture* mSpeakerTexture;
+    GlyphAtlas::TextLayout mSpeakerLayout;
     SDL_Rect mSpeakerRect;
     std::string mSpeakerName;
     Vector2 mSpeakerOffset;
@@ -0,0 +1,296 @@
+#include "GlyphAtlas.h"
+#include "../core/EngineStats.h"
+#include <algorithm>
+
+static const int ATLAS_SIZE = 512;
+static const int GLYPH_PADDING = 1; // keeps filtering from bleeding between neighbours
+
+static void DecodeUTF8(const std::string &text, std::vector<Uint32> &codepoints)
+{
+    codepoints.clear();
+    size_t i = 0;
+    while (i < text.size())
+    {
+        unsigned char lead = static_cast<unsigned char>(text[i]);
+        Uint32 codepoint = '?';
+        size_t length = 1;
+
+        if (lead < 0x80)
+        {
+            codepoint = lead;
+        }
+        else if ((lead & 0xE0) == 0xC0)
+        {
+            codepoint = lead & 0x1F;
+            length = 2;
+        }
+        else if ((lead & 0xF0) == 0xE0)
+        {
+            codepoint = lead & 0x0F;
+            length = 3;
+        }
+        else if ((lead & 0xF8) == 0xF0)
+        {
+            codepoint = lead & 0x07;
+            length = 4;
+        }
+
+        for (size_t j = 1; j < length; j++)
+        {
+            unsigned char next = i + j < text.size() ? static_cast<unsigned char>(text[i + j]) : 0;
+            if ((next & 0xC0) != 0x80)
+            {
+                codepoint = '?';
+                length = j;
+                break;
+            }
+            codepoint = (codepoint << 6) | (next & 0x3F);
+        }
+
+        codepoints.push_back(codepoint);
+        i += length;
+    }
+}
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer *renderer, TTF_Font *font)
+    : mRenderer(renderer), mFont(font), mLineSkip(TTF_FontLineSkip(font)),
+      mShelfX(0), mShelfY(0), mShelfHeight(0)
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    for (auto page : mPages)
+    {
+        SDL_DestroyTexture(page);
+    }
+}
+
+void GlyphAtlas::Layout(const std::string &text, unsigned wrapLength, TextLayout &layout)
+{
+    layout.quads.clear();
+    layout.width = 0;
+    layout.height = 0;
+
+    std::vector<Uint32> codepoints;
+    DecodeUTF8(text, codepoints);
+
+    int line = 0;
+    int penX = 0;
+    Uint32 previous = 0;
+
+    auto emit = [&](Uint32 codepoint)
+    {
+        if (previous)
+        {
+            penX += TTF_GetFontKerningSizeGlyphs32(mFont, previous, codepoint);
+        }
+
+        const Glyph &glyph = GetGlyph(codepoint);
+        if (glyph.source.w > 0)
+        {
+            layout.quads.push_back({glyph.page, glyph.source,
+                                    static_cast<float>(penX + glyph.offsetX), static_cast<float>(line * mLineSkip),
+                                    static_cast<float>(glyph.source.w), static_cast<float>(glyph.source.h)});
+        }
+
+        penX += glyph.advance;
+        layout.width = std::max(layout.width, penX);
+        previous = codepoint;
+    };
+
+    size_t i = 0;
+    while (i < codepoints.size())
+    {
+        if (codepoints[i] == '\n')
+        {
+            line++;
+            penX = 0;
+            previous = 0;
+            i++;
+            continue;
+        }
+
+        // Next segment: the spaces before a word and the word itself
+        size_t wordBegin = i;
+        while (wordBegin < codepoints.size() && codepoints[wordBegin] == ' ')
+            wordBegin++;
+        size_t wordEnd = wordBegin;
+        while (wordEnd < codepoints.size() && codepoints[wordEnd] != ' ' && codepoints[wordEnd] != '\n')
+            wordEnd++;
+
+        // The spaces are dropped when the word goes to the next line
+        if (wrapLength > 0 && penX > 0 && wordEnd > wordBegin &&
+            penX + MeasureWord(codepoints, i, wordEnd, previous) > static_cast<int>(wrapLength))
+        {
+            line++;
+            penX = 0;
+            previous = 0;
+            i = wordBegin;
+        }
+
+        for (; i < wordEnd; i++)
+        {
+            emit(codepoints[i]);
+        }
+    }
+
+    layout.height = line * mLineSkip + TTF_FontHeight(mFont);
+}
+
+int GlyphAtlas::MeasureWord(const std::vector<Uint32> &codepoints, size_t begin, size_t end, Uint32 previous)
+{
+    int width = 0;
+    for (size_t i = begin; i < end; i++)
+    {
+        if (previous)
+        {
+            width += TTF_GetFontKerningSizeGlyphs32(mFont, previous, codepoints[i]);
+        }
+        width += GetGlyph(codepoints[i]).advance;
+        previous = codepoints[i];
+    }
+    return width;
+}
+
+void GlyphAtlas::Draw(const TextLayout &layout, const SDL_Rect &dest, SDL_Color color)
+{
+    if (layout.quads.empty() || layout.width <= 0 || layout.height <= 0)
+        return;
+
+    float scaleX = static_cast<float>(dest.w) / layout.width;
+    float scaleY = static_cast<float>(dest.h) / layout.height;
+    float texelSize = 1.0f / ATLAS_SIZE;
+
+    // One draw call per page, almost always a single one
+    for (int page = 0; page < static_cast<int>(mPages.size()); page++)
+    {
+        mVertices.clear();
+        mIndices.clear();
+
+        for (const auto &quad : layout.quads)
+        {
+            if (quad.page != page)
+                continue;
+
+            float left = dest.x + quad.x * scaleX;
+            float top = dest.y + quad.y * scaleY;
+            float right = left + quad.w * scaleX;
+            float bottom = top + quad.h * scaleY;
+
+            float u0 = quad.source.x * texelSize;
+            float v0 = quad.source.y * texelSize;
+            float u1 = (quad.source.x + quad.source.w) * texelSize;
+            float v1 = (quad.source.y + quad.source.h) * texelSize;
+
+            int first = static_cast<int>(mVertices.size());
+            mVertices.push_back({{left, top}, color, {u0, v0}});
+            mVertices.push_back({{right, top}, color, {u1, v0}});
+            mVertices.push_back({{right, bottom}, color, {u1, v1}});
+            mVertices.push_back({{left, bottom}, color, {u0, v1}});
+
+            mIndices.insert(mIndices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+        }
+
+        if (mVertices.empty())
+            continue;
+
+        ENGINE_STAT_DRAW(mPages[page]);
+        SDL_RenderGeometry(mRenderer, mPages[page], mVertices.data(), static_cast<int>(mVertices.size()),
+                           mIndices.data(), static_cast<int>(mIndices.size()));
+    }
+}
+
+void GlyphAtlas::Draw(const TextLayout &layout, int x, int y, SDL_Color color)
+{
+    Draw(layout, SDL_Rect{x, y, layout.width, layout.height}, color);
+}
+
+const GlyphAtlas::Glyph &GlyphAtlas::GetGlyph(Uint32 codepoint)
+{
+    auto iter = mGlyphs.find(codepoint);
+    if (iter != mGlyphs.end())
+        return iter->second;
+
+    Glyph glyph = {0, {0, 0, 0, 0}, 0, 0};
+
+    int minX = 0, maxX = 0, minY = 0, maxY = 0;
+    if (TTF_GlyphMetrics32(mFont, codepoint, &minX, &maxX, &minY, &maxY, &glyph.advance) == 0)
+    {
+        // The bitmap starts at the pen unless the glyph reaches to the left of it
+        glyph.offsetX = std::min(0, minX);
+    }
+
+    // Spaces only move the pen
+    if (codepoint == ' ' || codepoint == '\t')
+        return mGlyphs.emplace(codepoint, glyph).first->second;
+
+    // Rendered in white, the color is applied per vertex when drawing
+    SDL_Surface *surface = TTF_RenderGlyph32_Blended(mFont, codepoint, SDL_Color{255, 255, 255, 255});
+    if (surface && surface->format->format != SDL_PIXELFORMAT_ARGB8888)
+    {
+        SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(surface);
+        surface = converted;
+    }
+
+    if (!surface)
+    {
+        SDL_Log("Failed to rasterize glyph U+%04X: %s", codepoint, TTF_GetError());
+        return mGlyphs.emplace(codepoint, glyph).first->second;
+    }
+
+    int width = surface->w;
+    int height = surface->h;
+
+    if (width > 0 && height > 0 && width <= ATLAS_SIZE && height <= ATLAS_SIZE)
+    {
+        // Next shelf when the row is full, next page when the shelves are
+        if (mShelfX + width > ATLAS_SIZE)
+        {
+            mShelfX = 0;
+            mShelfY += mShelfHeight + GLYPH_PADDING;
+            mShelfHeight = 0;
+        }
+        if (mPages.empty() || mShelfY + height > ATLAS_SIZE)
+        {
+            AddPage();
+        }
+
+        if (!mPages.empty())
+        {
+            glyph.page = static_cast<int>(mPages.size()) - 1;
+            glyph.source = {mShelfX, mShelfY, width, height};
+            SDL_UpdateTexture(mPages.back(), &glyph.source, surface->pixels, surface->pitch);
+
+            mShelfX += width + GLYPH_PADDING;
+            mShelfHeight = std::max(mShelfHeight, height);
+        }
+    }
+
+    SDL_FreeSurface(surface);
+    return mGlyphs.emplace(codepoint, glyph).first->second;
+}
+
+bool GlyphAtlas::AddPage()
+{
+    SDL_Texture *page = SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                          ATLAS_SIZE, ATLAS_SIZE);
+    if (!page)
+    {
+        SDL_Log("Failed to create glyph atlas page: %s", SDL_GetError());
+        return false;
+    }
+    ENGINE_STAT(Stat::TexturesCreated, 1);
+
+    // The padding between glyphs must be transparent
+    std::vector<Uint32> clear(ATLAS_SIZE * ATLAS_SIZE, 0);
+    SDL_UpdateTexture(page, nullptr, clear.data(), ATLAS_SIZE * sizeof(Uint32));
+    SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+
+    mPages.push_back(page);
+    mShelfX = 0;
+    mShelfY = 0;
+    mShelfHeight = 0;
+    return true;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+// Glyphs of one font at one point size, rasterized the first time they are used into
+// shared atlas textures. Text is laid out on the CPU (kerning and wrapping) and drawn
+// as one batch of quads per atlas page, so changing a text never creates a texture.
+class GlyphAtlas
+{
+public:
+    struct Quad
+    {
+        int page;
+        SDL_Rect source;
+        float x, y, w, h; // relative to the top left of the text
+    };
+
+    struct TextLayout
+    {
+        std::vector<Quad> quads;
+        int width = 0;
+        int height = 0;
+    };
+
+    GlyphAtlas(SDL_Renderer *renderer, TTF_Font *font);
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas &) = delete;
+    GlyphAtlas &operator=(const GlyphAtlas &) = delete;
+
+    // Lays out UTF-8 text like TTF_RenderUTF8_Blended_Wrapped: lines break at '\n' and
+    // between words past wrapLength pixels, a wrapLength of 0 only breaks at '\n'
+    void Layout(const std::string &text, unsigned wrapLength, TextLayout &layout);
+
+    // Draws the text stretched over dest, tinted by color
+    void Draw(const TextLayout &layout, const SDL_Rect &dest, SDL_Color color);
+
+    // Draws the text at its natural size
+    void Draw(const TextLayout &layout, int x, int y, SDL_Color color);
+
+private:
+    struct Glyph
+    {
+        int page;
+        SDL_Rect source;
+        int offsetX; // from the pen position to the left of the bitmap
+        int advance;
+    };
+
+    const Glyph &GetGlyph(Uint32 codepoint);
+    bool AddPage();
+    int MeasureWord(const std::vector<Uint32> &codepoints, size_t begin, size_t end, Uint32 previous);
+
+    SDL_Renderer *mRenderer;
+    TTF_Font *mFont;
+    int mLineSkip;
+
+    std::unordered_map<Uint32, Glyph> mGlyphs;
+
+    // Glyphs are packed in rows (shelves) from the top left of the last page
+    std::vector<SDL_Texture *> mPages;
+    int mShelfX;
+    int mShelfY;
+    int mShelfHeight;
+
+    // Reused by every Draw
+    std::vector<SDL_Vertex> mVertices;
+    std::vector<int> mIndices;
+};
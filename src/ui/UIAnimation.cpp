@@ -1,4 +1,5 @@
 #include "./UIAnimation.h"
+#include "../core/EngineStats.h"
 
 UIAnimation::UIAnimation(
     Game *game,
@@ -64,6 +65,7 @@ void UIAnimation::Draw(SDL_Renderer* renderer, const Vector2 &screenPos, const V
                            static_cast<Uint8>(modColor.y),
                            static_cast<Uint8>(modColor.z));
 
+    ENGINE_STAT_DRAW(mSpriteSheetTexture);
     SDL_RenderCopyEx(renderer, mSpriteSheetTexture, srcRect, &dstRect, 
                      0, nullptr, SDL_FLIP_NONE);
 }
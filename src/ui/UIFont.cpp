@@ -1,9 +1,11 @@
 #include "UIFont.h"
-#include <vector>
+#include "../core/EngineStats.h"
 #include <SDL_image.h>
 
 UIFont::UIFont(SDL_Renderer* renderer)
-    :mRenderer(renderer)
+    :mFileData(nullptr)
+    ,mFileSize(0)
+    ,mRenderer(renderer)
 {
 
 }
@@ -15,31 +17,36 @@ UIFont::~UIFont()
 
 bool UIFont::Load(const std::string& fileName)
 {
-	// We support these font sizes
-	std::vector<int> fontSizes = {8,  9,  10, 11, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30, 32,
-								  34, 36, 38, 40, 42, 44, 46, 48, 52, 56, 60, 64, 68, 72};
-
-	for (auto& size : fontSizes)
+	// Point sizes are opened from this copy when they are first asked for
+	mFileData = SDL_LoadFile(fileName.c_str(), &mFileSize);
+	if (mFileData == nullptr)
 	{
-		TTF_Font* font = TTF_OpenFont(fileName.c_str(), size);
-		if (font == nullptr)
-		{
-			SDL_Log("Failed to load font %s in size %d: %s", fileName.c_str(), size, TTF_GetError());
-			return false;
-		}
-		mFontData.emplace(size, font);
+		SDL_Log("Failed to load font %s: %s", fileName.c_str(), SDL_GetError());
+		return false;
 	}
+	mFileName = fileName;
 
 	return true;
 }
 
 void UIFont::Unload()
 {
+	for (auto& atlas : mAtlases)
+	{
+		delete atlas.second;
+	}
+	mAtlases.clear();
+
 	for (auto& font : mFontData)
     {
 		TTF_CloseFont(font.second);
 	}
     mFontData.clear();
+
+	// Only once no size reads from it
+	SDL_free(mFileData);
+	mFileData = nullptr;
+	mFileSize = 0;
 }
 
 SDL_Texture* UIFont::RenderText(const std::string& text, const Vector3& color /*= Color::White*/,
@@ -51,20 +58,12 @@ SDL_Texture* UIFont::RenderText(const std::string& text, const Vector3& color /*
         return nullptr;
     }
 
-	// Convert to SDL_Color
-	SDL_Color sdlColor;
-
-	// Swap red and blue so we get RGBA instead of BGRA
-	sdlColor.b = static_cast<Uint8>(color.x * 255);
-	sdlColor.g = static_cast<Uint8>(color.y * 255);
-	sdlColor.r = static_cast<Uint8>(color.z * 255);
-	sdlColor.a = 255;
+	SDL_Color sdlColor = ToSDLColor(color);
 
 	// Find the font data for this point size
-	auto iter = mFontData.find(pointSize);
-	if (iter != mFontData.end())
+	TTF_Font* font = GetFont(pointSize);
+	if (font)
 	{
-		TTF_Font* font = iter->second;
 		// Draw this to a surface (blended for alpha)
 		SDL_Surface* surf = TTF_RenderUTF8_Blended_Wrapped(font, text.c_str(), sdlColor, wrapLength);
 		if (!surf)
@@ -75,6 +74,7 @@ SDL_Texture* UIFont::RenderText(const std::string& text, const Vector3& color /*
 
         // Create texture from surface
         SDL_Texture* texture = SDL_CreateTextureFromSurface(mRenderer, surf);
+        ENGINE_STAT(Stat::TexturesCreated, 1);
         SDL_FreeSurface(surf);
         if (!texture)
         {
@@ -84,10 +84,64 @@ SDL_Texture* UIFont::RenderText(const std::string& text, const Vector3& color /*
 
         return texture;
 	}
-	else
+
+    return nullptr;
+}
+
+GlyphAtlas* UIFont::GetAtlas(int pointSize)
+{
+	auto atlas = mAtlases.find(pointSize);
+	if (atlas != mAtlases.end())
+	{
+		return atlas->second;
+	}
+
+	TTF_Font* font = GetFont(pointSize);
+	if (!font)
+	{
+		return nullptr;
+	}
+
+	GlyphAtlas* newAtlas = new GlyphAtlas(mRenderer, font);
+	mAtlases.emplace(pointSize, newAtlas);
+	return newAtlas;
+}
+
+SDL_Color UIFont::ToSDLColor(const Vector3& color)
+{
+	SDL_Color sdlColor;
+
+	// Swap red and blue so we get RGBA instead of BGRA
+	sdlColor.b = static_cast<Uint8>(color.x * 255);
+	sdlColor.g = static_cast<Uint8>(color.y * 255);
+	sdlColor.r = static_cast<Uint8>(color.z * 255);
+	sdlColor.a = 255;
+	return sdlColor;
+}
+
+TTF_Font* UIFont::GetFont(int pointSize)
+{
+	auto iter = mFontData.find(pointSize);
+	if (iter != mFontData.end())
+	{
+		return iter->second;
+	}
+
+	if (mFileData == nullptr || pointSize <= 0)
 	{
 		SDL_Log("Point size %d is unsupported", pointSize);
+		return nullptr;
 	}
 
-    return nullptr;
+	// The font reads from the shared file data and closes its RWops when it is closed
+	SDL_RWops* data = SDL_RWFromConstMem(mFileData, static_cast<int>(mFileSize));
+	TTF_Font* font = data ? TTF_OpenFontRW(data, 1, pointSize) : nullptr;
+	if (font == nullptr)
+	{
+		SDL_Log("Failed to load font %s in size %d: %s", mFileName.c_str(), pointSize, TTF_GetError());
+		return nullptr;
+	}
+
+	mFontData.emplace(pointSize, font);
+	return font;
 }
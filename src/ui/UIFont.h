@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <SDL_ttf.h>
 #include "../libs/Math.h"
+#include "GlyphAtlas.h"
 
 class UIFont
 {
@@ -10,7 +11,7 @@ public:
     UIFont(SDL_Renderer* renderer);
     ~UIFont();
 
-	// Start/unload from a file
+	// Start/unload from a file. The file is read once, sizes are opened on first use
 	bool Load(const std::string& fileName);
 	void Unload();
 
@@ -18,9 +19,23 @@ public:
 	class SDL_Texture* RenderText(const std::string& text, const Vector3& color = Color::White,
 							         int pointSize = 30, unsigned wrapLength = 1024);
 
+	// Glyph cache of a point size, for text that changes or is drawn every frame
+	GlyphAtlas* GetAtlas(int pointSize);
+
+	// Game colors are BGR, SDL's are RGBA
+	static SDL_Color ToSDLColor(const Vector3& color);
+
 private:
+	TTF_Font* GetFont(int pointSize);
+
+	// Contents of the font file, shared by every point size
+	void* mFileData;
+	size_t mFileSize;
+	std::string mFileName;
+
 	// Map of point sizes to font data
 	std::unordered_map<int, TTF_Font*> mFontData;
+	std::unordered_map<int, GlyphAtlas*> mAtlases;
 
     SDL_Renderer* mRenderer;
 };
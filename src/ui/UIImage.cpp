@@ -3,6 +3,7 @@
 //
 
 #include "UIImage.h"
+#include "../core/EngineStats.h"
 
 UIImage::UIImage(const std::string &imagePath, const Vector2 &pos, const Vector2 &size, const Vector3 &color)
     : UIElement(pos, size, color),
@@ -18,6 +19,7 @@ UIImage::UIImage(const std::string &imagePath, const Vector2 &pos, const Vector2
 
     // Create texture from surface
     mTexture = SDL_CreateTextureFromSurface(SDL_GetRenderer(SDL_GetWindowFromID(1)), surface);
+    ENGINE_STAT(Stat::TexturesCreated, 1);
     if (mTexture == nullptr)
     {
         SDL_Log("Failed to create texture from surface: %s", SDL_GetError());
@@ -55,6 +57,7 @@ void UIImage::Draw(SDL_Renderer *renderer, const Vector2 &screenPos)
     // Set the center of rotation to the middle of the cursor
     SDL_Point center = {static_cast<int>(mSize.x / 2), static_cast<int>(mSize.y / 2)};
 
+    ENGINE_STAT_DRAW(mTexture);
     SDL_RenderCopyEx(
         renderer, 
         mTexture, 
@@ -11,7 +11,7 @@ UIText::UIText(const std::string &text, class UIFont* font, int pointSize, const
    ,mFont(font)
    ,mPointSize(pointSize)
    ,mWrapLength(wrapLength)
-   ,mTextTexture(nullptr)
+   ,mAtlas(font ? font->GetAtlas(pointSize) : nullptr)
 {
     SetText(text);
 }
@@ -23,20 +23,17 @@ UIText::~UIText()
 
 void UIText::SetText(const std::string &text)
 {
-    // Clear out previous title texture if it exists
-    if (mTextTexture)
-    {
-        SDL_DestroyTexture(mTextTexture);
-        mTextTexture = nullptr;
-    }
-
-    // Create texture for title
-    mTextTexture = mFont->RenderText(text, mColor, mPointSize, mWrapLength);
+    if (!mAtlas || text == mText)
+        return;
+
+    // Only the quads change, the glyphs are rasterized once per font size
+    mText = text;
+    mAtlas->Layout(mText, mWrapLength, mLayout);
 }
 
 void UIText::Draw(SDL_Renderer *renderer, const Vector2 &screenPos)
 {
-    if(!mIsEnabled || !mTextTexture)
+    if(!mIsEnabled || !mAtlas)
         return;
     
     SDL_Rect titleQuad = {static_cast<int>(screenPos.x + mPosition.x),
@@ -44,5 +41,6 @@ void UIText::Draw(SDL_Renderer *renderer, const Vector2 &screenPos)
                           static_cast<int>(mSize.x),
                           static_cast<int>(mSize.y)};
 
-    SDL_RenderCopyEx(renderer, mTextTexture, nullptr, &titleQuad, .0f, nullptr, SDL_FLIP_NONE);
+    // Stretched over the element like the texture it replaces
+    mAtlas->Draw(mLayout, titleQuad, UIFont::ToSDLColor(mColor));
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <SDL.h>
 #include "../libs/Math.h"
 #include "UIElement.h"
+#include "GlyphAtlas.h"
 
 class UIText : public UIElement {
 public:
@@ -22,7 +23,8 @@ public:
 protected:
     std::string mText;
     class UIFont* mFont;
-    SDL_Texture *mTextTexture;
+    GlyphAtlas* mAtlas;
+    GlyphAtlas::TextLayout mLayout;
 
     unsigned int mPointSize;
     unsigned int mWrapLength;